@@ -0,0 +1,288 @@
+#include "batch.h"
+#include "../export/export.h"
+#include "../sorting/verify.h"
+#include "../stats/stats.h"
+#include "../utils/session.h"
+#include "../utils/utils.h"
+#include "../visual/visual.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+/**
+ * @file batch.c
+ * @brief Exécution de tâches de tri enchaînées sans saisie.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Une tâche s'écrit sur une ligne de paires clé=valeur, par exemple :
+ *   algo=QuickSort n=5000 dist=random seed=7 mode=headless output=quick.y4m
+ * Une file s'exécute dans sa propre session, qui part des réglages de la session par défaut : les tâches
+ * partagent la zone de son échantillon (dimensionnée une fois pour la plus grande) et, si certaines
+ * s'affichent, une seule initialisation de SDL et une seule fenêtre. Les tâches d'un algorithme
+ * quadratique au-delà de SORT_QUADRATIC_MAX éléments sont sautées.
+ */
+
+/**
+ * @brief Noms acceptés pour les types d'entrée, dans l'ordre de FillSample.
+ */
+static const char *distributions[] = { "random", "nearly", "reverse", "sorted" };
+
+/**
+ * @brief Lit un entier positif ou nul ; renvoie -1 si la valeur n'est pas un entier.
+ */
+static long parse_count(const char *value) {
+    char *end;
+    long v = strtol(value, &end, 10);
+    if (end == value || *end != '\0' || v < 0) return -1;
+    return v;
+}
+
+/**
+ * @brief Affecte un champ d'une tâche depuis une paire clé=valeur.
+ *
+ * @return 0 en cas de succès, -1 si la clé ou la valeur est invalide.
+ */
+static int set_field(BatchJob *job, const char *key, const char *value, const char *where) {
+    if (strcmp(key, "algo") == 0 || strcmp(key, "algorithm") == 0) {
+        job->algorithm = SortFindAlgorithm(value);
+        if (job->algorithm == NULL) {
+            fprintf(stderr, "%s: unknown algorithm '%s'\n", where, value);
+            return -1;
+        }
+    } else if (strcmp(key, "n") == 0 || strcmp(key, "size") == 0) {
+        long n = parse_count(value);
+        if (n <= 0 || n > 0x7FFFFFFF) {
+            fprintf(stderr, "%s: invalid size '%s'\n", where, value);
+            return -1;
+        }
+        job->size = (int)n;
+    } else if (strcmp(key, "dist") == 0 || strcmp(key, "distribution") == 0) {
+        long d = parse_count(value);
+        for (int i = 0; d < 0 && i < 4; i++) {
+            if (strcasecmp(value, distributions[i]) == 0) d = i + 1;
+        }
+        if (d < 1 || d > 4) {
+            fprintf(stderr, "%s: invalid distribution '%s' (random, nearly, reverse, sorted or 1-4)\n", where, value);
+            return -1;
+        }
+        job->distribution = (int)d;
+    } else if (strcmp(key, "seed") == 0) {
+        long seed = parse_count(value);
+        if (seed < 0) {
+            fprintf(stderr, "%s: invalid seed '%s'\n", where, value);
+            return -1;
+        }
+        job->seed = (unsigned int)seed;
+    } else if (strcmp(key, "mode") == 0) {
+        if (strcasecmp(value, "visual") == 0) {
+            job->mode = BATCH_VISUAL;
+        } else if (strcasecmp(value, "headless") == 0) {
+            job->mode = BATCH_HEADLESS;
+        } else {
+            fprintf(stderr, "%s: invalid mode '%s' (visual or headless)\n", where, value);
+            return -1;
+        }
+    } else if (strcmp(key, "delay") == 0) {
+        long delay = parse_count(value);
+        if (delay < 0) {
+            fprintf(stderr, "%s: invalid delay '%s'\n", where, value);
+            return -1;
+        }
+        job->delay = (int)delay;
+    } else if (strcmp(key, "output") == 0 || strcmp(key, "out") == 0) {
+        snprintf(job->output, sizeof(job->output), "%s", value);
+    } else {
+        fprintf(stderr, "%s: unknown key '%s'\n", where, key);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Analyse une tâche et l'ajoute à la file.
+ *
+ * Valeurs par défaut : 100 éléments, entrée aléatoire, graine 1, mode headless, délai courant, pas d'export.
+ *
+ * @param queue La file de tâches.
+ * @param spec La tâche, en paires clé=valeur séparées par des blancs.
+ * @param where Origine de la tâche pour les messages d'erreur.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int BatchAddJob(BatchQueue *queue, const char *spec, const char *where) {
+    BatchJob job;
+    memset(&job, 0, sizeof(job));
+    job.size = 100;
+    job.distribution = 1;
+    job.seed = 1;
+    job.mode = BATCH_HEADLESS;
+    job.delay = -1;
+
+    char buffer[1024];
+    snprintf(buffer, sizeof(buffer), "%s", spec);
+
+    for (char *token = strtok(buffer, " \t\r\n"); token != NULL; token = strtok(NULL, " \t\r\n")) {
+        char *equal = strchr(token, '=');
+        if (equal == NULL) {
+            fprintf(stderr, "%s: expected key=value, got '%s'\n", where, token);
+            return -1;
+        }
+        *equal = '\0';
+        if (set_field(&job, token, equal + 1, where) != 0) return -1;
+    }
+
+    if (job.algorithm == NULL) {
+        fprintf(stderr, "%s: missing algo=<name>\n", where);
+        return -1;
+    }
+    if (job.mode == BATCH_VISUAL && job.output[0] != '\0') {
+        fprintf(stderr, "%s: output is only used with mode=headless\n", where);
+        return -1;
+    }
+
+    if (queue->count == queue->capacity) {
+        int capacity = queue->capacity ? queue->capacity * 2 : 16;
+        BatchJob *jobs = realloc(queue->jobs, capacity * sizeof(BatchJob));
+        if (jobs == NULL) {
+            fprintf(stderr, "Memory allocation failed\n");
+            return -1;
+        }
+        queue->jobs = jobs;
+        queue->capacity = capacity;
+    }
+    queue->jobs[queue->count++] = job;
+    return 0;
+}
+
+/**
+ * @brief Ajoute les tâches d'un fichier, une par ligne ; les lignes vides et les commentaires (#) sont ignorés.
+ *
+ * @param queue La file de tâches.
+ * @param path Le fichier de tâches ("-" : entrée standard).
+ * @return 0 en cas de succès, -1 si le fichier est illisible ou contient une tâche invalide.
+ */
+int BatchLoadFile(BatchQueue *queue, const char *path) {
+    FILE *file = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    int status = 0, lineNumber = 0;
+    char line[1024];
+    while (status == 0 && fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        char *start = line;
+        while (isspace((unsigned char)*start)) start++;
+        if (*start == '\0') continue;
+
+        char where[300];
+        snprintf(where, sizeof(where), "%s:%d", path, lineNumber);
+        status = BatchAddJob(queue, start, where);
+    }
+
+    if (file != stdin) fclose(file);
+    return status;
+}
+
+/**
+ * @brief Format d'export déduit de l'extension du chemin : .png pour une suite d'images, sinon Y4M.
+ */
+static ExportFormat output_format(const char *path) {
+    size_t len = strlen(path);
+    return (len >= 4 && strcasecmp(path + len - 4, ".png") == 0) ? EXPORT_PNG : EXPORT_Y4M;
+}
+
+/**
+ * @brief Exécute les tâches l'une après l'autre, sans aucune saisie.
+ *
+ * Chaque entrée est régénérée depuis sa graine (générateur de la session) dans la zone partagée de
+ * l'échantillon, et son empreinte calculée avant le tri : le résultat doit être trié et en être une
+ * permutation. Les réglages modifiés par les tâches (délai, sortie) ne concernent que la session de la
+ * file : la session par défaut est inchangée.
+ *
+ * @param queue La file de tâches.
+ * @return Le nombre de tâches échouées.
+ */
+int BatchRun(const BatchQueue *queue) {
+    int maxSize = 0, visual = 0;
+    for (int j = 0; j < queue->count; j++) {
+        if (queue->jobs[j].size > maxSize) maxSize = queue->jobs[j].size;
+        if (queue->jobs[j].mode == BATCH_VISUAL) visual = 1;
+    }
+    if (queue->count == 0) return 0;
+
+    SortSession session;
+    SessionInit(&session);
+    session.settings = DefaultSession()->settings;
+    session.keepWindow = visual;
+    int defaultDelay = session.settings.delayMs;
+
+    int *sample = SessionReserve(&session, maxSize);
+    if (sample == NULL) {
+        SessionFree(&session);
+        return queue->count;
+    }
+
+    int failed = 0;
+    for (int j = 0; j < queue->count; j++) {
+        const BatchJob *job = &queue->jobs[j];
+        printf("[%d/%d] %s n=%d %s seed=%u: ", j + 1, queue->count, job->algorithm->name, job->size,
+               distributions[job->distribution - 1], job->seed);
+        if (!SortAlgorithmFits(job->algorithm, job->size)) {
+            printf("skipped (quadratic, n > %d)\n", SORT_QUADRATIC_MAX);
+            continue;
+        }
+        fflush(stdout);
+        SessionSeed(&session, job->seed);
+        FillSampleWith(sample, job->size, job->distribution, &session.rng);
+        SortChecksum input;
+        SortChecksumCompute(&input, sample, job->size);
+
+        double start = StatsNow();
+        if (job->mode == BATCH_VISUAL) {
+            SessionSetOutput(&session, EXPORT_NONE, NULL);
+            session.settings.delayMs = job->delay >= 0 ? job->delay : defaultDelay;
+            printf("window\n");
+            SessionVisualize(&session, sample, job->size, job->algorithm->sortViz);
+        } else if (job->output[0] != '\0') {
+            SessionSetOutput(&session, output_format(job->output), job->output);
+            printf("export to %s\n", job->output);
+            SessionVisualize(&session, sample, job->size, job->algorithm->sortViz);
+        } else {
+            job->algorithm->sort(sample, job->size);
+        }
+        double elapsed = StatsNow() - start;
+
+        SortVerdict verdict;
+        if (SortVerify(sample, job->size, &input, &verdict) != 0) {
+            if (verdict.firstUnsorted >= 0) {
+                printf("  FAILED: output is not sorted at index %d (%d > %d)\n", verdict.firstUnsorted,
+                       sample[verdict.firstUnsorted], sample[verdict.firstUnsorted + 1]);
+            } else {
+                printf("  FAILED: output is not a permutation of the input\n");
+            }
+            failed++;
+        } else if (job->mode == BATCH_HEADLESS && job->output[0] == '\0') {
+            printf("%.3f ms\n", elapsed * 1e3);
+        }
+    }
+
+    SessionFree(&session);
+    return failed;
+}
+
+/**
+ * @brief Libère une file de tâches.
+ */
+void BatchFree(BatchQueue *queue) {
+    free(queue->jobs);
+    queue->jobs = NULL;
+    queue->count = 0;
+    queue->capacity = 0;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file batch/batch.h
+ * @brief Exécution de tâches de tri enchaînées sans saisie (fichier de tâches ou ligne de commande).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "../sorting/registry.h"
+
+typedef enum BatchMode {
+    BATCH_HEADLESS, // silent sort, or animation export when an output path is given
+    BATCH_VISUAL    // playback in the SDL window
+} BatchMode;
+
+typedef struct BatchJob {
+    const SortAlgorithm *algorithm;
+    int size;
+    int distribution;   // input type, as in FillSample
+    unsigned int seed;  // seed of the generator that builds the input (SessionSeed)
+    BatchMode mode;
+    int delay;          // ms between steps in the window (-1: keep the current delay)
+    char output[256];   // .y4m stream or .png prefix for a headless export ("" : timed run only)
+} BatchJob;
+
+typedef struct BatchQueue {
+    int count;
+    int capacity;
+    BatchJob *jobs;
+} BatchQueue;
+
+// Parse one job "key=value ..." (algo, n, dist, seed, mode, delay, output) and append it.
+// where names the source in error messages. Returns 0 or -1.
+int BatchAddJob(BatchQueue *queue, const char *spec, const char *where);
+// Append every job of a file (one per line, '#' comments); path "-" reads stdin. Returns 0 or -1.
+int BatchLoadFile(BatchQueue *queue, const char *path);
+// Run the jobs back to back; returns the number of failed jobs.
+int BatchRun(const BatchQueue *queue);
+void BatchFree(BatchQueue *queue);
+
+#endif // BATCH_H
@@ -0,0 +1,426 @@
+#include "baseline.h"
+#include "bench.h"
+#include "runner.h"
+#include "../sorting/tuning.h"
+#include "../stats/stats.h"
+#include "../utils/host.h"
+#include "../utils/json.h"
+#include "../utils/session.h"
+#include "../utils/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file baseline.c
+ * @brief Référence de performances enregistrée en JSON et détection des régressions.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Chaque configuration (algorithme, type d'entrée, taille, nombre de threads) est mesurée et ses temps bruts
+ * sont enregistrés avec l'empreinte de la machine. La comparaison remesure les configurations de la machine
+ * courante : une configuration régresse si le test de Mann-Whitney conclut qu'elle est plus lente et si sa
+ * médiane dépasse celle de la référence de plus du seuil.
+ */
+
+/**
+ * @brief Types d'entrée mesurés (voir FillSample).
+ */
+#define BASELINE_NB_DISTRIBUTIONS 4
+
+/**
+ * @brief Une configuration mesurée et ses temps bruts.
+ */
+typedef struct BaselineEntry {
+    char algorithm[32];
+    int distribution;
+    long size;
+    int threads;
+    unsigned int seed;
+    char host[17];
+    double median;
+    int nbSamples;
+    double samples[RUNNER_MAX_SAMPLES];
+} BaselineEntry;
+
+/**
+ * @brief Contenu d'un fichier de référence.
+ */
+typedef struct Baseline {
+    int nbHosts;
+    HostInfo *hosts;
+    int nbEntries;
+    BaselineEntry *entries;
+} Baseline;
+
+/**
+ * @brief Options par défaut : 1 000, 10 000 et 100 000 éléments, tris quadratiques jusqu'à 10 000,
+ * régression au-delà de 5 % avec un seuil de signification de 1 %.
+ *
+ * @param options Les options à remplir.
+ */
+void BaselineDefaults(BaselineOptions *options) {
+    memset(options, 0, sizeof(*options));
+    options->sizes[0] = 1000;
+    options->sizes[1] = 10000;
+    options->sizes[2] = 100000;
+    options->nbSizes = 3;
+    options->quadraticLimit = 10000;
+    options->seed = 42;
+    options->threshold = 0.05;
+    options->alpha = 0.01;
+}
+
+/**
+ * @brief Copie une chaîne dans un tampon de taille fixe (tronquée si besoin).
+ */
+static void copy_string(char *dest, size_t size, const char *src) {
+    snprintf(dest, size, "%s", src ? src : "");
+}
+
+/**
+ * @brief Libère le contenu d'une référence.
+ */
+static void baseline_free(Baseline *baseline) {
+    free(baseline->hosts);
+    free(baseline->entries);
+    memset(baseline, 0, sizeof(*baseline));
+}
+
+/**
+ * @brief Ajoute une configuration à une référence.
+ */
+static int add_entry(Baseline *baseline, const BaselineEntry *entry) {
+    BaselineEntry *entries = realloc(baseline->entries, (baseline->nbEntries + 1) * sizeof(BaselineEntry));
+    if (entries == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+    baseline->entries = entries;
+    baseline->entries[baseline->nbEntries++] = *entry;
+    return 0;
+}
+
+/**
+ * @brief Ajoute la description d'une machine à une référence.
+ */
+static int add_host(Baseline *baseline, const HostInfo *host) {
+    HostInfo *hosts = realloc(baseline->hosts, (baseline->nbHosts + 1) * sizeof(HostInfo));
+    if (hosts == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+    baseline->hosts = hosts;
+    baseline->hosts[baseline->nbHosts++] = *host;
+    return 0;
+}
+
+/**
+ * @brief Charge un fichier de référence.
+ *
+ * @return 0 en cas de succès, 1 si le fichier n'existe pas, 2 s'il date d'une version antérieure, -1 s'il est
+ * invalide.
+ */
+static int baseline_load(const char *path, Baseline *baseline) {
+    memset(baseline, 0, sizeof(*baseline));
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return 1;
+    fclose(file);
+
+    JsonValue *root = JsonParseFile(path);
+    if (root == NULL) {
+        fprintf(stderr, "%s: invalid baseline file\n", path);
+        return -1;
+    }
+    int version = (int)JsonGetNumber(root, "version", 0);
+    if (version >= 1 && version < BASELINE_VERSION) {
+        fprintf(stderr, "%s: baseline version %d generated its inputs differently (expected %d)\n", path, version,
+                BASELINE_VERSION);
+        JsonFree(root);
+        return 2;
+    }
+    if (version != BASELINE_VERSION) {
+        fprintf(stderr, "%s: unsupported baseline version %d (expected %d)\n", path, version, BASELINE_VERSION);
+        JsonFree(root);
+        return -1;
+    }
+
+    const JsonValue *hosts = JsonGet(root, "hosts");
+    for (int i = 0; hosts && hosts->type == JSON_ARRAY && i < hosts->count; i++) {
+        const JsonValue *h = hosts->items[i];
+        HostInfo host;
+        memset(&host, 0, sizeof(host));
+        copy_string(host.fingerprint, sizeof(host.fingerprint), JsonGetString(h, "fingerprint", ""));
+        copy_string(host.cpu, sizeof(host.cpu), JsonGetString(h, "cpu", "unknown"));
+        copy_string(host.system, sizeof(host.system), JsonGetString(h, "system", "unknown"));
+        host.cpus = (int)JsonGetNumber(h, "cpus", 0);
+        if (add_host(baseline, &host) != 0) break;
+    }
+
+    const JsonValue *results = JsonGet(root, "results");
+    for (int i = 0; results && results->type == JSON_ARRAY && i < results->count; i++) {
+        const JsonValue *r = results->items[i];
+        BaselineEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        copy_string(entry.algorithm, sizeof(entry.algorithm), JsonGetString(r, "algorithm", ""));
+        copy_string(entry.host, sizeof(entry.host), JsonGetString(r, "host", ""));
+        entry.distribution = (int)JsonGetNumber(r, "distribution", 1);
+        entry.size = (long)JsonGetNumber(r, "size", 0);
+        entry.threads = (int)JsonGetNumber(r, "threads", 1);
+        entry.seed = (unsigned int)JsonGetNumber(r, "seed", 0);
+        entry.median = JsonGetNumber(r, "median", 0);
+
+        const JsonValue *samples = JsonGet(r, "samples");
+        for (int s = 0; samples && samples->type == JSON_ARRAY && s < samples->count && s < RUNNER_MAX_SAMPLES; s++) {
+            if (samples->items[s]->type == JSON_NUMBER) entry.samples[entry.nbSamples++] = samples->items[s]->number;
+        }
+        if (entry.size <= 0 || entry.nbSamples == 0) continue;
+        if (add_entry(baseline, &entry) != 0) break;
+    }
+
+    JsonFree(root);
+    return 0;
+}
+
+/**
+ * @brief Écrit une référence au format JSON.
+ */
+static int baseline_write(const char *path, const Baseline *baseline) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    fprintf(file, "{\n  \"version\": %d,\n  \"hosts\": [", BASELINE_VERSION);
+    for (int i = 0; i < baseline->nbHosts; i++) {
+        const HostInfo *h = &baseline->hosts[i];
+        fprintf(file, "%s\n    {\"fingerprint\": ", i ? "," : "");
+        JsonWriteString(file, h->fingerprint);
+        fprintf(file, ", \"cpu\": ");
+        JsonWriteString(file, h->cpu);
+        fprintf(file, ", \"system\": ");
+        JsonWriteString(file, h->system);
+        fprintf(file, ", \"cpus\": %d}", h->cpus);
+    }
+    fprintf(file, "\n  ],\n  \"results\": [");
+
+    for (int i = 0; i < baseline->nbEntries; i++) {
+        const BaselineEntry *e = &baseline->entries[i];
+        fprintf(file, "%s\n    {\"algorithm\": ", i ? "," : "");
+        JsonWriteString(file, e->algorithm);
+        fprintf(file, ", \"distribution\": %d, \"size\": %ld, \"threads\": %d, \"seed\": %u, \"host\": ",
+                e->distribution, e->size, e->threads, e->seed);
+        JsonWriteString(file, e->host);
+        fprintf(file, ", \"median\": %.9g, \"samples\": [", e->median);
+        for (int s = 0; s < e->nbSamples; s++) fprintf(file, "%s%.9g", s ? ", " : "", e->samples[s]);
+        fprintf(file, "]}");
+    }
+    fprintf(file, "\n  ]\n}\n");
+
+    if (fclose(file) != 0) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Mesure une configuration sur une entrée régénérée depuis sa graine.
+ *
+ * @param entry La configuration ; ses temps bruts et sa médiane sont remplis.
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+static int measure_entry(const SortAlgorithm *algo, BaselineEntry *entry) {
+    int *snapshot = (int*)malloc(entry->size * sizeof(int));
+    if (snapshot == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+    // Own generator: the input does not depend on what else has drawn from rand().
+    SortSession generator;
+    SessionInit(&generator);
+    SessionSeed(&generator, entry->seed);
+    FillSampleWith(snapshot, (int)entry->size, entry->distribution, &generator.rng);
+
+    // Enough repetitions for the rank test, raw times kept as measured.
+    RunnerOptions runner;
+    RunnerDefaults(&runner);
+    runner.warmup = 1;
+    runner.minReps = 10;
+    runner.maxReps = 30;
+    runner.targetRelCI = 0.01;
+    runner.maxSeconds = 3.0;
+    if (algo->parallel) runner.cpu = RUNNER_NO_PIN;
+
+    RunnerResult result;
+    int status = RunnerMeasure(algo->sort, snapshot, (int)entry->size, &runner, &result);
+    free(snapshot);
+    if (status != 0) return -1;
+
+    entry->median = result.time.median;
+    entry->nbSamples = result.nbSamples;
+    memcpy(entry->samples, result.samples, result.nbSamples * sizeof(double));
+    return 0;
+}
+
+/**
+ * @brief Mesure la suite complète et l'enregistre, en conservant les mesures des autres machines.
+ *
+ * @param path Le fichier de référence (créé ou mis à jour).
+ * @param options Les options de la suite (NULL : options par défaut).
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+int BaselineSave(const char *path, const BaselineOptions *options) {
+    BaselineOptions defaults;
+    if (options == NULL) {
+        BaselineDefaults(&defaults);
+        options = &defaults;
+    }
+
+    HostInfo host;
+    GetHostInfo(&host);
+
+    Baseline previous, baseline;
+    memset(&baseline, 0, sizeof(baseline));
+    int loaded = baseline_load(path, &previous);
+    if (loaded < 0) return -1;
+    if (loaded == 2) printf("Replacing the outdated baseline %s\n", path);
+
+    int status = 0;
+    for (int i = 0; i < previous.nbHosts && status == 0; i++) {
+        if (strcmp(previous.hosts[i].fingerprint, host.fingerprint) != 0) status = add_host(&baseline, &previous.hosts[i]);
+    }
+    for (int i = 0; i < previous.nbEntries && status == 0; i++) {
+        if (strcmp(previous.entries[i].host, host.fingerprint) != 0) status = add_entry(&baseline, &previous.entries[i]);
+    }
+    if (status == 0) status = add_host(&baseline, &host);
+    baseline_free(&previous);
+
+    printf("\n=== Baseline for %s (%s, %d CPUs, host %s) ===\n", host.cpu, host.system, host.cpus, host.fingerprint);
+    for (int s = 0; s < options->nbSizes && status == 0; s++) {
+        for (int d = 1; d <= BASELINE_NB_DISTRIBUTIONS && status == 0; d++) {
+            for (int a = 0; a < SortAlgorithmCount() && status == 0; a++) {
+                const SortAlgorithm *algo = SortGetAlgorithm(a);
+                if (algo->cost == SORT_COST_QUADRATIC && options->sizes[s] > options->quadraticLimit) continue;
+
+                BaselineEntry entry;
+                memset(&entry, 0, sizeof(entry));
+                copy_string(entry.algorithm, sizeof(entry.algorithm), algo->name);
+                copy_string(entry.host, sizeof(entry.host), host.fingerprint);
+                entry.distribution = d;
+                entry.size = options->sizes[s];
+                entry.threads = algo->parallel ? TuningThreads() : 1;
+                entry.seed = options->seed;
+
+                if (measure_entry(algo, &entry) != 0) {
+                    status = -1;
+                    break;
+                }
+                printf("%-14s type %d  n = %-9ld median %10.3f ms (%d reps)\n",
+                       entry.algorithm, d, entry.size, entry.median * 1e3, entry.nbSamples);
+                fflush(stdout);
+                status = add_entry(&baseline, &entry);
+            }
+        }
+    }
+
+    if (status == 0) status = baseline_write(path, &baseline);
+    if (status == 0) printf("Baseline written to %s\n", path);
+    baseline_free(&baseline);
+    return status;
+}
+
+/**
+ * @brief Remesure les configurations de la machine courante et les compare à la référence.
+ *
+ * Une configuration régresse si sa médiane dépasse celle de la référence de plus du seuil et si le test
+ * de Mann-Whitney sur les temps bruts est significatif ; l'amélioration est détectée symétriquement.
+ *
+ * @param path Le fichier de référence.
+ * @param options Le seuil et le niveau de signification (NULL : options par défaut).
+ * @return 0 sans régression, 1 si au moins une configuration régresse, 2 si la référence est inutilisable.
+ */
+int BaselineCompare(const char *path, const BaselineOptions *options) {
+    BaselineOptions defaults;
+    if (options == NULL) {
+        BaselineDefaults(&defaults);
+        options = &defaults;
+    }
+
+    Baseline baseline;
+    int loaded = baseline_load(path, &baseline);
+    if (loaded != 0) {
+        if (loaded == 1) fprintf(stderr, "%s: no such baseline file\n", path);
+        if (loaded == 2) fprintf(stderr, "Run --baseline-save to measure it again.\n");
+        return 2;
+    }
+
+    HostInfo host;
+    GetHostInfo(&host);
+
+    int compared = 0, regressions = 0, improvements = 0, mismatches = 0;
+    printf("\n=== Regression check against %s (host %s, threshold %.1f%%, alpha %.3g) ===\n",
+           path, host.fingerprint, options->threshold * 100.0, options->alpha);
+    printf("%-14s %4s %10s %5s %12s %12s %9s %10s  %s\n",
+           "Algorithm", "type", "n", "thr", "base (ms)", "now (ms)", "change", "p-value", "verdict");
+
+    for (int i = 0; i < baseline.nbEntries; i++) {
+        BaselineEntry *base = &baseline.entries[i];
+        if (strcmp(base->host, host.fingerprint) != 0) continue;
+
+        const SortAlgorithm *algo = SortFindAlgorithm(base->algorithm);
+        if (algo == NULL) {
+            printf("%-14s %4d %10ld %5d   (algorithm no longer available)\n",
+                   base->algorithm, base->distribution, base->size, base->threads);
+            continue;
+        }
+
+        // A parallel sort on another thread count is a different configuration, not a regression.
+        int threads = algo->parallel ? TuningThreads() : 1;
+        if (base->threads != threads) {
+            printf("%-14s %4d %10ld %5d   (configuration mismatch: %d thread(s) now)\n",
+                   base->algorithm, base->distribution, base->size, base->threads, threads);
+            mismatches++;
+            continue;
+        }
+
+        BaselineEntry current = *base;
+        current.threads = threads;
+        if (measure_entry(algo, &current) != 0) continue;
+        compared++;
+
+        double ratio = base->median > 0 ? current.median / base->median : 1.0;
+        double pSlower = StatsMannWhitneyGreater(base->samples, base->nbSamples, current.samples, current.nbSamples);
+        double pFaster = StatsMannWhitneyGreater(current.samples, current.nbSamples, base->samples, base->nbSamples);
+
+        const char *verdict = "ok";
+        double p = pSlower < pFaster ? pSlower : pFaster;
+        if (pSlower < options->alpha && ratio > 1.0 + options->threshold) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (pFaster < options->alpha && ratio < 1.0 - options->threshold) {
+            verdict = "improved";
+            improvements++;
+        }
+
+        printf("%-14s %4d %10ld %5d %12.3f %12.3f %+8.1f%% %10.2e  %s\n",
+               base->algorithm, base->distribution, base->size, base->threads,
+               base->median * 1e3, current.median * 1e3, (ratio - 1.0) * 100.0, p, verdict);
+        fflush(stdout);
+    }
+
+    if (compared == 0 && mismatches == 0) {
+        fprintf(stderr, "No baseline entries for this host (%s: %s, %s, %d CPUs); run --baseline-save first.\n",
+                host.fingerprint, host.cpu, host.system, host.cpus);
+        baseline_free(&baseline);
+        return 2;
+    }
+
+    printf("%d configurations compared: %d regression(s), %d improvement(s)", compared, regressions, improvements);
+    if (mismatches > 0) printf(", %d skipped (thread count differs)", mismatches);
+    printf("\n");
+    baseline_free(&baseline);
+    return regressions > 0 ? 1 : 0;
+}
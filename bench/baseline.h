@@ -0,0 +1,34 @@
+/**
+ * @file bench/baseline.h
+ * @brief Référence de performances enregistrée en JSON et détection des régressions.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef BASELINE_H
+#define BASELINE_H
+
+// Version 2: inputs drawn from a generator seeded per entry (version 1 used srand/rand).
+#define BASELINE_VERSION 2
+#define BASELINE_MAX_SIZES 8
+
+typedef struct BaselineOptions {
+    long sizes[BASELINE_MAX_SIZES]; // input sizes of the suite
+    int nbSizes;
+    long quadraticLimit;  // quadratic sorts are skipped above this size
+    unsigned int seed;    // seed of the generator of every input (see SessionSeed)
+    double threshold;     // relative slowdown of the median reported as a regression
+    double alpha;         // significance level of the Mann-Whitney test
+} BaselineOptions;
+
+void BaselineDefaults(BaselineOptions *options);
+
+// Run the suite and store it in path, replacing the entries of this host only. Returns 0 or -1.
+int BaselineSave(const char *path, const BaselineOptions *options);
+
+// Rerun the configurations stored for this host and report each one. Parallel entries saved with another
+// thread count are reported as a configuration mismatch and not measured.
+// Returns 0 (no regression), 1 (at least one regression) or 2 (no usable baseline).
+int BaselineCompare(const char *path, const BaselineOptions *options);
+
+#endif // BASELINE_H
@@ -0,0 +1,125 @@
+#include "bench.h"
+#include "runner.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @file bench.c
+ * @brief Mesure des algorithmes de tri silencieux.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+/**
+ * @brief Affiche une métrique dérivée, ou "-" si elle n'est pas disponible.
+ */
+static void print_metric(double value, const char *format) {
+    if (value < 0) {
+        printf("%10s", "-");
+    } else {
+        printf(format, value);
+    }
+}
+
+/**
+ * @brief Affiche une taille en octets avec l'unité binaire la plus grande qui la garde entière.
+ */
+static void print_size(size_t bytes) {
+    const char *units[] = { "B", "KiB", "MiB", "GiB", "TiB" };
+    int u = 0;
+    while (u < 4 && bytes >= 1024 && bytes % 1024 == 0) {
+        bytes /= 1024;
+        u++;
+    }
+    printf("%zu %s", bytes, units[u]);
+}
+
+/**
+ * @brief Affiche les classes de taille non vides d'une répétition : "borne basse x nombre".
+ */
+static void print_size_classes(const AllocStats *memory) {
+    if (memory->allocations == 0) return;
+    printf("%-14s sizes:", "");
+    for (int b = 0; b < ALLOC_HISTOGRAM_BUCKETS; b++) {
+        if (memory->histogram[b] == 0) continue;
+        printf(" ");
+        print_size(b == 0 ? 0 : (size_t)1 << b);
+        printf("+ x%ld", memory->histogram[b]);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Mesure chaque algorithme silencieux sur des copies de l'échantillon.
+ *
+ * Pour chaque algorithme : nombre de répétitions, min, médiane, moyenne, écart type, p95 et intervalle
+ * de confiance à 95 % (en ms), puis si les compteurs matériels sont disponibles : IPC, taux de
+ * branchements mal prédits et défauts de cache L1d / LLC / dTLB par élément. Les allocations de la dernière
+ * répétition suivent (pic, nombre, classes de taille sur une seconde ligne). Un algorithme dont le résultat
+ * n'est pas une permutation triée de l'échantillon est signalé à la place de ses mesures.
+ *
+ * @param tab L'échantillon de départ (non modifié).
+ * @param n Le nombre d'éléments.
+ * @param options Les options du lanceur (NULL : options par défaut).
+ */
+void RunBenchmark(const int tab[], int n, const RunnerOptions *options) {
+    if (n <= 0) return;
+
+    RunnerOptions defaults;
+    if (options == NULL) {
+        RunnerDefaults(&defaults);
+        options = &defaults;
+    }
+
+    printf("\n=== Benchmark (n = %d, %s caches) ===\n", n, options->flushCaches ? "cold" : "warm");
+    printf("%-14s %5s %10s %10s %10s %9s %10s %23s %4s %10s %7s %7s",
+           "Algorithm", "reps", "min", "median", "mean", "stddev", "p95", "95% CI (ms)", "out", "peak KiB", "malloc", "arena");
+    if (options->useCounters) {
+        printf("%10s%10s%10s%10s%10s", "IPC", "br-miss%", "L1d/elt", "LLC/elt", "dTLB/elt");
+    }
+    printf("\n");
+
+    int warned = 0;
+    for (int a = 0; a < SortAlgorithmCount(); a++) {
+        const SortAlgorithm *algo = SortGetAlgorithm(a);
+        if (!SortAlgorithmFits(algo, n)) {
+            printf("%-14s skipped (quadratic, n > %d)\n", algo->name, SORT_QUADRATIC_MAX);
+            continue;
+        }
+        RunnerOptions runner = *options;
+        if (algo->parallel) runner.cpu = RUNNER_NO_PIN;
+
+        RunnerResult result;
+        if (RunnerMeasure(algo->sort, tab, n, &runner, &result) != 0) {
+            if (result.verdict.firstUnsorted >= 0) {
+                printf("%-14s FAILED: output is not sorted at index %d\n", algo->name, result.verdict.firstUnsorted);
+            } else if (!result.verdict.permutation) {
+                printf("%-14s FAILED: output is not a permutation of the input\n", algo->name);
+            }
+            continue;
+        }
+
+        const StatsSummary *t = &result.time;
+        printf("%-14s %5d %10.3f %10.3f %10.3f %9.3f %10.3f   [%9.3f, %9.3f] %4d",
+               algo->name, result.reps, t->min * 1e3, t->median * 1e3, t->mean * 1e3,
+               t->stddev * 1e3, t->p95 * 1e3, t->ciLow * 1e3, t->ciHigh * 1e3, t->rejected);
+        const AllocStats *memory = &result.memory;
+        printf(" %10.1f %7ld %7ld", memory->peakBytes / 1024.0,
+               memory->allocations - memory->arenaAllocations, memory->arenaAllocations);
+
+        if (result.hasCounters) {
+            const PerfSample *sample = &result.counters;
+            double missRate = PerfBranchMissRate(sample);
+            print_metric(PerfIpc(sample), "%10.2f");
+            print_metric(missRate < 0 ? missRate : missRate * 100.0, "%10.2f");
+            print_metric(PerfPerElement(sample, PERF_L1D_MISSES, n), "%10.2f");
+            print_metric(PerfPerElement(sample, PERF_LLC_MISSES, n), "%10.3f");
+            print_metric(PerfPerElement(sample, PERF_DTLB_MISSES, n), "%10.3f");
+        } else if (options->useCounters && !warned) {
+            printf("  (hardware counters unavailable, check /proc/sys/kernel/perf_event_paranoid)");
+            warned = 1;
+        }
+        printf("\n");
+        print_size_classes(memory);
+    }
+}
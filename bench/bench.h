@@ -0,0 +1,21 @@
+/**
+ * @file bench/bench.h
+ * @brief Mesure des algorithmes de tri silencieux (temps et compteurs matériels).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "../sorting/registry.h"
+
+struct RunnerOptions;
+
+// Measure every registered algorithm on copies of tab (tab itself is left untouched)
+// with the repetition runner; options NULL uses RunnerDefaults. Quadratic algorithms
+// are skipped above SORT_QUADRATIC_MAX. Hardware counters are reported when
+// requested and allowed by the kernel.
+void RunBenchmark(const int tab[], int n, const struct RunnerOptions *options);
+
+#endif // BENCH_H
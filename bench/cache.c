@@ -0,0 +1,280 @@
+#include "cache.h"
+#include "bench.h"
+#include "../sorting/events.h"
+#include "../export/png.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file cache.c
+ * @brief Simulation de caches sur les accès des tris instrumentés.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Les événements des tris (comparaisons, échanges, écritures, opérations sur des zones) sont traduits en
+ * accès aux cases du tableau, le tableau étant supposé aligné sur une ligne de cache. Les tampons de travail
+ * des tris (fusion, base...) n'émettent pas d'événements et ne sont pas simulés : les défauts estimés sont
+ * ceux du tableau trié. Comme les tailles de caches sont libres, on peut prévoir le comportement d'une
+ * taille d'entrée trop grande pour être mesurée en réduisant les caches dans la même proportion.
+ *
+ * La carte de chaleur a une colonne par tranche d'adresses et une ligne par tranche de temps (en accès).
+ * Quand les lignes sont toutes remplies, elles sont fusionnées deux à deux et chaque ligne couvre deux fois
+ * plus d'accès. La luminosité suit le nombre d'accès (échelle logarithmique), la couleur le niveau moyen
+ * qui les a servis : bleu pour L1, puis vert, jaune et rouge pour la mémoire.
+ */
+
+/**
+ * @brief État de l'analyse d'un tri, passé au consommateur d'événements.
+ */
+typedef struct CacheTrace {
+    CacheSim *sim;
+    int n;
+    int width;
+    int height;
+    long long *accesses;   // height x width cells
+    long long *levelSum;   // sum of the levels that served the accesses of a cell
+    long long rowSpan;     // accesses per row
+    long long rowFill;     // accesses in the current row
+    int row;
+} CacheTrace;
+
+/**
+ * @brief Valeurs par défaut : caches de la machine, carte de 512 x 512 sans fichier.
+ *
+ * @param options Les options à remplir.
+ */
+void CacheAnalysisDefaults(CacheAnalysisOptions *options) {
+    CacheDefaults(&options->cache);
+    options->heatmapDir = NULL;
+    options->width = CACHE_HEATMAP_WIDTH;
+    options->height = CACHE_HEATMAP_HEIGHT;
+}
+
+/**
+ * @brief Fusionne les lignes de la carte deux à deux : chaque ligne couvre deux fois plus d'accès.
+ */
+static void fold_rows(CacheTrace *trace) {
+    int half = trace->height / 2;
+    for (int r = 0; r < half; r++) {
+        long long *dst = trace->accesses + (long)r * trace->width;
+        long long *dstLevel = trace->levelSum + (long)r * trace->width;
+        const long long *a = trace->accesses + (long)(2 * r) * trace->width;
+        const long long *aLevel = trace->levelSum + (long)(2 * r) * trace->width;
+        for (int c = 0; c < trace->width; c++) {
+            dst[c] = a[c] + a[c + trace->width];
+            dstLevel[c] = aLevel[c] + aLevel[c + trace->width];
+        }
+    }
+    size_t rest = (size_t)(trace->height - half) * trace->width * sizeof(long long);
+    memset(trace->accesses + (long)half * trace->width, 0, rest);
+    memset(trace->levelSum + (long)half * trace->width, 0, rest);
+    trace->row = half;
+    trace->rowSpan *= 2;
+}
+
+/**
+ * @brief Accès à la case index du tableau.
+ */
+static void touch(CacheTrace *trace, int index) {
+    if ((unsigned int)index >= (unsigned int)trace->n) return;
+    int level = CacheSimAccess(trace->sim, (unsigned long)index * sizeof(int));
+    if (trace->accesses == NULL) return;
+
+    long cell = (long)trace->row * trace->width + (long)((long long)index * trace->width / trace->n);
+    trace->accesses[cell]++;
+    trace->levelSum[cell] += level;
+    if (++trace->rowFill == trace->rowSpan) {
+        trace->rowFill = 0;
+        if (++trace->row == trace->height) fold_rows(trace);
+    }
+}
+
+/**
+ * @brief Consommateur d'événements : chaque étape accède à ses deux cases, sauf une écriture qui ne touche
+ * que la case écrite (la seconde n'est qu'une mise en évidence).
+ */
+static void cache_sink(const int arr[], int n, const SortEvent events[], int count, void *user) {
+    (void)arr; (void)n;
+    CacheTrace *trace = (CacheTrace*)user;
+
+    for (int i = 0; i < count; i++) {
+        const SortEvent *event = &events[i];
+        int single = event->type == SORT_EVENT_WRITE || event->type == SORT_EVENT_WRITE_RANGE;
+        long steps = SortEventSteps(event);
+        for (long s = 0; s < steps; s++) {
+            int a, b;
+            SortEventStep(event, s, &a, &b);
+            touch(trace, a);
+            if (!single && b != a) touch(trace, b);
+        }
+    }
+}
+
+/**
+ * @brief Couleur d'un niveau moyen t entre 0 (L1) et 1 (mémoire), sur un dégradé bleu, vert, jaune, rouge.
+ */
+static void level_color(double t, double *r, double *g, double *b) {
+    static const double stops[4][3] = {
+        { 60, 120, 255 }, { 70, 220, 110 }, { 255, 215, 50 }, { 255, 50, 40 }
+    };
+    double x = t * 3.0;
+    int i = x >= 3.0 ? 2 : (int)x;
+    double f = x - i;
+    *r = stops[i][0] + (stops[i + 1][0] - stops[i][0]) * f;
+    *g = stops[i][1] + (stops[i + 1][1] - stops[i][1]) * f;
+    *b = stops[i][2] + (stops[i + 1][2] - stops[i][2]) * f;
+}
+
+/**
+ * @brief Écrit la carte de chaleur d'un tri en PNG (lignes utilisées seulement).
+ *
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+static int write_heatmap(const CacheTrace *trace, int nbLevels, const char *path) {
+    int rows = trace->row + (trace->rowFill > 0);
+    if (rows == 0) return 0;
+
+    long long maxCount = 1;
+    for (long i = 0; i < (long)rows * trace->width; i++) {
+        if (trace->accesses[i] > maxCount) maxCount = trace->accesses[i];
+    }
+
+    uint32_t *pixels = (uint32_t*)malloc((size_t)rows * trace->width * sizeof(uint32_t));
+    if (pixels == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+    double scale = 1.0 / log1p((double)maxCount);
+    for (long i = 0; i < (long)rows * trace->width; i++) {
+        long long count = trace->accesses[i];
+        if (count == 0) {
+            pixels[i] = 0xFF000000u;
+            continue;
+        }
+        double r, g, b;
+        level_color((double)trace->levelSum[i] / count / nbLevels, &r, &g, &b);
+        double v = 0.15 + 0.85 * log1p((double)count) * scale;
+        pixels[i] = 0xFF000000u | (uint32_t)(r * v) << 16 | (uint32_t)(g * v) << 8 | (uint32_t)(b * v);
+    }
+
+    unsigned char *png = NULL;
+    size_t pngLen = 0;
+    int status = PngEncode(pixels, trace->width, rows, trace->width, &png, &pngLen);
+    free(pixels);
+    if (status != 0) return -1;
+
+    FILE *f = fopen(path, "wb");
+    if (f == NULL || fwrite(png, 1, pngLen, f) != pngLen) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        if (f) fclose(f);
+        free(png);
+        return -1;
+    }
+    fclose(f);
+    free(png);
+    return 0;
+}
+
+/**
+ * @brief Simule les caches sur les accès de chaque tri instrumenté, affiche les défauts par niveau et écrit
+ * éventuellement une carte de chaleur par tri.
+ *
+ * Pour chaque tri : nombre d'accès au tableau (par élément), puis pour chaque niveau le taux de défauts
+ * (défauts / accès présentés à ce niveau) et les défauts par élément.
+ *
+ * @param tab L'échantillon de départ (non modifié).
+ * @param n Le nombre d'éléments.
+ * @param options Les caches et la carte de chaleur (NULL : valeurs par défaut).
+ */
+void RunCacheAnalysis(const int tab[], int n, const CacheAnalysisOptions *options) {
+    if (n <= 0) return;
+
+    CacheAnalysisOptions defaults;
+    if (options == NULL) {
+        CacheAnalysisDefaults(&defaults);
+        options = &defaults;
+    }
+
+    CacheSim sim;
+    if (CacheSimInit(&sim, &options->cache) != 0) return;
+    int *work = (int*)malloc(n * sizeof(int));
+    CacheTrace trace;
+    memset(&trace, 0, sizeof(trace));
+    trace.sim = &sim;
+    trace.n = n;
+    trace.width = options->width;
+    trace.height = options->height & ~1;
+    size_t cells = (size_t)trace.width * trace.height;
+    if (options->heatmapDir != NULL && trace.width > 0 && trace.height > 0) {
+        trace.accesses = (long long*)malloc(cells * sizeof(long long));
+        trace.levelSum = (long long*)malloc(cells * sizeof(long long));
+    }
+    if (work == NULL || (options->heatmapDir != NULL && (trace.accesses == NULL || trace.levelSum == NULL))) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(work);
+        free(trace.accesses);
+        free(trace.levelSum);
+        CacheSimFree(&sim);
+        return;
+    }
+
+    printf("\n=== Cache simulation (n = %d) ===\n", n);
+    CachePrintConfig(&options->cache);
+    printf("%-14s %12s %8s", "Algorithm", "accesses", "acc/elt");
+    for (int l = 0; l < sim.nbLevels; l++) {
+        char label[16];
+        snprintf(label, sizeof(label), "%s miss%%", options->cache.levels[l].name);
+        printf(" %9s", label);
+        snprintf(label, sizeof(label), "%s/elt", options->cache.levels[l].name);
+        printf(" %8s", label);
+    }
+    printf("\n");
+
+    for (int a = 0; a < SortAlgorithmCount(); a++) {
+        const SortAlgorithm *algo = SortGetAlgorithm(a);
+        if (algo->sortViz == NULL) continue;
+        if (algo->cost == SORT_COST_QUADRATIC && n > CACHE_QUADRATIC_MAX) {
+            printf("%-14s skipped (quadratic, n > %d)\n", algo->name, CACHE_QUADRATIC_MAX);
+            continue;
+        }
+
+        memcpy(work, tab, n * sizeof(int));
+        CacheSimReset(&sim);
+        trace.row = 0;
+        trace.rowFill = 0;
+        trace.rowSpan = 1;
+        if (trace.accesses != NULL) {
+            memset(trace.accesses, 0, cells * sizeof(long long));
+            memset(trace.levelSum, 0, cells * sizeof(long long));
+        }
+
+        SortRunEvents(algo->sortViz, work, n, cache_sink, &trace);
+
+        long long accesses = sim.levels[0].accesses;
+        printf("%-14s %12lld %8.2f", algo->name, accesses, (double)accesses / n);
+        for (int l = 0; l < sim.nbLevels; l++) {
+            const CacheLevel *level = &sim.levels[l];
+            double rate = level->accesses > 0 ? 100.0 * level->misses / level->accesses : 0.0;
+            printf(" %9.2f %8.3f", rate, (double)level->misses / n);
+        }
+        printf("\n");
+
+        if (trace.accesses != NULL) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/heatmap-%s.png", options->heatmapDir, algo->name);
+            write_heatmap(&trace, sim.nbLevels, path);
+        }
+    }
+
+    if (options->heatmapDir != NULL) {
+        printf("Heatmaps written to %s/heatmap-<algorithm>.png (x: address, y: time, colour: L1 -> memory)\n",
+               options->heatmapDir);
+    }
+    free(work);
+    free(trace.accesses);
+    free(trace.levelSum);
+    CacheSimFree(&sim);
+}
@@ -0,0 +1,30 @@
+/**
+ * @file bench/cache.h
+ * @brief Analyse des accès mémoire des tris : simulation de caches et carte de chaleur temps / adresse.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef CACHE_BENCH_H
+#define CACHE_BENCH_H
+
+#include "../stats/cachesim.h"
+
+#define CACHE_HEATMAP_WIDTH 512
+#define CACHE_HEATMAP_HEIGHT 512
+// Above this size, the quadratic sorts are left out of the analysis.
+#define CACHE_QUADRATIC_MAX (1 << 14)
+
+typedef struct CacheAnalysisOptions {
+    CacheConfig cache;
+    const char *heatmapDir; // directory of the heatmap-<algorithm>.png images, NULL for none
+    int width;              // heatmap columns (address) and rows (time)
+    int height;
+} CacheAnalysisOptions;
+
+void CacheAnalysisDefaults(CacheAnalysisOptions *options);
+// Feed the array accesses of every instrumented sort through the simulated caches and print the misses
+// per level; tab is left untouched, options NULL uses CacheAnalysisDefaults.
+void RunCacheAnalysis(const int tab[], int n, const CacheAnalysisOptions *options);
+
+#endif // CACHE_BENCH_H
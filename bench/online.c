@@ -0,0 +1,151 @@
+#include "online.h"
+#include "bench.h"
+#include "runner.h"
+#include "../sorting/online.h"
+#include "../sorting/tuning.h"
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file online.c
+ * @brief Mesure du conteneur trié alimenté par lots.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * L'échantillon arrive par lots. Le conteneur insère chaque lot puis répond à une requête de rang ; l'autre
+ * stratégie garde un tableau trié et le trie en entier après chaque lot. Le coût d'un lot de cette dernière
+ * est mesuré directement à quelques tailles : tableau trié suivi du nouveau lot, trié par l'algorithme.
+ */
+
+/**
+ * @brief Tris complets comparés au conteneur (noms du registre).
+ */
+static const char *const resorts[] = { "QuickSort", "MergeSort", "NaturalMerge" };
+
+#define NB_RESORTS ((int)(sizeof(resorts) / sizeof(resorts[0])))
+
+/**
+ * @brief Temps médian du tri d'un tableau trié de size - batch valeurs suivi d'un lot de batch valeurs.
+ *
+ * @param work Tampon d'au moins size cases.
+ * @return Le temps en secondes, ou -1 si le tri a échoué.
+ */
+static double resort_time(const SortAlgorithm *algo, const int tab[], int size, int batch, int work[]) {
+    memcpy(work, tab, (size_t)size * sizeof(int));
+    ParallelQuickSort(work, size - batch);
+
+    RunnerOptions options;
+    RunnerDefaults(&options);
+    options.warmup = 1;
+    options.minReps = 3;
+    options.maxSeconds = 2.0;
+    if (algo->parallel) options.cpu = RUNNER_NO_PIN;
+    RunnerResult result;
+    if (RunnerMeasure(algo->sort, work, size, &options, &result) != 0) return -1.0;
+    return result.time.median;
+}
+
+/**
+ * @brief Insère l'échantillon par lots dans un conteneur trié et compare, à des tailles croissantes
+ * (x4), le coût moyen et le pire coût d'un lot avec celui d'un tri complet après le lot. Termine par la
+ * lecture ordonnée du conteneur et sa fusion en une seule suite, vérifiée contre l'échantillon.
+ *
+ * @param tab L'échantillon (non modifié).
+ * @param n Le nombre d'éléments.
+ * @param batch Le nombre de valeurs par lot (ONLINE_BENCH_BATCH si <= 0).
+ */
+void RunOnlineBenchmark(const int tab[], int n, int batch) {
+    if (n <= 0) return;
+    if (batch <= 0) batch = ONLINE_BENCH_BATCH;
+    if (batch > n) batch = n;
+
+    int *work = (int*)SortMalloc((size_t)n * sizeof(int));
+    if (work == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return;
+    }
+    SortedStream stream;
+    SortedStreamInit(&stream, TuningThreads() > 1);
+
+    printf("\n=== Online inserts (n = %d, batches of %d, %s merges) ===\n", n, batch,
+           stream.background ? "background" : "inline");
+    printf("%10s %12s %12s", "size", "batch mean", "batch max");
+    for (int r = 0; r < NB_RESORTS; r++) printf(" %12s", resorts[r]);
+    printf(" %9s\n", "speedup");
+
+    int slow[NB_RESORTS] = { 0 };
+    volatile long long ranks = 0;  // keeps the rank queries
+    double total = 0;
+    int done = 0;
+    long long next = 4LL * batch;
+    while (done < n) {
+        int checkpoint = next < n ? (int)next : n;
+        double sum = 0, worst = 0;
+        int batches = 0, last = 0;
+        while (done < checkpoint) {
+            last = n - done < batch ? n - done : batch;
+            double start = StatsNow();
+            if (SortedStreamInsert(&stream, tab + done, last) != 0) {
+                printf("FAILED: insertion of a batch at %d\n", done);
+                SortedStreamFree(&stream);
+                SortFree(work);
+                return;
+            }
+            ranks += SortedStreamRank(&stream, tab[done]);
+            double elapsed = StatsNow() - start;
+            sum += elapsed;
+            if (elapsed > worst) worst = elapsed;
+            batches++;
+            done += last;
+        }
+        total += sum;
+        double mean = sum / batches;
+        printf("%10d %12.3f %12.3f", done, mean * 1e3, worst * 1e3);
+        fflush(stdout);
+
+        double best = -1.0;
+        for (int r = 0; r < NB_RESORTS; r++) {
+            const SortAlgorithm *algo = SortFindAlgorithm(resorts[r]);
+            if (algo == NULL || slow[r]) {
+                printf(" %12s", "-");
+                continue;
+            }
+            double t = resort_time(algo, tab, done, last, work);
+            if (t < 0) {
+                printf(" %12s", "FAILED");
+                continue;
+            }
+            if (t > ONLINE_BENCH_SLOW) slow[r] = 1;
+            if (best < 0 || t < best) best = t;
+            printf(" %12.3f", t * 1e3);
+            fflush(stdout);
+        }
+        if (best > 0 && mean > 0) printf(" %8.1fx\n", best / mean);
+        else printf(" %9s\n", "-");
+        next *= 4;
+    }
+    printf("(ms per batch: insertion and one rank query; re-sorts: sorted array plus the new batch, median)\n");
+    printf("%d values inserted in %.3f ms, %d runs\n", n, total * 1e3, stream.nbRuns);
+
+    double start = StatsNow();
+    SortedStreamCursor cursor;
+    SortedStreamSeek(&cursor, &stream, INT_MIN, INT_MAX);
+    long long scanned = 0;
+    int value;
+    while (SortedStreamNext(&cursor, &value)) scanned++;
+    double scan = StatsNow() - start;
+
+    start = StatsNow();
+    int flushed = SortedStreamFlush(&stream);
+    double flush = StatsNow() - start;
+    printf("Ordered scan: %.3f ms, flush into one run: %.3f ms\n", scan * 1e3, flush * 1e3);
+
+    SortChecksum input;
+    SortChecksumCompute(&input, tab, n);
+    if (flushed != 0 || scanned != n || stream.nbRuns != 1 || SortVerify(stream.runs[0].values, n, &input, NULL) != 0) {
+        printf("FAILED: the container does not hold the sorted sample\n");
+    }
+    SortedStreamFree(&stream);
+    SortFree(work);
+}
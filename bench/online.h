@@ -0,0 +1,21 @@
+/**
+ * @file bench/online.h
+ * @brief Mesure du conteneur trié alimenté par lots, face au tri complet du tableau après chaque lot.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef ONLINE_BENCH_H
+#define ONLINE_BENCH_H
+
+// Default number of values per inserted batch.
+#define ONLINE_BENCH_BATCH 1024
+// A re-sort slower than this (seconds) is not measured again at the next, four times larger, size.
+#define ONLINE_BENCH_SLOW 0.5
+
+// Feed tab to a SortedStream in batches (one rank query after each) and compare the cost of a batch with
+// re-sorting the whole array after it (QuickSort, MergeSort, NaturalMerge), at sizes growing x4 up to n.
+// tab is left untouched; batch <= 0 uses ONLINE_BENCH_BATCH.
+void RunOnlineBenchmark(const int tab[], int n, int batch);
+
+#endif // ONLINE_BENCH_H
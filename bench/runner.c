@@ -0,0 +1,189 @@
+#define _GNU_SOURCE
+#include "runner.h"
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @file runner.c
+ * @brief Exécution répétée d'un tri et résumé statistique des temps mesurés.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Chaque répétition repart du même instantané de l'entrée. Le nombre de répétitions s'adapte :
+ * la mesure s'arrête dès que l'intervalle de confiance à 95 % de la moyenne est assez étroit,
+ * ou lorsque le budget de temps est épuisé.
+ */
+
+/**
+ * @brief Taille minimale du tampon utilisé pour évincer les caches.
+ */
+#define RUNNER_FLUSH_MIN_BYTES (32L * 1024 * 1024)
+
+/**
+ * @brief Options par défaut : 2 échauffements, 5 à 50 répétitions, IC à 2 %, 10 s par configuration,
+ * thread épinglé sur le processeur courant, caches chauds, rejet des valeurs aberrantes, résultat vérifié.
+ *
+ * @param options Les options à remplir.
+ */
+void RunnerDefaults(RunnerOptions *options) {
+    options->warmup = 2;
+    options->minReps = 5;
+    options->maxReps = 50;
+    options->targetRelCI = 0.02;
+    options->maxSeconds = 10.0;
+    options->cpu = RUNNER_PIN_CURRENT;
+    options->flushCaches = 0;
+    options->rejectOutliers = 1;
+    options->useCounters = 0;
+    options->verify = 1;
+}
+
+/**
+ * @brief Taille du tampon d'éviction : quatre fois le dernier niveau de cache, au moins 32 Mo.
+ */
+static size_t flush_size(void) {
+    long llc = -1;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (llc <= 0) llc = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    long size = llc > 0 ? 4 * llc : 0;
+    return (size_t)(size > RUNNER_FLUSH_MIN_BYTES ? size : RUNNER_FLUSH_MIN_BYTES);
+}
+
+/**
+ * @brief Évince les caches en écrivant puis relisant un tampon plus grand que le dernier niveau de cache.
+ */
+static void flush_caches(unsigned char *buffer, size_t size) {
+    volatile unsigned char sink = 0;
+    for (size_t i = 0; i < size; i += 64) buffer[i] = (unsigned char)i;
+    for (size_t i = 0; i < size; i += 64) sink ^= buffer[i];
+    (void)sink;
+}
+
+/**
+ * @brief Mesure un tri en répétant son exécution sur une copie de l'instantané.
+ *
+ * @param sort Le tri silencieux à mesurer.
+ * @param snapshot L'entrée, recopiée avant chaque exécution (non modifiée).
+ * @param n Le nombre d'éléments.
+ * @param options Les options de mesure (NULL : options par défaut).
+ * @param result Le résultat de la mesure.
+ * @return 0 en cas de succès, -1 en cas d'échec (y compris un résultat faux, hors du temps mesuré).
+ */
+int RunnerMeasure(SortFunction sort, const int snapshot[], int n,
+                  const RunnerOptions *options, RunnerResult *result) {
+    RunnerOptions defaults;
+    if (options == NULL) {
+        RunnerDefaults(&defaults);
+        options = &defaults;
+    }
+    memset(result, 0, sizeof(*result));
+    result->verdict = (SortVerdict){ -1, 1 };
+    if (n <= 0) return -1;
+
+    int maxReps = options->maxReps > 0 ? options->maxReps : 1;
+    int *work = (int*)malloc(n * sizeof(int));
+    double *times = (double*)malloc(maxReps * sizeof(double));
+    size_t flushBytes = options->flushCaches ? flush_size() : 0;
+    unsigned char *flushBuffer = flushBytes ? (unsigned char*)malloc(flushBytes) : NULL;
+    if (work == NULL || times == NULL || (flushBytes && flushBuffer == NULL)) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(work);
+        free(times);
+        free(flushBuffer);
+        return -1;
+    }
+
+#ifdef __linux__
+    cpu_set_t previous;
+    int pinned = 0;
+    if (options->cpu != RUNNER_NO_PIN && sched_getaffinity(0, sizeof(previous), &previous) == 0) {
+        int cpu = options->cpu == RUNNER_PIN_CURRENT ? sched_getcpu() : options->cpu;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu >= 0 ? cpu : 0, &set);
+        pinned = sched_setaffinity(0, sizeof(set), &set) == 0;
+    }
+#endif
+
+    PerfCounters counters;
+    int nbCounters = options->useCounters ? PerfOpen(&counters) : 0;
+    double counterSum[PERF_EVENT_COUNT] = { 0 };
+    int counterValid[PERF_EVENT_COUNT] = { 0 };
+
+    double budgetStart = StatsNow();
+    for (int w = 0; w < options->warmup; w++) {
+        memcpy(work, snapshot, n * sizeof(int));
+        sort(work, n);
+        if (StatsNow() - budgetStart > options->maxSeconds / 2) break;
+    }
+
+    int reps = 0;
+    while (reps < maxReps) {
+        memcpy(work, snapshot, n * sizeof(int));
+        if (flushBuffer) flush_caches(flushBuffer, flushBytes);
+
+        PerfSample sample;
+        AllocRun run;
+        AllocRunInit(&run);
+        AllocRun *previousRun = AllocRunSet(&run);
+        if (nbCounters > 0) PerfStart(&counters);
+        double start = StatsNow();
+        sort(work, n);
+        times[reps] = StatsNow() - start;
+        AllocRunSet(previousRun);
+        AllocRunGet(&run, &result->memory);
+        if (nbCounters > 0) {
+            PerfStop(&counters, &sample);
+            for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+                if (!sample.valid[e]) continue;
+                counterSum[e] += (double)sample.value[e];
+                counterValid[e]++;
+            }
+        }
+        reps++;
+
+        if (StatsNow() - budgetStart > options->maxSeconds) break;
+        if (reps >= options->minReps) {
+            StatsSummary partial;
+            if (StatsSummarize(times, reps, options->rejectOutliers, &partial) == 0 &&
+                partial.mean > 0.0 &&
+                (partial.ciHigh - partial.ciLow) / 2.0 <= options->targetRelCI * partial.mean) {
+                break;
+            }
+        }
+    }
+
+    StatsSummarize(times, reps, options->rejectOutliers, &result->time);
+    result->reps = reps;
+    result->nbSamples = reps < RUNNER_MAX_SAMPLES ? reps : RUNNER_MAX_SAMPLES;
+    memcpy(result->samples, times, result->nbSamples * sizeof(double));
+    if (nbCounters > 0) {
+        result->hasCounters = 1;
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            result->counters.valid[e] = counterValid[e] > 0;
+            result->counters.value[e] = counterValid[e] > 0 ? (long long)(counterSum[e] / counterValid[e]) : 0;
+        }
+        PerfClose(&counters);
+    }
+
+#ifdef __linux__
+    if (pinned) sched_setaffinity(0, sizeof(previous), &previous);
+#endif
+
+    int status = 0;
+    if (options->verify) {
+        SortChecksum input;
+        SortChecksumCompute(&input, snapshot, n);
+        status = SortVerify(work, n, &input, &result->verdict);
+    }
+
+    free(work);
+    free(times);
+    free(flushBuffer);
+    return status;
+}
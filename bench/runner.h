@@ -0,0 +1,54 @@
+/**
+ * @file bench/runner.h
+ * @brief Exécution répétée d'un tri avec échauffement, nombre de répétitions adaptatif et résumé statistique.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include "bench.h"
+#include "../stats/stats.h"
+#include "../stats/perf.h"
+#include "../utils/alloc.h"
+#include "../sorting/verify.h"
+
+#define RUNNER_NO_PIN (-1)
+#define RUNNER_PIN_CURRENT (-2)
+
+// Raw times kept in RunnerResult (later repetitions are only summarized).
+#define RUNNER_MAX_SAMPLES 64
+
+typedef struct RunnerOptions {
+    int warmup;           // untimed runs before measuring
+    int minReps;          // repetitions always measured
+    int maxReps;          // upper bound on repetitions
+    double targetRelCI;   // stop once the CI half-width is below this fraction of the mean
+    double maxSeconds;    // time budget per configuration (at least one repetition is measured)
+    int cpu;              // pin the thread to this CPU (RUNNER_NO_PIN, RUNNER_PIN_CURRENT)
+    int flushCaches;      // evict the caches before every repetition (cold measurements)
+    int rejectOutliers;   // MAD-based outlier rejection
+    int useCounters;      // read hardware counters around every repetition
+    int verify;           // check that the last repetition left a sorted permutation of the snapshot
+} RunnerOptions;
+
+typedef struct RunnerResult {
+    StatsSummary time;    // seconds per run
+    int reps;             // repetitions measured (before outlier rejection)
+    int hasCounters;
+    PerfSample counters;  // mean over the measured repetitions
+    int nbSamples;
+    double samples[RUNNER_MAX_SAMPLES]; // raw seconds per run, in measurement order
+    AllocStats memory;    // allocations of the last measured repetition
+    SortVerdict verdict;  // check of the last repetition's output ({ -1, 1 } when verify is off)
+} RunnerResult;
+
+void RunnerDefaults(RunnerOptions *options);
+
+// Measure sort on a work buffer reset from snapshot before every repetition.
+// Returns -1 on failure, including a wrong output when options->verify is set (see result->verdict).
+int RunnerMeasure(SortFunction sort, const int snapshot[], int n,
+                  const RunnerOptions *options, RunnerResult *result);
+
+#endif // RUNNER_H
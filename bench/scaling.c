@@ -0,0 +1,330 @@
+#include "scaling.h"
+#include "bench.h"
+#include "runner.h"
+#include "../stats/stats.h"
+#include "../utils/utils.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @file scaling.c
+ * @brief Rapport de complexité empirique des algorithmes de tri.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * La taille de l'entrée croît géométriquement. Pour chaque algorithme, le temps médian (et le nombre de
+ * comparaisons) est ajusté en log-log : la pente donne l'exposant mesuré, et le modèle n, n log n ou n²
+ * le plus proche est retenu. Avant chaque mesure, le temps est extrapolé depuis la taille précédente :
+ * un algorithme qui dépasserait le budget quitte le balayage au lieu de le bloquer.
+ */
+
+/**
+ * @brief Nombre maximal de tailles dans un balayage.
+ */
+#define SCALING_MAX_POINTS 64
+
+/**
+ * @brief Temps en dessous duquel une mesure est trop bruitée pour l'ajustement (secondes).
+ */
+#define SCALING_MIN_FIT_TIME 1e-5
+
+/**
+ * @brief Surcoût estimé d'une version instrumentée par rapport à la version silencieuse.
+ */
+#define SCALING_VIZ_OVERHEAD 5.0
+
+/**
+ * @brief Tableaux de n entiers alloués pendant une mesure : l'entrée de référence, la copie pour le comptage
+ * des opérations et le tableau de travail de RunnerMeasure.
+ */
+#define SCALING_BUFFERS 3
+
+/**
+ * @brief Mémoire auxiliaire (en entiers par élément) prévue pour un tri qui ne trie pas en place : tampons
+ * du tri par fusion, sortie du tri par base, suites de OnlineLSM et sortie d'une fusion.
+ */
+#define SCALING_SCRATCH 2
+
+/**
+ * @brief Mesures d'un algorithme au cours du balayage.
+ */
+typedef struct ScalingSeries {
+    int nbTimes;
+    double timeSize[SCALING_MAX_POINTS];
+    double time[SCALING_MAX_POINTS];
+    int nbCmp;
+    double cmpSize[SCALING_MAX_POINTS];
+    double cmp[SCALING_MAX_POINTS];
+    double lastSize;
+    double lastTime;
+    long stoppedAt;
+    int failed;  // stoppedAt is the size of a wrong result
+} ScalingSeries;
+
+/**
+ * @brief Ajustement d'une loi de puissance y = c * n^exponent et modèle de complexité le plus proche.
+ */
+typedef struct PowerFit {
+    int valid;
+    double exponent;
+    double logCoeff;
+    const char *model;
+} PowerFit;
+
+/**
+ * @brief Options par défaut : 1 000 à 100 000 000 éléments par facteur 4, budget de 2 s par exécution.
+ *
+ * @param options Les options à remplir.
+ */
+void ScalingDefaults(ScalingOptions *options) {
+    options->minSize = 1000;
+    options->maxSize = 100000000;
+    options->factor = 4.0;
+    options->memoryBudget = 0;
+    options->timeBudget = 2.0;
+    options->countOps = 1;
+    options->distribution = 1;
+}
+
+/**
+ * @brief Ajuste y = c * n^a par régression linéaire de log y sur log n, puis choisit parmi n, n log n et n²
+ * le modèle dont les résidus (à constante près) sont les plus faibles.
+ */
+static void fit_power(const double x[], const double y[], int count, PowerFit *fit) {
+    static const char *models[3] = { "n", "n log n", "n^2" };
+    memset(fit, 0, sizeof(*fit));
+    fit->model = "-";
+    if (count < 2) return;
+
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (int i = 0; i < count; i++) {
+        double lx = log(x[i]), ly = log(y[i]);
+        sx += lx; sy += ly; sxx += lx * lx; sxy += lx * ly;
+    }
+    double denom = count * sxx - sx * sx;
+    if (denom <= 0) return;
+
+    fit->valid = 1;
+    fit->exponent = (count * sxy - sx * sy) / denom;
+    fit->logCoeff = (sy - fit->exponent * sx) / count;
+
+    double best = INFINITY;
+    for (int m = 0; m < 3; m++) {
+        double residual[SCALING_MAX_POINTS];
+        for (int i = 0; i < count; i++) {
+            double f = m == 0 ? x[i] : (m == 1 ? x[i] * log(x[i]) : x[i] * x[i]);
+            residual[i] = log(y[i]) - log(f);
+        }
+        double logC = StatsMean(residual, count);
+        double rss = 0;
+        for (int i = 0; i < count; i++) rss += (residual[i] - logC) * (residual[i] - logC);
+        if (rss < best) {
+            best = rss;
+            fit->model = models[m];
+        }
+    }
+}
+
+/**
+ * @brief Mémoire utilisable pour les entrées : le budget demandé, sinon un quart de la mémoire physique.
+ */
+static long long memory_budget(const ScalingOptions *options) {
+    if (options->memoryBudget > 0) return options->memoryBudget;
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages <= 0 || pageSize <= 0) return 1LL << 30;
+    return (long long)pages * pageSize / 4;
+}
+
+/**
+ * @brief Extrapole le temps d'un algorithme à la taille n depuis sa dernière mesure.
+ *
+ * L'exposant utilisé est le plus grand entre la pente locale des deux dernières mesures et l'exposant
+ * nominal de la classe de coût de l'algorithme (voir SortCostExponent).
+ */
+static double predict_time(const ScalingSeries *series, SortCost cost, double n) {
+    if (series->nbTimes == 0 || series->lastSize <= 0) return 0.0;
+
+    double exponent = SortCostExponent(cost);
+    int k = series->nbTimes;
+    if (k >= 2 && series->time[k - 2] > SCALING_MIN_FIT_TIME) {
+        double local = log(series->time[k - 1] / series->time[k - 2]) / log(series->timeSize[k - 1] / series->timeSize[k - 2]);
+        if (local > exponent) exponent = local;
+    }
+    return series->lastTime * pow(n / series->lastSize, exponent);
+}
+
+/**
+ * @brief Balaye les tailles d'entrée, mesure chaque algorithme et affiche le rapport de complexité.
+ *
+ * @param options Les options du balayage (NULL : options par défaut).
+ * @return Le nombre d'algorithmes dont le résultat était faux (FAILED dans le tableau), ou -1 si la mémoire
+ * a manqué.
+ */
+int RunScalingReport(const ScalingOptions *options) {
+    ScalingOptions defaults;
+    if (options == NULL) {
+        ScalingDefaults(&defaults);
+        options = &defaults;
+    }
+
+    int nbAlgo = SortAlgorithmCount();
+    long long budget = memory_budget(options);
+    long long perElement = SCALING_BUFFERS;
+    for (int a = 0; a < nbAlgo; a++) {
+        if (!SortGetAlgorithm(a)->inPlace) {
+            perElement = SCALING_BUFFERS + SCALING_SCRATCH;
+            break;
+        }
+    }
+    long maxSize = options->maxSize;
+    if ((long long)maxSize * perElement * (long long)sizeof(int) > budget) {
+        maxSize = (long)(budget / (perElement * (long long)sizeof(int)));
+    }
+    double factor = options->factor > 1.0 ? options->factor : 2.0;
+
+    ScalingSeries *series = (ScalingSeries*)calloc(nbAlgo, sizeof(ScalingSeries));
+    int *snapshot = (int*)malloc(maxSize * sizeof(int));
+    int *work = (int*)malloc(maxSize * sizeof(int));
+    if (series == NULL || snapshot == NULL || work == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(series);
+        free(snapshot);
+        free(work);
+        return -1;
+    }
+
+    printf("\n=== Scaling report (input type %d, %.1f s per run, up to n = %ld) ===\n",
+           options->distribution, options->timeBudget, maxSize);
+    printf("%12s", "n");
+    for (int a = 0; a < nbAlgo; a++) printf(" %14s", SortGetAlgorithm(a)->name);
+    printf("   (median ms)\n");
+
+    int nbSizes = 0;
+    int failures = 0;
+    for (long n = options->minSize; n > 0 && n <= maxSize && nbSizes < SCALING_MAX_POINTS; nbSizes++) {
+        FillSample(snapshot, (int)n, options->distribution);
+        printf("%12ld", n);
+        fflush(stdout);
+
+        for (int a = 0; a < nbAlgo; a++) {
+            const SortAlgorithm *algo = SortGetAlgorithm(a);
+            ScalingSeries *s = &series[a];
+            double predicted = predict_time(s, algo->cost, (double)n);
+
+            if (s->stoppedAt == 0 && predicted > options->timeBudget) {
+                s->stoppedAt = n;
+            }
+            if (s->stoppedAt != 0) {
+                printf(" %14s", "-");
+                fflush(stdout);
+                continue;
+            }
+
+            RunnerOptions runner;
+            RunnerDefaults(&runner);
+            runner.warmup = predicted < options->timeBudget / 10 ? 1 : 0;
+            runner.minReps = 3;
+            runner.maxReps = 10;
+            runner.targetRelCI = 0.05;
+            runner.maxSeconds = options->timeBudget * 3;
+            if (algo->parallel) runner.cpu = RUNNER_NO_PIN;
+
+            RunnerResult result;
+            if (RunnerMeasure(algo->sort, snapshot, (int)n, &runner, &result) != 0) {
+                s->stoppedAt = n;
+                s->failed = result.verdict.firstUnsorted >= 0 || !result.verdict.permutation;
+                failures += s->failed;
+                printf(" %14s", s->failed ? "FAILED" : "-");
+                fflush(stdout);
+                continue;
+            }
+
+            double t = result.time.median;
+            printf(" %14.3f", t * 1e3);
+            fflush(stdout);
+
+            s->lastSize = (double)n;
+            s->lastTime = t;
+            if (t >= SCALING_MIN_FIT_TIME) {
+                s->timeSize[s->nbTimes] = (double)n;
+                s->time[s->nbTimes] = t;
+                s->nbTimes++;
+            }
+
+            if (options->countOps && algo->sortViz && t * SCALING_VIZ_OVERHEAD <= options->timeBudget) {
+                memcpy(work, snapshot, n * sizeof(int));
+                StatsResetCounters();
+                algo->sortViz(work, (int)n, NULL);
+                SortCounters c = StatsGetCounters();
+                if (c.comparisons > 0) {
+                    s->cmpSize[s->nbCmp] = (double)n;
+                    s->cmp[s->nbCmp] = (double)c.comparisons;
+                    s->nbCmp++;
+                }
+            }
+
+            if (t > options->timeBudget) s->stoppedAt = (long)(n * factor);
+        }
+        printf("\n");
+
+        long next = (long)(n * factor);
+        if (next <= n) next = n + 1;
+        if (n < maxSize && next > maxSize) next = maxSize;
+        n = next;
+    }
+
+    PowerFit *fits = (PowerFit*)calloc(nbAlgo, sizeof(PowerFit));
+    if (fits == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(series);
+        free(snapshot);
+        free(work);
+        return -1;
+    }
+
+    printf("\n%-14s %10s %10s %10s %10s %12s\n", "Algorithm", "time exp", "model", "cmp exp", "model", "stopped at");
+    for (int a = 0; a < nbAlgo; a++) {
+        PowerFit cmpFit;
+        fit_power(series[a].timeSize, series[a].time, series[a].nbTimes, &fits[a]);
+        fit_power(series[a].cmpSize, series[a].cmp, series[a].nbCmp, &cmpFit);
+
+        printf("%-14s", SortGetAlgorithm(a)->name);
+        if (fits[a].valid) printf(" %10.2f %10s", fits[a].exponent, fits[a].model);
+        else printf(" %10s %10s", "-", "-");
+        if (cmpFit.valid) printf(" %10.2f %10s", cmpFit.exponent, cmpFit.model);
+        else printf(" %10s %10s", "-", "-");
+        if (series[a].stoppedAt) printf(" %12ld%s\n", series[a].stoppedAt, series[a].failed ? " (wrong result)" : "");
+        else printf(" %12s\n", "-");
+    }
+
+    printf("\nCrossovers (from the power-law fits):\n");
+    for (int a = 0; a < nbAlgo; a++) {
+        for (int b = a + 1; b < nbAlgo; b++) {
+            if (!fits[a].valid || !fits[b].valid) continue;
+            double slope = fits[a].exponent - fits[b].exponent;
+            if (fabs(slope) < 0.05) continue; // same growth: no crossover
+
+            double crossing = exp((fits[b].logCoeff - fits[a].logCoeff) / slope);
+            if (!(crossing > 1.0 && crossing < 1e15)) continue;
+
+            double lo = fmax(series[a].timeSize[0], series[b].timeSize[0]);
+            double hi = fmin(series[a].timeSize[series[a].nbTimes - 1], series[b].timeSize[series[b].nbTimes - 1]);
+            const SortAlgorithm *faster = SortGetAlgorithm(slope > 0 ? b : a);
+            printf("  %s vs %s: n ~ %.0f (%s faster above)%s\n",
+                   SortGetAlgorithm(a)->name, SortGetAlgorithm(b)->name, crossing, faster->name,
+                   crossing >= lo && crossing <= hi ? "" : " [extrapolated]");
+        }
+    }
+
+    if (failures > 0) printf("\nFAILED: %d algorithm(s) returned a wrong result\n", failures);
+
+    free(fits);
+    free(series);
+    free(snapshot);
+    free(work);
+    return failures;
+}
@@ -0,0 +1,25 @@
+/**
+ * @file bench/scaling.h
+ * @brief Rapport de complexité empirique : balayage géométrique des tailles, ajustement log-log et points de croisement.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef SCALING_H
+#define SCALING_H
+
+typedef struct ScalingOptions {
+    long minSize;         // first size of the sweep
+    long maxSize;         // last size, also capped by memoryBudget
+    double factor;        // geometric step between two sizes
+    long long memoryBudget; // bytes for the inputs, work copies and sort scratch (0: a quarter of physical memory)
+    double timeBudget;    // seconds allowed per run; slower algorithms leave the sweep
+    int countOps;         // also count comparisons with the instrumented versions
+    int distribution;     // input type, as in FillSample
+} ScalingOptions;
+
+void ScalingDefaults(ScalingOptions *options);
+// Returns the number of algorithms with a wrong result (shown as FAILED), or -1 on allocation failure.
+int RunScalingReport(const ScalingOptions *options);
+
+#endif // SCALING_H
@@ -0,0 +1,129 @@
+#include "selection.h"
+#include "bench.h"
+#include "runner.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @file selection.c
+ * @brief Mesure des primitives de sélection selon k / n.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+/**
+ * @brief Taille des blocs envoyés au flux de k plus petits éléments.
+ */
+#define SELECTION_STREAM_BLOCK 4096
+
+/**
+ * @brief Valeur de k des fonctions mesurées (le lanceur n'accepte que la signature (tableau, taille)).
+ */
+static _Thread_local int selection_k = 1;
+
+/**
+ * @brief k-ième élément avec la signature (tableau, taille).
+ */
+static void nth_element_k(int tab[], int n) {
+    NthElement(tab, n, selection_k - 1);
+}
+
+/**
+ * @brief Tri partiel avec la signature (tableau, taille).
+ */
+static void partial_sort_k(int tab[], int n) {
+    PartialSort(tab, n, selection_k);
+}
+
+/**
+ * @brief k plus petits éléments en place avec la signature (tableau, taille).
+ */
+static void top_k_k(int tab[], int n) {
+    TopK(tab, n, selection_k);
+}
+
+/**
+ * @brief k plus petits éléments par flux : le tableau est lu par blocs, le résultat écrit en tête.
+ */
+static void top_k_stream_k(int tab[], int n) {
+    TopKStream stream;
+    if (TopKStreamInit(&stream, selection_k) != 0) return;
+    for (int i = 0; i < n; i += SELECTION_STREAM_BLOCK) {
+        TopKStreamPush(&stream, tab + i, n - i < SELECTION_STREAM_BLOCK ? n - i : SELECTION_STREAM_BLOCK);
+    }
+    TopKStreamResult(&stream, tab);
+    TopKStreamFree(&stream);
+}
+
+/**
+ * @brief Temps médian d'une fonction (en secondes), ou -1 en cas d'échec.
+ */
+static double median_time(SortFunction sort, const int tab[], int n, const RunnerOptions *options) {
+    RunnerResult result;
+    if (RunnerMeasure(sort, tab, n, options, &result) != 0) return -1.0;
+    return result.time.median;
+}
+
+/**
+ * @brief Mesure les primitives de sélection pour k / n de 0,1 % à 100 % et les compare au tri complet
+ * le plus rapide (parmi les tris non quadratiques).
+ *
+ * @param tab L'échantillon de départ (non modifié).
+ * @param n Le nombre d'éléments.
+ * @param options Les options du lanceur (NULL : options par défaut).
+ */
+void RunSelectionBenchmark(const int tab[], int n, const RunnerOptions *options) {
+    static const double fractions[] = { 0.001, 0.01, 0.1, 0.5, 1.0 };
+    static const SortFunction primitives[] = { nth_element_k, partial_sort_k, top_k_k, top_k_stream_k };
+    if (n <= 0) return;
+
+    RunnerOptions defaults;
+    if (options == NULL) {
+        RunnerDefaults(&defaults);
+        options = &defaults;
+    }
+
+    const char *fullName = NULL;
+    double fullTime = -1.0;
+    for (int a = 0; a < SortAlgorithmCount(); a++) {
+        const SortAlgorithm *algo = SortGetAlgorithm(a);
+        if (algo->cost == SORT_COST_QUADRATIC) continue;
+        double t = median_time(algo->sort, tab, n, options);
+        if (t > 0 && (fullTime < 0 || t < fullTime)) {
+            fullTime = t;
+            fullName = algo->name;
+        }
+    }
+
+    // The primitives only order part of the array (TopKStream even overwrites it): no verification.
+    RunnerOptions unverified = *options;
+    unverified.verify = 0;
+
+    printf("\n=== Selection benchmark (n = %d, full sort: %s %.3f ms) ===\n",
+           n, fullName ? fullName : "-", fullTime * 1e3);
+    printf("%10s %8s %12s %12s %12s %12s %10s\n",
+           "k", "k/n", "NthElement", "PartialSort", "TopK", "TopKStream", "speedup");
+
+    int previous = 0;
+    for (size_t f = 0; f < sizeof(fractions) / sizeof(fractions[0]); f++) {
+        int k = (int)(fractions[f] * n + 0.5);
+        if (k < 1) k = 1;
+        if (k > n) k = n;
+        if (k == previous) continue;
+        previous = k;
+        selection_k = k;
+
+        printf("%10d %7.1f%%", k, 100.0 * k / n);
+        double partial = -1.0;
+        for (size_t p = 0; p < sizeof(primitives) / sizeof(primitives[0]); p++) {
+            double t = median_time(primitives[p], tab, n, &unverified);
+            if (primitives[p] == partial_sort_k) partial = t;
+            printf(" %12.3f", t * 1e3);
+            fflush(stdout);
+        }
+        // Gain of the ordered selection (PartialSort) over sorting everything.
+        if (partial > 0 && fullTime > 0) printf(" %9.1fx\n", fullTime / partial);
+        else printf(" %10s\n", "-");
+    }
+    printf("(median ms)\n");
+}
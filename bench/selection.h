@@ -0,0 +1,17 @@
+/**
+ * @file bench/selection.h
+ * @brief Mesure des primitives de sélection (k-ième élément, tri partiel, k plus petits) selon k / n.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef SELECTION_BENCH_H
+#define SELECTION_BENCH_H
+
+struct RunnerOptions;
+
+// Time NthElement, PartialSort, TopK and TopKStream for k/n from 0.1% to 100%
+// against the fastest full sort; tab is left untouched, options NULL uses RunnerDefaults.
+void RunSelectionBenchmark(const int tab[], int n, const struct RunnerOptions *options);
+
+#endif // SELECTION_BENCH_H
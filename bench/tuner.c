@@ -0,0 +1,265 @@
+#include "tuner.h"
+#include "bench.h"
+#include "runner.h"
+#include "../sorting/tuning.h"
+#include "../utils/threadpool.h"
+#include "../utils/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @file tuner.c
+ * @brief Réglage automatique des paramètres des tris.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Chaque paramètre est cherché à son tour, les autres restant fixés : d'abord une grille grossière, puis les
+ * voisins de la meilleure valeur. Une valeur vaut le temps médian du lanceur sur une entrée fixe (graine 1).
+ */
+
+#define TUNER_CUTOFF_SIZE 100000
+#define TUNER_RADIX_SIZE (1 << 20)
+#define TUNER_PARALLEL_SIZE (1 << 21)
+#define TUNER_MAX_CANDIDATES 16
+
+/**
+ * @brief Paramètres réglés, dans l'ordre de la recherche.
+ */
+typedef enum TunerStage {
+    TUNE_CUTOFF,
+    TUNE_RADIX,
+    TUNE_THREADS,
+    TUNE_GRAIN
+} TunerStage;
+
+/**
+ * @brief Champ de SortTuning correspondant à une étape.
+ */
+static int *stage_field(SortTuning *t, TunerStage stage) {
+    switch (stage) {
+        case TUNE_CUTOFF: return &t->insertionCutoff;
+        case TUNE_RADIX: return &t->radixBits;
+        case TUNE_THREADS: return &t->threads;
+        default: return &t->parallelGrain;
+    }
+}
+
+/**
+ * @brief Tri rapide avec la signature (tableau, taille).
+ */
+static void quick_sort_n(int tab[], int n) {
+    QuickSort(tab, 0, n - 1);
+}
+
+/**
+ * @brief Tri par fusion avec la signature (tableau, taille).
+ */
+static void merge_sort_n(int tab[], int n) {
+    MergeSort(tab, 0, n - 1);
+}
+
+/**
+ * @brief Temps médian d'un tri (en secondes), ou -1 en cas d'échec. Les tris parallèles sont mesurés sans
+ * épingler le thread, sans quoi les threads de la réserve hériteraient d'un seul processeur.
+ */
+static double median_time(SortFunction sort, const int snapshot[], int n, int parallel) {
+    RunnerOptions runner;
+    RunnerDefaults(&runner);
+    runner.warmup = 1;
+    runner.minReps = 5;
+    runner.maxReps = 15;
+    runner.targetRelCI = 0.02;
+    runner.maxSeconds = 1.0;
+    if (parallel) runner.cpu = RUNNER_NO_PIN;
+
+    RunnerResult result;
+    if (RunnerMeasure(sort, snapshot, n, &runner, &result) != 0) return -1.0;
+    return result.time.median;
+}
+
+/**
+ * @brief Mesure une valeur candidate : le seuil d'insertion sur le tri rapide et le tri par fusion, la
+ * largeur de chiffre sur le tri par base, le parallélisme sur le tri par fusion parallèle et le tri rapide
+ * parallèle, qui partagent les mêmes threads et le même grain.
+ */
+static double evaluate(TunerStage stage, const SortTuning *candidate, const int snapshot[], int n) {
+    SetTuning(candidate);
+    if (stage == TUNE_CUTOFF) {
+        double quick = median_time(quick_sort_n, snapshot, n, 0);
+        double merge = median_time(merge_sort_n, snapshot, n, 0);
+        return quick < 0 || merge < 0 ? -1.0 : quick + merge;
+    }
+    if (stage == TUNE_RADIX) return median_time(RadixSort, snapshot, n, 0);
+    double merge = median_time(ParallelSort, snapshot, n, 1);
+    double quick = median_time(ParallelQuickSort, snapshot, n, 1);
+    return merge < 0 || quick < 0 ? -1.0 : merge + quick;
+}
+
+/**
+ * @brief Essaie les valeurs candidates (croissantes) d'un paramètre et garde la meilleure dans best.
+ *
+ * @param tolerance Écart relatif toléré : la plus petite valeur à moins de tolerance du meilleur temps
+ * l'emporte (0 : le meilleur temps).
+ * @return 0 en cas de succès, -1 si aucune mesure n'a abouti.
+ */
+static int search(TunerStage stage, SortTuning *best, const int candidates[], int nb,
+                  const int snapshot[], int n, double tolerance) {
+    double times[TUNER_MAX_CANDIDATES];
+    double fastest = -1.0;
+    for (int c = 0; c < nb; c++) {
+        SortTuning candidate = *best;
+        *stage_field(&candidate, stage) = candidates[c];
+        times[c] = evaluate(stage, &candidate, snapshot, n);
+        printf("  %9d  %10.3f ms\n", candidates[c], times[c] * 1e3);
+        fflush(stdout);
+        if (times[c] >= 0 && (fastest < 0 || times[c] < fastest)) fastest = times[c];
+    }
+    if (fastest < 0) return -1;
+
+    for (int c = 0; c < nb; c++) {
+        if (times[c] >= 0 && times[c] <= fastest * (1.0 + tolerance)) {
+            *stage_field(best, stage) = candidates[c];
+            break;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Indique si une valeur figure dans une liste.
+ */
+static int contains(const int list[], int nb, int value) {
+    for (int i = 0; i < nb; i++) {
+        if (list[i] == value) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Ajoute une valeur à une liste croissante, si elle est dans [min, max] et n'y figure pas déjà.
+ */
+static void add_candidate(int candidates[], int *nb, int value, int min, int max) {
+    if (value < min || value > max || *nb >= TUNER_MAX_CANDIDATES || contains(candidates, *nb, value)) return;
+    int i = *nb;
+    while (i > 0 && candidates[i - 1] > value) {
+        candidates[i] = candidates[i - 1];
+        i--;
+    }
+    candidates[i] = value;
+    (*nb)++;
+}
+
+/**
+ * @brief Recherche grossière puis fine d'un paramètre.
+ *
+ * @param coarse Grille grossière (croissante).
+ * @param step Écart des voisins essayés autour de la meilleure valeur : additif si positif, facteur 2 sinon.
+ */
+static int tune_stage(TunerStage stage, const char *title, SortTuning *best, const int coarse[], int nbCoarse,
+                      int step, int min, int max, const int snapshot[], int n, double tolerance) {
+    printf("\n%s (n = %d)\n", title, n);
+    if (search(stage, best, coarse, nbCoarse, snapshot, n, tolerance) != 0) return -1;
+
+    // Neighbours of the best value that the coarse grid did not measure.
+    int value = *stage_field(best, stage);
+    int lower = step > 0 ? value - step : value / 2;
+    int upper = step > 0 ? value + step : value * 2;
+    int fine[TUNER_MAX_CANDIDATES];
+    int nbFine = 0;
+    add_candidate(fine, &nbFine, value, min, max);
+    if (!contains(coarse, nbCoarse, lower)) add_candidate(fine, &nbFine, lower, min, max);
+    if (!contains(coarse, nbCoarse, upper)) add_candidate(fine, &nbFine, upper, min, max);
+    if (nbFine > 1 && search(stage, best, fine, nbFine, snapshot, n, tolerance) != 0) return -1;
+
+    printf("  -> %d\n", *stage_field(best, stage));
+    return 0;
+}
+
+/**
+ * @brief Remplit une entrée aléatoire sur 32 bits (graine fixe), pour que le tri par base parcoure tous
+ * ses chiffres.
+ */
+static void fill_wide(int tab[], int n) {
+    srand(1);
+    for (int i = 0; i < n; i++) {
+        tab[i] = (int)(((unsigned int)rand() << 16) ^ (unsigned int)rand() ^ ((unsigned int)rand() << 31));
+    }
+}
+
+/**
+ * @brief Cherche les paramètres les plus rapides pour cette machine, les applique et les enregistre.
+ *
+ * Seuil d'insertion (tri rapide + tri par fusion, 100 000 éléments), largeur de chiffre (tri par base sur
+ * des clés de 32 bits, 2^20 éléments), puis nombre de threads et taille des blocs du tri parallèle
+ * (2^21 éléments). Pour les threads, le plus petit nombre à moins de 3 % du meilleur temps est retenu.
+ *
+ * @param path Le fichier de profil (NULL : les paramètres sont seulement appliqués).
+ * @return 0 en cas de succès, -1 en cas d'échec (les paramètres précédents sont rétablis).
+ */
+int RunAutoTune(const char *path) {
+    SortTuning previous = *GetTuning();
+    SortTuning best = previous;
+
+    int *snapshot = (int*)malloc(TUNER_PARALLEL_SIZE * sizeof(int));
+    if (snapshot == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+
+    printf("\n=== Auto-tuning (%d CPUs) ===\n", GetCpuCount());
+    int status = 0;
+
+    srand(1);
+    FillSample(snapshot, TUNER_CUTOFF_SIZE, 1);
+    static const int cutoffs[] = { 0, 4, 8, 16, 32, 64 };
+    status = tune_stage(TUNE_CUTOFF, "Insertion cutoff", &best, cutoffs, 6, 4, 0, 256,
+                        snapshot, TUNER_CUTOFF_SIZE, 0.0);
+
+    if (status == 0) {
+        fill_wide(snapshot, TUNER_RADIX_SIZE);
+        static const int bits[] = { 4, 6, 8, 11, 16 };
+        status = tune_stage(TUNE_RADIX, "Radix digit bits", &best, bits, 5, 1, 1, 16,
+                            snapshot, TUNER_RADIX_SIZE, 0.0);
+    }
+
+    if (status == 0) {
+        srand(1);
+        FillSample(snapshot, TUNER_PARALLEL_SIZE, 1);
+
+        int cpus = GetCpuCount();
+        int threads[TUNER_MAX_CANDIDATES];
+        int nbThreads = 0;
+        for (int t = 1; t < cpus && nbThreads < TUNER_MAX_CANDIDATES - 1; t *= 2) threads[nbThreads++] = t;
+        threads[nbThreads++] = cpus;
+
+        // Threads are searched with a grain small enough for every worker to get blocks.
+        best.parallelGrain = 1 << 14;
+        printf("\nParallel threads (n = %d)\n", TUNER_PARALLEL_SIZE);
+        status = search(TUNE_THREADS, &best, threads, nbThreads, snapshot, TUNER_PARALLEL_SIZE, 0.03);
+        if (status == 0) printf("  -> %d\n", best.threads);
+    }
+
+    if (status == 0 && best.threads == 1) {
+        // The parallel sorts stay sequential: the grain has no effect.
+        best.parallelGrain = previous.parallelGrain;
+    } else if (status == 0) {
+        static const int grains[] = { 1 << 12, 1 << 14, 1 << 16, 1 << 18, 1 << 20 };
+        status = tune_stage(TUNE_GRAIN, "Parallel grain", &best, grains, 5, 0, 1 << 10, TUNER_PARALLEL_SIZE / 2,
+                            snapshot, TUNER_PARALLEL_SIZE, 0.0);
+    }
+    free(snapshot);
+
+    if (status != 0) {
+        fprintf(stderr, "Auto-tuning failed, keeping the previous parameters\n");
+        SetTuning(&previous);
+        return -1;
+    }
+
+    SetTuning(&best);
+    printf("\nTuned: insertion_cutoff=%d radix_bits=%d threads=%d parallel_grain=%d\n",
+           best.insertionCutoff, best.radixBits, best.threads, best.parallelGrain);
+    if (path == NULL) return 0;
+    if (TuningSave(path, &best) != 0) return -1;
+    printf("Profile written to %s\n", path);
+    return 0;
+}
@@ -0,0 +1,15 @@
+/**
+ * @file bench/tuner.h
+ * @brief Réglage automatique des paramètres des tris (seuil d'insertion, largeur de chiffre, parallélisme).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef TUNER_H
+#define TUNER_H
+
+// Search the insertion cutoff, radix digit width, thread count and parallel grain that are fastest on this
+// machine, apply them and write the profile to path (NULL: apply only). Returns 0 or -1.
+int RunAutoTune(const char *path);
+
+#endif // TUNER_H
@@ -0,0 +1,396 @@
+#include "export.h"
+#include "png.h"
+#include "../sorting/events.h"
+#include "../stats/stats.h"
+#include "../visual/raster.h"
+#include "../utils/threadpool.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file export.c
+ * @brief Export sans affichage d'une animation de tri.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Le tri s'exécute dans le thread appelant. Toutes les `stepsPerFrame` étapes, le tableau est copié dans
+ * un emplacement libre d'un anneau d'images, puis rendu et encodé par la réserve de threads. Le thread
+ * du tri écrit les images terminées dans l'ordre et n'attend que lorsque l'anneau est plein : l'encodage
+ * suit le tri en pipeline au lieu de le ralentir au rythme de l'affichage.
+ */
+
+/**
+ * @brief Nombre d'emplacements d'image par thread d'encodage.
+ */
+#define EXPORT_SLOTS_PER_THREAD 2
+
+/**
+ * @brief Durée par défaut de l'animation (en secondes) lorsque stepsPerFrame n'est pas fixé.
+ */
+#define EXPORT_DEFAULT_SECONDS 10
+
+enum { FRAME_FREE, FRAME_PENDING, FRAME_DONE };
+
+struct ExportContext;
+
+/**
+ * @brief Emplacement de l'anneau d'images : copie du tableau, image rendue et image encodée.
+ */
+typedef struct ExportFrame {
+    struct ExportContext *ctx;
+    long index;
+    int *snapshot;
+    int a;
+    int b;
+    uint32_t *pixels;
+    unsigned char *out;
+    size_t outLen;
+    int failed;
+    int state;
+} ExportFrame;
+
+/**
+ * @brief État d'un export en cours.
+ */
+typedef struct ExportContext {
+    const ExportSettings *settings;
+    int width;
+    int height;
+    int nbValue;
+    int maxvalue;
+
+    ExportFrame *frames;
+    int nbSlots;
+    long nextFrame;
+    long nextWrite;
+
+    long stepsPerFrame;
+    long step;
+
+    FILE *stream;
+    ThreadPool *pool;
+    pthread_mutex_t lock;
+    pthread_cond_t frameDone;
+    int failed;
+} ExportContext;
+
+/**
+ * @brief Export en cours sur ce thread, utilisé par export_callback (le callback de visualisation n'a pas de paramètre utilisateur).
+ */
+static _Thread_local ExportContext *export_ctx = NULL;
+
+/**
+ * @brief Comptage des étapes par lots d'événements, utilisé pour calibrer le nombre d'étapes par image.
+ */
+static void count_sink(const int arr[], int n, const SortEvent events[], int count, void *user) {
+    (void)arr; (void)n;
+    long *steps = (long*)user;
+    for (int i = 0; i < count; i++) *steps += SortEventSteps(&events[i]);
+}
+
+/**
+ * @brief Octet borné à [0, 255].
+ */
+static unsigned char clamp_byte(int value) {
+    return (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+/**
+ * @brief Convertit une image ARGB en YUV 4:2:0 (plage complète, coefficients JPEG).
+ *
+ * @param frame L'image à convertir ; le résultat est écrit dans frame->out.
+ * @param width Largeur (paire).
+ * @param height Hauteur (paire).
+ */
+static void encode_y4m(ExportFrame *frame, int width, int height) {
+    unsigned char *y = frame->out;
+    unsigned char *u = y + (size_t)width * height;
+    unsigned char *v = u + (size_t)(width / 2) * (height / 2);
+    const uint32_t *px = frame->pixels;
+
+    for (int i = 0; i < width * height; i++) {
+        int r = (px[i] >> 16) & 0xFF, g = (px[i] >> 8) & 0xFF, b = px[i] & 0xFF;
+        y[i] = clamp_byte((77 * r + 150 * g + 29 * b + 128) >> 8);
+    }
+
+    for (int cy = 0; cy < height / 2; cy++) {
+        for (int cx = 0; cx < width / 2; cx++) {
+            int r = 0, g = 0, b = 0;
+            for (int dy = 0; dy < 2; dy++) {
+                for (int dx = 0; dx < 2; dx++) {
+                    uint32_t p = px[(2 * cy + dy) * width + 2 * cx + dx];
+                    r += (p >> 16) & 0xFF;
+                    g += (p >> 8) & 0xFF;
+                    b += p & 0xFF;
+                }
+            }
+            r /= 4; g /= 4; b /= 4;
+            u[cy * (width / 2) + cx] = clamp_byte((-43 * r - 85 * g + 128 * b + 32768) >> 8);
+            v[cy * (width / 2) + cx] = clamp_byte((128 * r - 107 * g - 21 * b + 32768) >> 8);
+        }
+    }
+    frame->outLen = (size_t)width * height * 3 / 2;
+}
+
+/**
+ * @brief Tâche de la réserve : rend et encode une image.
+ *
+ * @param arg L'emplacement d'image.
+ */
+static void frame_task(void *arg) {
+    ExportFrame *frame = (ExportFrame*)arg;
+    ExportContext *ctx = frame->ctx;
+
+    RasterizeArray(frame->pixels, ctx->width, ctx->height, ctx->width,
+                   frame->snapshot, ctx->nbValue, ctx->maxvalue, frame->a, frame->b);
+
+    frame->failed = 0;
+    if (ctx->settings->format == EXPORT_Y4M) {
+        encode_y4m(frame, ctx->width, ctx->height);
+    } else if (PngEncode(frame->pixels, ctx->width, ctx->height, ctx->width, &frame->out, &frame->outLen) != 0) {
+        frame->failed = 1;
+    }
+
+    pthread_mutex_lock(&ctx->lock);
+    frame->state = FRAME_DONE;
+    pthread_cond_broadcast(&ctx->frameDone);
+    pthread_mutex_unlock(&ctx->lock);
+}
+
+/**
+ * @brief Écrit une image encodée dans le flux Y4M ou dans son propre fichier PNG.
+ */
+static void write_frame(ExportContext *ctx, ExportFrame *frame) {
+    if (frame->failed) {
+        ctx->failed = 1;
+        return;
+    }
+
+    if (ctx->settings->format == EXPORT_Y4M) {
+        if (fputs("FRAME\n", ctx->stream) == EOF ||
+            fwrite(frame->out, 1, frame->outLen, ctx->stream) != frame->outLen) {
+            ctx->failed = 1;
+        }
+        return;
+    }
+
+    // PNG sequence: "<path without .png>_<index>.png"
+    const char *path = ctx->settings->path;
+    size_t len = strlen(path);
+    if (len >= 4 && strcmp(path + len - 4, ".png") == 0) len -= 4;
+
+    char name[1024];
+    snprintf(name, sizeof(name), "%.*s_%06ld.png", (int)len, path, frame->index);
+    FILE *file = fopen(name, "wb");
+    if (file == NULL || fwrite(frame->out, 1, frame->outLen, file) != frame->outLen) {
+        fprintf(stderr, "Cannot write %s\n", name);
+        ctx->failed = 1;
+    }
+    if (file) fclose(file);
+    free(frame->out);
+    frame->out = NULL;
+}
+
+/**
+ * @brief Écrit la prochaine image dans l'ordre, en attendant la fin de son encodage si nécessaire.
+ */
+static void write_next(ExportContext *ctx) {
+    ExportFrame *frame = &ctx->frames[ctx->nextWrite % ctx->nbSlots];
+
+    pthread_mutex_lock(&ctx->lock);
+    while (frame->state != FRAME_DONE) {
+        pthread_cond_wait(&ctx->frameDone, &ctx->lock);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+
+    write_frame(ctx, frame);
+
+    pthread_mutex_lock(&ctx->lock);
+    frame->state = FRAME_FREE;
+    pthread_mutex_unlock(&ctx->lock);
+    ctx->nextWrite++;
+}
+
+/**
+ * @brief Indique si la prochaine image à écrire est déjà encodée.
+ */
+static int next_is_done(ExportContext *ctx) {
+    pthread_mutex_lock(&ctx->lock);
+    int done = ctx->frames[ctx->nextWrite % ctx->nbSlots].state == FRAME_DONE;
+    pthread_mutex_unlock(&ctx->lock);
+    return done;
+}
+
+/**
+ * @brief Copie l'état courant du tableau dans un emplacement libre et soumet son encodage.
+ */
+static void emit_frame(ExportContext *ctx, const int tab[], int a, int b) {
+    // Write whatever is ready; block only when the ring is full.
+    while (ctx->nextWrite < ctx->nextFrame && next_is_done(ctx)) {
+        write_next(ctx);
+    }
+    while (ctx->nextWrite <= ctx->nextFrame - ctx->nbSlots) {
+        write_next(ctx);
+    }
+
+    ExportFrame *frame = &ctx->frames[ctx->nextFrame % ctx->nbSlots];
+    memcpy(frame->snapshot, tab, ctx->nbValue * sizeof(int));
+    frame->a = a;
+    frame->b = b;
+    frame->index = ctx->nextFrame;
+    frame->state = FRAME_PENDING;
+    ctx->nextFrame++;
+
+    if (ThreadPoolSubmit(ctx->pool, frame_task, frame) != 0) {
+        frame_task(frame);
+    }
+}
+
+/**
+ * @brief Callback de visualisation de l'export : une image toutes les stepsPerFrame étapes.
+ */
+static void export_callback(int arr[], int n, int a, int b) {
+    (void)n;
+    ExportContext *ctx = export_ctx;
+    ctx->step++;
+    if (ctx->step % ctx->stepsPerFrame == 0) {
+        emit_frame(ctx, arr, a, b);
+    }
+}
+
+/**
+ * @brief Libère les emplacements d'image.
+ */
+static void free_frames(ExportContext *ctx) {
+    if (ctx->frames == NULL) return;
+    for (int i = 0; i < ctx->nbSlots; i++) {
+        free(ctx->frames[i].snapshot);
+        free(ctx->frames[i].pixels);
+        free(ctx->frames[i].out);
+    }
+    free(ctx->frames);
+    ctx->frames = NULL;
+}
+
+/**
+ * @brief Exécute le tri instrumenté et écrit son animation sans ouvrir de fenêtre.
+ *
+ * @param tab Le tableau à trier.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ * @param sortWithCb Pointeur vers la fonction de tri instrumentée à utiliser.
+ * @param settings Format, chemin, dimensions et cadence de l'export.
+ * @return Le nombre d'images écrites, ou -1 en cas d'erreur.
+ */
+long ExportSort(int tab[], int nbValue, void (*sortWithCb)(int[], int, VizCallback),
+                const ExportSettings *settings) {
+    if (nbValue <= 0 || !sortWithCb || !settings || !settings->path || settings->format == EXPORT_NONE) {
+        return -1;
+    }
+
+    ExportContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.settings = settings;
+    ctx.nbValue = nbValue;
+    ctx.maxvalue = RasterMaxValue(tab, nbValue); // sorting only permutes the values
+    // 4:2:0 chroma needs even dimensions.
+    ctx.width = settings->width & ~1;
+    ctx.height = settings->height & ~1;
+    int fps = settings->fps > 0 ? settings->fps : 30;
+    if (ctx.width < 2 || ctx.height < 2) {
+        fprintf(stderr, "Invalid export size %dx%d\n", settings->width, settings->height);
+        return -1;
+    }
+
+    ctx.stepsPerFrame = settings->stepsPerFrame;
+    if (ctx.stepsPerFrame <= 0) {
+        // Dry run on a copy to size the animation; only the real run below is counted.
+        int *copy = (int*)malloc(nbValue * sizeof(int));
+        if (copy == NULL) {
+            fprintf(stderr, "Memory allocation failed\n");
+            return -1;
+        }
+        memcpy(copy, tab, nbValue * sizeof(int));
+        SortCounters saved = StatsGetCounters();
+        long counted_steps = 0;
+        SortRunEvents(sortWithCb, copy, nbValue, count_sink, &counted_steps);
+        StatsSetCounters(saved);
+        free(copy);
+
+        long seconds = settings->seconds > 0 ? settings->seconds : EXPORT_DEFAULT_SECONDS;
+        long target = (long)fps * seconds;
+        ctx.stepsPerFrame = (counted_steps + target - 1) / target;
+        if (ctx.stepsPerFrame < 1) ctx.stepsPerFrame = 1;
+    }
+
+    ctx.pool = ThreadPoolCreate(settings->nbThreads);
+    if (ctx.pool == NULL) return -1;
+
+    ctx.nbSlots = EXPORT_SLOTS_PER_THREAD * ThreadPoolSize(ctx.pool) + 1;
+    ctx.frames = (ExportFrame*)calloc(ctx.nbSlots, sizeof(ExportFrame));
+    if (ctx.frames == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        ThreadPoolDestroy(ctx.pool);
+        return -1;
+    }
+    for (int i = 0; i < ctx.nbSlots; i++) {
+        ExportFrame *frame = &ctx.frames[i];
+        frame->ctx = &ctx;
+        frame->snapshot = (int*)malloc(nbValue * sizeof(int));
+        frame->pixels = (uint32_t*)malloc((size_t)ctx.width * ctx.height * sizeof(uint32_t));
+        if (settings->format == EXPORT_Y4M) {
+            frame->out = (unsigned char*)malloc((size_t)ctx.width * ctx.height * 3 / 2);
+        }
+        if (!frame->snapshot || !frame->pixels || (settings->format == EXPORT_Y4M && !frame->out)) {
+            fprintf(stderr, "Memory allocation failed\n");
+            free_frames(&ctx);
+            ThreadPoolDestroy(ctx.pool);
+            return -1;
+        }
+    }
+
+    if (settings->format == EXPORT_Y4M) {
+        ctx.stream = fopen(settings->path, "wb");
+        if (ctx.stream == NULL) {
+            fprintf(stderr, "Cannot open %s\n", settings->path);
+            free_frames(&ctx);
+            ThreadPoolDestroy(ctx.pool);
+            return -1;
+        }
+        // C420jpeg only places the chroma samples: the range is declared separately, since readers default
+        // to the limited one.
+        fprintf(ctx.stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n",
+                ctx.width, ctx.height, fps);
+    }
+
+    pthread_mutex_init(&ctx.lock, NULL);
+    pthread_cond_init(&ctx.frameDone, NULL);
+
+    emit_frame(&ctx, tab, -1, -1);
+    export_ctx = &ctx;
+    sortWithCb(tab, nbValue, export_callback);
+    export_ctx = NULL;
+    if (ctx.step % ctx.stepsPerFrame != 0) {
+        emit_frame(&ctx, tab, -1, -1);
+    }
+
+    while (ctx.nextWrite < ctx.nextFrame) {
+        write_next(&ctx);
+    }
+
+    ThreadPoolDestroy(ctx.pool);
+    pthread_mutex_destroy(&ctx.lock);
+    pthread_cond_destroy(&ctx.frameDone);
+    if (ctx.stream && fclose(ctx.stream) != 0) ctx.failed = 1;
+    free_frames(&ctx);
+
+    if (ctx.failed) {
+        fprintf(stderr, "Export to %s failed\n", settings->path);
+        return -1;
+    }
+    printf("Exported %ld frames (%ld steps, %ld steps/frame) to %s\n",
+           ctx.nextFrame, ctx.step, ctx.stepsPerFrame, settings->path);
+    return ctx.nextFrame;
+}
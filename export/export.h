@@ -0,0 +1,36 @@
+/**
+ * @file export/export.h
+ * @brief Export sans affichage d'une animation de tri en flux Y4M ou en suite d'images PNG.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include "../sorting/sorting.h"
+
+typedef enum ExportFormat {
+    EXPORT_NONE = 0,  // render in the SDL window
+    EXPORT_Y4M = 1,   // single YUV4MPEG2 (4:2:0) stream
+    EXPORT_PNG = 2    // one PNG per frame: <path>_000000.png, ...
+} ExportFormat;
+
+typedef struct ExportSettings {
+    ExportFormat format;
+    const char *path;
+    int width;
+    int height;
+    int fps;
+    long stepsPerFrame;  // <= 0: chosen so that the animation lasts `seconds`
+    int seconds;
+    int nbThreads;       // <= 0: one per CPU
+} ExportSettings;
+
+// Run the instrumented sort and write its animation without opening a window.
+// Frames are rasterized and encoded on a thread pool while the sort runs.
+// Returns the number of frames written, or -1 on error.
+long ExportSort(int tab[], int nbValue, void (*sortWithCb)(int[], int, VizCallback),
+                const ExportSettings *settings);
+
+#endif // EXPORT_H
@@ -0,0 +1,265 @@
+#include "png.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file png.c
+ * @brief Encodeur PNG minimal.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Chaque ligne utilise le filtre « Up » (différence avec la ligne précédente) : les images de barres
+ * deviennent presque entièrement nulles, et le flux deflate se réduit à des répétitions à distance 1
+ * codées avec les tables de Huffman fixes. Pas besoin de zlib.
+ */
+
+/**
+ * @brief Tampon d'octets extensible avec écriture bit à bit (ordre deflate : bits de poids faible d'abord).
+ */
+typedef struct ByteBuffer {
+    unsigned char *data;
+    size_t len;
+    size_t cap;
+    uint32_t bits;
+    int nbBits;
+    int failed;
+} ByteBuffer;
+
+/**
+ * @brief Ajoute un octet au tampon.
+ */
+static void put_byte(ByteBuffer *buf, unsigned char byte) {
+    if (buf->failed) return;
+    if (buf->len == buf->cap) {
+        size_t cap = buf->cap ? buf->cap * 2 : 4096;
+        unsigned char *tmp = realloc(buf->data, cap);
+        if (tmp == NULL) {
+            buf->failed = 1;
+            return;
+        }
+        buf->data = tmp;
+        buf->cap = cap;
+    }
+    buf->data[buf->len++] = byte;
+}
+
+/**
+ * @brief Ajoute un entier 32 bits gros-boutiste.
+ */
+static void put_u32(ByteBuffer *buf, uint32_t value) {
+    put_byte(buf, (unsigned char)(value >> 24));
+    put_byte(buf, (unsigned char)(value >> 16));
+    put_byte(buf, (unsigned char)(value >> 8));
+    put_byte(buf, (unsigned char)value);
+}
+
+/**
+ * @brief Ajoute `count` bits de `value`, bit de poids faible en premier.
+ */
+static void put_bits(ByteBuffer *buf, uint32_t value, int count) {
+    buf->bits |= value << buf->nbBits;
+    buf->nbBits += count;
+    while (buf->nbBits >= 8) {
+        put_byte(buf, (unsigned char)buf->bits);
+        buf->bits >>= 8;
+        buf->nbBits -= 8;
+    }
+}
+
+/**
+ * @brief Ajoute un code de Huffman (écrit bit de poids fort en premier).
+ */
+static void put_code(ByteBuffer *buf, uint32_t code, int length) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < length; i++) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    put_bits(buf, reversed, length);
+}
+
+/**
+ * @brief Ajoute un symbole littéral/longueur avec la table de Huffman fixe.
+ */
+static void put_symbol(ByteBuffer *buf, int symbol) {
+    if (symbol < 144)      put_code(buf, 0x30 + symbol, 8);
+    else if (symbol < 256) put_code(buf, 0x190 + (symbol - 144), 9);
+    else if (symbol < 280) put_code(buf, symbol - 256, 7);
+    else                   put_code(buf, 0xC0 + (symbol - 280), 8);
+}
+
+static const int length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const int length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+/**
+ * @brief Ajoute une répétition de `length` octets (3..258) à distance 1.
+ */
+static void put_run(ByteBuffer *buf, int length) {
+    int code = 28;
+    while (length_base[code] > length) code--;
+    put_symbol(buf, 257 + code);
+    if (length_extra[code] > 0) put_bits(buf, length - length_base[code], length_extra[code]);
+    put_code(buf, 0, 5); // distance code 0 = distance 1
+}
+
+/**
+ * @brief Compresse les données filtrées dans un flux zlib (un seul bloc deflate à codes fixes).
+ */
+static void put_zlib(ByteBuffer *buf, const unsigned char *data, size_t len) {
+    put_byte(buf, 0x78);
+    put_byte(buf, 0x01);
+
+    put_bits(buf, 1, 1); // BFINAL
+    put_bits(buf, 1, 2); // BTYPE = fixed Huffman
+
+    size_t i = 0;
+    while (i < len) {
+        size_t run = 0;
+        if (i > 0) {
+            while (i + run < len && run < 258 && data[i + run] == data[i - 1]) run++;
+        }
+        if (run >= 3) {
+            put_run(buf, (int)run);
+            i += run;
+        } else {
+            put_symbol(buf, data[i]);
+            i++;
+        }
+    }
+    put_symbol(buf, 256);
+    if (buf->nbBits > 0) put_bits(buf, 0, 8 - buf->nbBits);
+
+    uint32_t s1 = 1, s2 = 0;
+    for (size_t k = 0; k < len; k++) {
+        s1 = (s1 + data[k]) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+    put_u32(buf, (s2 << 16) | s1);
+}
+
+/**
+ * @brief Table du CRC-32, initialisée une seule fois (les images sont encodées en parallèle).
+ */
+static uint32_t crc_table[256];
+static pthread_once_t crc_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Remplit la table du CRC-32 (polynôme PNG).
+ */
+static void init_crc_table(void) {
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crc_table[n] = c;
+    }
+}
+
+/**
+ * @brief CRC-32 d'une suite d'octets.
+ */
+static uint32_t crc32_update(uint32_t crc, const unsigned char *data, size_t len) {
+    pthread_once(&crc_once, init_crc_table);
+    for (size_t i = 0; i < len; i++) {
+        crc = crc_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+/**
+ * @brief Termine un bloc PNG commencé à `start` (champ longueur déjà réservé) en ajoutant son CRC.
+ */
+static void end_chunk(ByteBuffer *buf, size_t start) {
+    if (buf->failed) return;
+    uint32_t length = (uint32_t)(buf->len - start - 8);
+    buf->data[start] = (unsigned char)(length >> 24);
+    buf->data[start + 1] = (unsigned char)(length >> 16);
+    buf->data[start + 2] = (unsigned char)(length >> 8);
+    buf->data[start + 3] = (unsigned char)length;
+    uint32_t crc = crc32_update(0xFFFFFFFFu, buf->data + start + 4, buf->len - start - 4) ^ 0xFFFFFFFFu;
+    put_u32(buf, crc);
+}
+
+/**
+ * @brief Commence un bloc PNG : longueur (remplie par end_chunk) puis type.
+ */
+static size_t begin_chunk(ByteBuffer *buf, const char type[4]) {
+    size_t start = buf->len;
+    put_u32(buf, 0);
+    for (int i = 0; i < 4; i++) put_byte(buf, (unsigned char)type[i]);
+    return start;
+}
+
+/**
+ * @brief Encode une image ARGB en PNG RGB.
+ *
+ * @param pixels Le tampon de pixels (0xAARRGGBB).
+ * @param width Largeur de l'image.
+ * @param height Hauteur de l'image.
+ * @param pitch Nombre de pixels entre deux lignes du tampon.
+ * @param out Tampon résultat, alloué par la fonction.
+ * @param outLen Taille du tampon résultat.
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+int PngEncode(const uint32_t *pixels, int width, int height, int pitch,
+              unsigned char **out, size_t *outLen) {
+    size_t rowBytes = (size_t)width * 3 + 1;
+    unsigned char *filtered = (unsigned char*)malloc(rowBytes * height);
+    if (filtered == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+
+    // Filter type 2 (Up) on every row.
+    for (int y = 0; y < height; y++) {
+        unsigned char *dst = filtered + rowBytes * y;
+        const uint32_t *row = pixels + (long)y * pitch;
+        const uint32_t *above = y > 0 ? row - pitch : NULL;
+        dst[0] = 2;
+        for (int x = 0; x < width; x++) {
+            uint32_t p = row[x];
+            uint32_t q = above ? above[x] : 0;
+            dst[1 + 3 * x] = (unsigned char)((p >> 16) - (q >> 16));
+            dst[2 + 3 * x] = (unsigned char)((p >> 8) - (q >> 8));
+            dst[3 + 3 * x] = (unsigned char)(p - q);
+        }
+    }
+
+    ByteBuffer buf = { 0 };
+    static const unsigned char signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+    for (int i = 0; i < 8; i++) put_byte(&buf, signature[i]);
+
+    size_t chunk = begin_chunk(&buf, "IHDR");
+    put_u32(&buf, (uint32_t)width);
+    put_u32(&buf, (uint32_t)height);
+    put_byte(&buf, 8);  // bit depth
+    put_byte(&buf, 2);  // colour type: RGB
+    put_byte(&buf, 0);  // compression
+    put_byte(&buf, 0);  // filter method
+    put_byte(&buf, 0);  // no interlace
+    end_chunk(&buf, chunk);
+
+    chunk = begin_chunk(&buf, "IDAT");
+    put_zlib(&buf, filtered, rowBytes * height);
+    end_chunk(&buf, chunk);
+
+    chunk = begin_chunk(&buf, "IEND");
+    end_chunk(&buf, chunk);
+
+    free(filtered);
+
+    if (buf.failed) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(buf.data);
+        return -1;
+    }
+    *out = buf.data;
+    *outLen = buf.len;
+    return 0;
+}
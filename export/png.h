@@ -0,0 +1,19 @@
+/**
+ * @file export/png.h
+ * @brief Encodeur PNG minimal (RGB 8 bits, deflate à codes de Huffman fixes) sans dépendance externe.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef PNG_H
+#define PNG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Encode 0xAARRGGBB pixels (pitch in pixels) as an RGB PNG. On success *out is
+// a malloc'd buffer of *outLen bytes that the caller frees. Returns 0 or -1.
+int PngEncode(const uint32_t *pixels, int width, int height, int pitch,
+              unsigned char **out, size_t *outLen);
+
+#endif // PNG_H
@@ -1,38 +1,201 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include "sorting/sorting.h"
-#include "visual/visual.h"
-#include "utils/utils.h"
-#include "stats/stats.h"
-
-
-int main() {
-    int idxAlgo = 0;
-    LoadSample();
-
-    while (idxAlgo != 9) {
-        printf("Choose sorting algorithm:\n\t1 - SelectSort\n\t2 - BubbleSort\n\t3 - InsertionSort\n\t4 - QuickSort\n\t5 - MergeSort\n\t6 - Settings\n\t9 - Exit\n");
-        scanf(" %d", &idxAlgo);
-
-        while ((idxAlgo < 1 || idxAlgo > 6) && idxAlgo != 9) {
-            fprintf(stderr, "Invalid input. Please enter a number.\n");
-            scanf(" %d", &idxAlgo);
-        }
-
-        if (idxAlgo == 9) {
-            break;
-        }
-
-        if (idxAlgo < 1 || idxAlgo > 6) {
-            printf("%d is not a valid choice. Please enter your choice.\n", idxAlgo);
-            continue;
-        }
-
-        ChooseAlgorithm(idxAlgo);
-    }
-
-    // Free the allocated memory
-    FreeTabSample();
-    return 0;
-}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sorting/sorting.h"
+#include "sorting/registry.h"
+#include "visual/visual.h"
+#include "utils/utils.h"
+#include "stats/stats.h"
+#include "bench/baseline.h"
+#include "bench/tuner.h"
+#include "bench/cache.h"
+#include "bench/online.h"
+#include "sorting/tuning.h"
+#include "batch/batch.h"
+
+
+/**
+ * @brief Mode ligne de commande : tâches enchaînées, enregistrement / comparaison d'une référence de
+ * performances, ou réglage automatique des tris.
+ *
+ * @return Le code de sortie du programme.
+ */
+static int run_command_line(int argc, char *argv[]) {
+    BaselineOptions options;
+    BaselineDefaults(&options);
+    const char *savePath = NULL;
+    const char *comparePath = NULL;
+    const char *tunePath = NULL;
+    int cacheSize = 0;
+    int onlineSize = 0;
+    int onlineBatch = ONLINE_BENCH_BATCH;
+    CacheAnalysisOptions cacheOptions;
+    CacheAnalysisDefaults(&cacheOptions);
+    BatchQueue queue = { 0, 0, NULL };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            if (BatchLoadFile(&queue, argv[++i]) != 0) {
+                BatchFree(&queue);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--job") == 0 && i + 1 < argc) {
+            if (BatchAddJob(&queue, argv[++i], "--job") != 0) {
+                BatchFree(&queue);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--baseline-save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (strcmp(argv[i], "--baseline-compare") == 0 && i + 1 < argc) {
+            comparePath = argv[++i];
+        } else if (strcmp(argv[i], "--tune") == 0) {
+            tunePath = i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0 ? argv[++i] : TUNING_DEFAULT_PATH;
+        } else if (strcmp(argv[i], "--tuning") == 0 && i + 1 < argc) {
+            // Explicit profile: unlike the default one, it must exist and match this host.
+            if (TuningLoad(argv[++i]) != 0) {
+                fprintf(stderr, "Cannot use tuning profile %s\n", argv[i]);
+                BatchFree(&queue);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--cache-analysis") == 0 && i + 1 < argc) {
+            cacheSize = atoi(argv[++i]);
+            if (cacheSize <= 0) {
+                fprintf(stderr, "Invalid size for --cache-analysis: %s\n", argv[i]);
+                BatchFree(&queue);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--online") == 0 && i + 1 < argc) {
+            onlineSize = atoi(argv[++i]);
+            if (onlineSize <= 0) {
+                fprintf(stderr, "Invalid size for --online: %s\n", argv[i]);
+                BatchFree(&queue);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--online-batch") == 0 && i + 1 < argc) {
+            onlineBatch = atoi(argv[++i]);
+            if (onlineBatch <= 0) {
+                fprintf(stderr, "Invalid size for --online-batch: %s\n", argv[i]);
+                BatchFree(&queue);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            if (CacheConfigParse(&cacheOptions.cache, argv[++i]) != 0) {
+                BatchFree(&queue);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--heatmap") == 0 && i + 1 < argc) {
+            cacheOptions.heatmapDir = argv[++i];
+        } else if (strcmp(argv[i], "--list") == 0) {
+            SortPrintAlgorithms();
+            BatchFree(&queue);
+            return 0;
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            options.threshold = atof(argv[++i]) / 100.0;
+        } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            options.alpha = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--batch FILE] [--job \"algo=NAME n=SIZE dist=TYPE seed=S mode=visual|headless delay=MS output=PATH\"]...\n"
+                            "       %s --baseline-save FILE | --baseline-compare FILE [--threshold PERCENT] [--alpha P]\n"
+                            "       %s --tune [FILE]\n"
+                            "       %s --cache-analysis SIZE [--cache \"line=64,L1=32K/8,L2=1M/16,L3=8M/16\"] [--heatmap DIR]\n"
+                            "       %s --online SIZE [--online-batch VALUES] (sorted-run container against re-sorting)\n"
+                            "       %s --list (registered algorithms and their properties)\n"
+                            "       --tuning FILE uses a tuning profile other than %s\n", argv[0], argv[0], argv[0], argv[0], argv[0], argv[0],
+                            TUNING_DEFAULT_PATH);
+            BatchFree(&queue);
+            return 2;
+        }
+    }
+
+    if (tunePath) {
+        int status = RunAutoTune(tunePath);
+        if (status != 0 || (queue.count == 0 && !savePath && !comparePath)) {
+            BatchFree(&queue);
+            return status == 0 ? 0 : 2;
+        }
+    }
+
+    if (cacheSize > 0) {
+        int *sample = ReserveSample(cacheSize);
+        if (sample == NULL) {
+            BatchFree(&queue);
+            return 2;
+        }
+        FillSample(sample, cacheSize, 1);
+        RunCacheAnalysis(sample, cacheSize, &cacheOptions);
+        FreeTabSample();
+        if (queue.count == 0 && !savePath && !comparePath && onlineSize == 0) return 0;
+    }
+
+    if (onlineSize > 0) {
+        int *sample = ReserveSample(onlineSize);
+        if (sample == NULL) {
+            BatchFree(&queue);
+            return 2;
+        }
+        FillSample(sample, onlineSize, 1);
+        RunOnlineBenchmark(sample, onlineSize, onlineBatch);
+        FreeTabSample();
+        if (queue.count == 0 && !savePath && !comparePath) return 0;
+    }
+
+    // The baseline runs after the jobs; the exit code is the worst of both.
+    int status = 0;
+    if (queue.count > 0) {
+        int failed = BatchRun(&queue);
+        BatchFree(&queue);
+        FreeTabSample();
+        status = failed > 0 ? 1 : 0;
+        if (!savePath && !comparePath) return status;
+    }
+
+    if (savePath) {
+        int saved = BaselineSave(savePath, &options) == 0 ? 0 : 2;
+        return saved > status ? saved : status;
+    }
+    if (comparePath) {
+        int compared = BaselineCompare(comparePath, &options);
+        return compared > status ? compared : status;
+    }
+    fprintf(stderr, "Nothing to do: expected --batch, --job, --baseline-save, --baseline-compare, --tune, --cache-analysis or --online\n");
+    return 2;
+}
+
+int main(int argc, char *argv[]) {
+    // Parameters tuned for this machine, if a profile was saved (--tune).
+    TuningLoad(TUNING_DEFAULT_PATH);
+
+    if (argc > 1) {
+        return run_command_line(argc, argv);
+    }
+
+    int idxAlgo = 0;
+    int exitChoice = MainMenuExit();
+    LoadSample();
+
+    while (idxAlgo != exitChoice) {
+        ShowMainMenu();
+
+        int status = ReadInt(&idxAlgo);
+        if (status < 0) {
+            // End of input: leave instead of prompting forever.
+            break;
+        }
+
+        if (status == 0 || idxAlgo < 1 || idxAlgo > exitChoice) {
+            fprintf(stderr, "Invalid input. Please enter a number between 1 and %d.\n", exitChoice);
+            idxAlgo = 0;
+            continue;
+        }
+
+        if (idxAlgo == exitChoice) {
+            break;
+        }
+
+        ChooseAlgorithm(idxAlgo);
+    }
+
+    // Free the allocated memory
+    FreeTabSample();
+    return 0;
+}
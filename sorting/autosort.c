@@ -0,0 +1,281 @@
+#include "autosort.h"
+#include "registry.h"
+#include "../utils/alloc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file autosort.c
+ * @brief Analyse du degré de tri de l'entrée et choix automatique de l'algorithme.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * L'analyse fait un seul passage sans branchement sur le tableau (descentes, montées, minimum, maximum :
+ * la boucle est vectorisée par le compilateur), puis estime les inversions et les doublons par
+ * échantillonnage. Quand les suites croissantes sont peu nombreuses, les inversions sont comptées
+ * exactement jusqu'à 2n : l'échantillon manque une courte fin non triée. Le choix qui en découle :
+ * - déjà trié : rien à faire ; décroissant : inversion du tableau ;
+ * - petit ou presque trié (peu d'inversions) : tri par insertion ;
+ * - longues suites triées : tri par fusion naturel ;
+ * - clés denses : tri par dénombrement ; grand tableau : tri par base ;
+ * - beaucoup de doublons : tri par fusion ; sinon : tri rapide.
+ * Les tris retenus sont appelés par leur entrée du registre (registry.h).
+ */
+
+/**
+ * @brief Taille en dessous de laquelle le tri par insertion est toujours retenu.
+ */
+#define AUTOSORT_SMALL 32
+
+/**
+ * @brief Nombre de paires (ou de valeurs) tirées pour les estimations.
+ */
+#define AUTOSORT_SAMPLES 1024
+
+/**
+ * @brief Taille à partir de laquelle le tri par base bat le tri rapide sur des clés dispersées.
+ */
+#define AUTOSORT_RADIX_MIN (1 << 14)
+
+/**
+ * @brief Algorithmes entre lesquels choisit le répartiteur.
+ */
+typedef enum AutoChoice {
+    AUTO_NONE,
+    AUTO_REVERSE,
+    AUTO_INSERTION,
+    AUTO_NATURAL_MERGE,
+    AUTO_COUNTING,
+    AUTO_RADIX,
+    AUTO_MERGE,
+    AUTO_QUICK
+} AutoChoice;
+
+/**
+ * @brief Générateur pseudo-aléatoire de l'échantillonnage (xorshift) : rand() reste intact pour les entrées.
+ */
+static unsigned int next_random(unsigned int *state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Comparaison de deux entiers pour qsort.
+ */
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Nombre exact d'inversions, compté par un tri par insertion d'une copie qui s'arrête dès que
+ * limit est dépassé (coût O(n + limit)).
+ *
+ * @return Le nombre d'inversions, limit + 1 s'il dépasse limit, ou -1 si la copie n'a pu être allouée.
+ */
+static long long bounded_inversions(const int tab[], int n, long long limit) {
+    int *copy = (int*)SortMalloc((size_t)n * sizeof(int));
+    if (copy == NULL) return -1;
+    memcpy(copy, tab, (size_t)n * sizeof(int));
+
+    long long count = 0;
+    for (int i = 1; i < n && count <= limit; i++) {
+        int v = copy[i];
+        int j = i;
+        while (j > 0 && copy[j - 1] > v && count <= limit) {
+            copy[j] = copy[j - 1];
+            j--;
+            count++;
+        }
+        copy[j] = v;
+    }
+    SortFree(copy);
+    return count;
+}
+
+/**
+ * @brief Proportion de doublons : exacte par table de présence si les clés sont denses, sinon estimée sur
+ * un échantillon trié.
+ */
+static double duplicate_ratio(const int tab[], int n, int min, double range) {
+    if (range <= 4.0 * n + 1024) {
+        size_t bytes = ((size_t)range + 7) / 8;
+        unsigned char *seen = (unsigned char*)SortCalloc(bytes, 1);
+        if (seen != NULL) {
+            long distinct = 0;
+            for (int i = 0; i < n; i++) {
+                size_t v = (size_t)((long long)tab[i] - min);
+                unsigned char bit = (unsigned char)(1u << (v & 7));
+                distinct += !(seen[v >> 3] & bit);
+                seen[v >> 3] |= bit;
+            }
+            SortFree(seen);
+            return 1.0 - (double)distinct / n;
+        }
+    }
+
+    int count = n < AUTOSORT_SAMPLES ? n : AUTOSORT_SAMPLES;
+    int sample[AUTOSORT_SAMPLES];
+    for (int i = 0; i < count; i++) sample[i] = tab[(long long)i * n / count];
+    qsort(sample, count, sizeof(int), compare_int);
+    int duplicates = 0;
+    for (int i = 1; i < count; i++) duplicates += sample[i] == sample[i - 1];
+    return (double)duplicates / count;
+}
+
+/**
+ * @brief Analyse l'entrée : suites croissantes et décroissantes, inversions estimées, étendue des clés et
+ * proportion de doublons.
+ *
+ * @param tab Le tableau (non modifié).
+ * @param n Le nombre d'éléments.
+ * @param profile L'analyse (algorithm et reason restent vides).
+ */
+void AnalyzeSort(const int tab[], int n, SortProfile *profile) {
+    double start = StatsNow();
+    memset(profile, 0, sizeof(*profile));
+    profile->n = n;
+    profile->algorithm = "-";
+    profile->reason = "-";
+    if (n <= 0) return;
+
+    int min = tab[0], max = tab[0];
+    long descents = 0, ascents = 0;
+    for (int i = 1; i < n; i++) {
+        int a = tab[i - 1], b = tab[i];
+        descents += a > b;
+        ascents += a < b;
+        min = b < min ? b : min;
+        max = b > max ? b : max;
+    }
+
+    profile->ascendingRuns = (int)(descents + 1);
+    profile->descendingRuns = (int)(ascents + 1);
+    profile->min = min;
+    profile->max = max;
+    profile->range = (double)max - (double)min + 1.0;
+
+    double pairs = (double)n * (n - 1) / 2.0;
+    if (descents == 0) {
+        profile->inversionRatio = 0.0;
+    } else if (ascents == 0) {
+        profile->inversionRatio = 1.0;
+    } else {
+        unsigned int state = 0x9E3779B9u ^ (unsigned int)n;
+        int inverted = 0, drawn = 0;
+        for (int s = 0; s < AUTOSORT_SAMPLES; s++) {
+            int i = (int)(next_random(&state) % (unsigned int)n);
+            int j = (int)(next_random(&state) % (unsigned int)n);
+            if (i == j) continue;
+            if (i > j) {
+                int t = i; i = j; j = t;
+            }
+            inverted += tab[i] > tab[j];
+            drawn++;
+        }
+        profile->inversionRatio = drawn > 0 ? (double)inverted / drawn : 0.0;
+    }
+    profile->inversions = profile->inversionRatio * pairs;
+    if (descents > 0 && ascents > 0 && profile->ascendingRuns <= n / 32) {
+        long long limit = 2LL * n;
+        long long exact = bounded_inversions(tab, n, limit);
+        if (exact < 0) exact = limit + 1;  // no copy: assume too many for the insertion sort
+        if (exact <= limit || exact > profile->inversions) {
+            profile->inversions = (double)exact;
+            profile->inversionRatio = (double)exact / pairs;
+        }
+    }
+    profile->duplicateRatio = duplicate_ratio(tab, n, min, profile->range);
+    profile->analysisSeconds = StatsNow() - start;
+}
+
+/**
+ * @brief Choisit l'algorithme d'après l'analyse et renseigne la décision dans le profil.
+ */
+static AutoChoice choose(SortProfile *profile) {
+    int n = profile->n;
+    AutoChoice choice;
+
+    if (n < 2 || profile->ascendingRuns == 1) {
+        choice = AUTO_NONE;
+        profile->reason = "already sorted";
+    } else if (profile->descendingRuns == 1) {
+        choice = AUTO_REVERSE;
+        profile->reason = "non-increasing input";
+    } else if (n <= AUTOSORT_SMALL) {
+        choice = AUTO_INSERTION;
+        profile->reason = "small input";
+    } else if (profile->ascendingRuns <= n / 32 && profile->inversions <= 2.0 * n) {
+        // Exact count here (see AnalyzeSort): the insertion sort costs O(n + inversions).
+        choice = AUTO_INSERTION;
+        profile->reason = "few inversions";
+    } else if (profile->ascendingRuns <= n / 16 || profile->inversionRatio < 0.05) {
+        choice = AUTO_NATURAL_MERGE;
+        profile->reason = "long sorted runs";
+    } else if (profile->range <= 2.0 * n) {
+        choice = AUTO_COUNTING;
+        profile->reason = "dense keys";
+    } else if (n >= AUTOSORT_RADIX_MIN) {
+        choice = AUTO_RADIX;
+        profile->reason = "large input with sparse keys";
+    } else if (profile->duplicateRatio > 0.5) {
+        choice = AUTO_MERGE;
+        profile->reason = "many duplicates";
+    } else {
+        choice = AUTO_QUICK;
+        profile->reason = "no exploitable structure";
+    }
+
+    // Beyond the first two, the names are entries of the algorithm registry.
+    static const char *names[] = {
+        "none", "ReverseArray", "InsertionSort", "NaturalMerge",
+        "CountingSort", "RadixSort", "MergeSort", "QuickSort"
+    };
+    profile->algorithm = names[choice];
+    return choice;
+}
+
+/**
+ * @brief Trie le tableau avec l'algorithme le mieux adapté à son contenu. L'analyse et la décision sont
+ * enregistrées dans le module de statistiques (StatsLastAutoSort).
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void AutoSort(int tab[], int n) {
+    SortProfile profile;
+    AnalyzeSort(tab, n, &profile);
+    AutoChoice choice = choose(&profile);
+    StatsRecordAutoSort(&profile);
+
+    if (choice == AUTO_REVERSE) {
+        ReverseArray(tab, n);
+    } else if (choice != AUTO_NONE) {
+        SortFindAlgorithm(profile.algorithm)->sort(tab, n);
+    }
+}
+
+/**
+ * @brief AutoSort prévu pour la visualisation : l'analyse n'est pas affichée, l'algorithme choisi l'est.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void AutoSort_viz(int tab[], int n, VizCallback cb) {
+    SortProfile profile;
+    AnalyzeSort(tab, n, &profile);
+    AutoChoice choice = choose(&profile);
+    StatsRecordAutoSort(&profile);
+
+    if (choice == AUTO_REVERSE) {
+        ReverseArray_viz(tab, n, cb);
+    } else if (choice != AUTO_NONE) {
+        SortFindAlgorithm(profile.algorithm)->sortViz(tab, n, cb);
+    }
+}
@@ -0,0 +1,21 @@
+/**
+ * @file sorting/autosort.h
+ * @brief Analyse du degré de tri de l'entrée et choix automatique de l'algorithme.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef AUTOSORT_H
+#define AUTOSORT_H
+
+#include "sorting.h"
+#include "../stats/stats.h"
+
+// Single pass plus sampling: runs, inversions (exact up to 2n on few runs), key range, duplicate ratio.
+void AnalyzeSort(const int arr[], int n, SortProfile *profile);
+
+// Analyze, pick an algorithm, log both to the stats module, then sort.
+void AutoSort(int arr[], int n);
+void AutoSort_viz(int arr[], int n, VizCallback cb);
+
+#endif // AUTOSORT_H
@@ -0,0 +1,240 @@
+#include "events.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @file events.c
+ * @brief Livraison par lots des événements des tris instrumentés, et rejeu vers un VizCallback.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Un tri instrumenté écrit ses événements dans un flux. Sous SortRunEvents, le flux est un tampon de
+ * SORT_EVENT_BATCH événements livré d'un coup au consommateur : plus d'appel indirect par comparaison.
+ * Une opération sur une zone y recopie ses valeurs (SORT_EVENT_VALUES au plus par lot) et ne coupe donc pas
+ * le lot. Pour un VizCallback, le flux a une capacité de 1 et chaque événement est rejoué aussitôt en appels
+ * du callback, avec le tableau dans l'état qu'il avait avant l'introduction des événements.
+ */
+
+/**
+ * @brief Flux ouvert sur ce thread (SortRunEvents ou tri instrumenté en cours).
+ */
+static _Thread_local SortEventStream *active_stream = NULL;
+
+/**
+ * @brief Nombre d'étapes de VizCallback que représente un événement.
+ *
+ * @param event L'événement.
+ */
+long SortEventSteps(const SortEvent *event) {
+    switch (event->type) {
+        case SORT_EVENT_WRITE_RANGE:
+        case SORT_EVENT_SWAP_BLOCK:
+            return event->len;
+        case SORT_EVENT_REVERSE:
+            return event->len / 2;
+        default:
+            return 1;
+    }
+}
+
+/**
+ * @brief Paire d'indices mise en évidence à une étape d'un événement.
+ *
+ * @param event L'événement.
+ * @param step L'étape (0 <= step < SortEventSteps(event)).
+ * @param a Premier indice (sortie).
+ * @param b Second indice (sortie).
+ */
+void SortEventStep(const SortEvent *event, long step, int *a, int *b) {
+    switch (event->type) {
+        case SORT_EVENT_WRITE_RANGE:
+            *a = *b = event->a + (int)step;
+            break;
+        case SORT_EVENT_SWAP_BLOCK:
+            *a = event->a + (int)step;
+            *b = event->b + (int)step;
+            break;
+        case SORT_EVENT_REVERSE:
+            *a = event->a + (int)step;
+            *b = event->b - (int)step;
+            break;
+        default:
+            *a = event->a;
+            *b = event->b;
+            break;
+    }
+}
+
+/**
+ * @brief Valeurs de la paire mise en évidence juste après une étape : recopiées à l'émission pour une opération
+ * sur une zone, sinon lues dans le tableau.
+ *
+ * @param event L'événement.
+ * @param step L'étape (0 <= step < SortEventSteps(event)).
+ * @param arr Le tableau passé au consommateur.
+ * @param n Le nombre d'éléments dans le tableau.
+ * @param value_a Valeur du premier indice (sortie).
+ * @param value_b Valeur du second indice (sortie).
+ */
+void SortEventStepValues(const SortEvent *event, long step, const int arr[], int n, int *value_a, int *value_b) {
+    if (event->type < SORT_EVENT_WRITE_RANGE) {
+        *value_a = event->value_a;
+        *value_b = event->value_b;
+        return;
+    }
+    if (event->values != NULL) {
+        *value_a = event->values[2 * step];
+        *value_b = event->values[2 * step + 1];
+        return;
+    }
+    int a, b;
+    SortEventStep(event, step, &a, &b);
+    *value_a = a >= 0 && a < n ? arr[a] : 0;
+    *value_b = b >= 0 && b < n ? arr[b] : 0;
+}
+
+/**
+ * @brief Livre les événements en attente au consommateur, ou les rejoue vers le callback.
+ *
+ * @param stream Le flux.
+ */
+void SortEventsFlush(SortEventStream *stream) {
+    if (stream == NULL || stream->count == 0) return;
+
+    if (stream->cb != NULL) {
+        for (int i = 0; i < stream->count; i++) {
+            const SortEvent *event = &stream->events[i];
+            long steps = SortEventSteps(event);
+            for (long s = 0; s < steps; s++) {
+                int a, b;
+                SortEventStep(event, s, &a, &b);
+                stream->cb(stream->tab, stream->n, a, b);
+            }
+        }
+    } else if (stream->sink != NULL) {
+        stream->sink(stream->tab, stream->n, stream->events, stream->count, stream->user);
+    }
+    stream->count = 0;
+    stream->valueCount = 0;
+}
+
+/**
+ * @brief Ajoute une opération sur une zone au lot en recopiant ses valeurs. Si elles ne tiennent pas dans le
+ * tampon, même vide, l'opération est livrée seule, le tableau contenant alors encore son résultat.
+ *
+ * @param stream Le flux.
+ * @param type Le type de l'opération (SORT_EVENT_WRITE_RANGE ou suivants).
+ * @param a Début de la zone.
+ * @param b Second indice (voir SortEventType).
+ * @param len Longueur de la zone.
+ */
+void SortEventsPushRange(SortEventStream *stream, int type, int a, int b, int len) {
+    SortEvent event = { type, a, b, len, 0, 0, NULL };
+    long steps = SortEventSteps(&event);
+
+    if (2 * steps > stream->valueCapacity - stream->valueCount) SortEventsFlush(stream);
+    int kept = 2 * steps <= stream->valueCapacity - stream->valueCount;
+    if (kept) {
+        int *values = stream->values + stream->valueCount;
+        for (long s = 0; s < steps; s++) {
+            int i, j;
+            SortEventStep(&event, s, &i, &j);
+            values[2 * s] = (unsigned int)i < (unsigned int)stream->n ? stream->tab[i] : 0;
+            values[2 * s + 1] = (unsigned int)j < (unsigned int)stream->n ? stream->tab[j] : 0;
+        }
+        event.values = values;
+        stream->valueCount += (int)(2 * steps);
+    }
+
+    stream->events[stream->count++] = event;
+    if (!kept || stream->count == stream->capacity) SortEventsFlush(stream);
+}
+
+/**
+ * @brief Flux d'un tri instrumenté : celui de SortRunEvents s'il porte sur ce tableau, sinon le flux local
+ * qui rejoue les événements vers cb.
+ *
+ * @param local Flux à utiliser si aucun n'est ouvert.
+ * @param tab Tableau trié.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation (peut être NULL).
+ * @return Le flux, ou NULL si personne n'écoute.
+ */
+SortEventStream *SortEventsOpen(SortEventStream *local, int tab[], int n, VizCallback cb) {
+    if (active_stream != NULL && active_stream->tab == tab) return active_stream;
+    if (cb == NULL) return NULL;
+
+    local->tab = tab;
+    local->n = n;
+    local->count = 0;
+    local->capacity = 1;
+    local->sink = NULL;
+    local->user = NULL;
+    local->cb = cb;
+    local->events = &local->single;
+    local->values = NULL;
+    local->valueCount = 0;
+    local->valueCapacity = 0;
+    local->previous = active_stream;
+    active_stream = local;
+    return local;
+}
+
+/**
+ * @brief Ferme le flux ouvert par SortEventsOpen s'il s'agit du flux local.
+ *
+ * @param stream Le flux renvoyé par SortEventsOpen.
+ * @param local Le flux local passé à SortEventsOpen.
+ */
+void SortEventsClose(SortEventStream *stream, SortEventStream *local) {
+    if (stream == NULL || stream != local) return;
+    SortEventsFlush(stream);
+    active_stream = stream->previous;
+}
+
+/**
+ * @brief Exécute un tri instrumenté en livrant ses événements par lots. Si les tampons des lots ne peuvent pas
+ * être alloués, chaque événement est livré seul.
+ *
+ * @param sortWithCb Le tri instrumenté (*_viz), appelé avec un callback NULL.
+ * @param tab Le tableau à trier.
+ * @param n Le nombre d'éléments dans le tableau.
+ * @param sink Le consommateur des lots.
+ * @param user Donnée transmise au consommateur.
+ */
+void SortRunEvents(void (*sortWithCb)(int[], int, VizCallback), int tab[], int n, SortEventSink sink, void *user) {
+    if (sortWithCb == NULL) return;
+
+    SortEventStream stream;
+    stream.tab = tab;
+    stream.n = n;
+    stream.count = 0;
+    stream.sink = sink;
+    stream.user = user;
+    stream.cb = NULL;
+    stream.events = (SortEvent*)malloc(SORT_EVENT_BATCH * sizeof(SortEvent));
+    stream.values = (int*)malloc(SORT_EVENT_VALUES * sizeof(int));
+    stream.valueCount = 0;
+    if (stream.events == NULL || stream.values == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(stream.events);
+        free(stream.values);
+        stream.events = &stream.single;
+        stream.values = NULL;
+        stream.capacity = 1;
+        stream.valueCapacity = 0;
+    } else {
+        stream.capacity = SORT_EVENT_BATCH;
+        stream.valueCapacity = SORT_EVENT_VALUES;
+    }
+    stream.previous = active_stream;
+    active_stream = &stream;
+
+    sortWithCb(tab, n, NULL);
+
+    SortEventsFlush(&stream);
+    active_stream = stream.previous;
+    if (stream.events != &stream.single) free(stream.events);
+    free(stream.values);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file sorting/events.h
+ * @brief Événements des tris instrumentés : opérations ponctuelles et opérations sur des zones, livrées par lots.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef EVENTS_H
+
+#define EVENTS_H
+
+#include "sorting.h"
+
+// Number of events buffered before a batch is delivered to the sink.
+#define SORT_EVENT_BATCH 512
+// Values kept for the range operations of a batch (two per step).
+#define SORT_EVENT_VALUES 16384
+
+typedef enum SortEventType {
+    // Single operations: a and b are the highlighted indices.
+    SORT_EVENT_COMPARE,
+    SORT_EVENT_SWAP,
+    SORT_EVENT_WRITE,       // a written, highlighted with b
+    // Operations on ranges: their values are copied when they are emitted, or, for a range too long for the
+    // batch's value buffer, the event ends its batch so the array still holds its result on delivery.
+    SORT_EVENT_WRITE_RANGE, // [a, a + len) written (copy, shift...)
+    SORT_EVENT_SWAP_BLOCK,  // [a, a + len) exchanged with [b, b + len)
+    SORT_EVENT_REVERSE      // [a, b] reversed, len = b - a + 1
+} SortEventType;
+
+typedef struct SortEvent {
+    int type;
+    int a;
+    int b;
+    int len;
+    int value_a; // single operations: values at a / b right after the operation
+    int value_b;
+    const int *values; // range operations: values of the pair of each step, or NULL to read the array
+} SortEvent;
+
+// Receives the events in order. arr is the array being sorted, as it is when the batch is delivered.
+typedef void (*SortEventSink)(const int arr[], int n, const SortEvent events[], int count, void *user);
+
+typedef struct SortEventStream {
+    int *tab;
+    int n;
+    int count;
+    int capacity;          // 1 when feeding a VizCallback: every event is delivered at once
+    SortEventSink sink;
+    void *user;
+    VizCallback cb;        // set instead of sink to replay the events as single callbacks
+    struct SortEventStream *previous;
+    SortEvent *events;     // capacity slots
+    int *values;           // valueCapacity ints (NULL when 0)
+    int valueCount;
+    int valueCapacity;
+    SortEvent single;      // storage of a capacity-1 stream
+} SortEventStream;
+
+// Runs an instrumented sort (*_viz) and delivers its events to sink in batches instead of calling a VizCallback.
+void SortRunEvents(void (*sortWithCb)(int[], int, VizCallback), int tab[], int n, SortEventSink sink, void *user);
+
+// Number of VizCallback steps an event stands for, and the highlighted pair of one of them.
+long SortEventSteps(const SortEvent *event);
+void SortEventStep(const SortEvent *event, long step, int *a, int *b);
+// Values of the highlighted pair right after a step (arr is the array passed to the sink).
+void SortEventStepValues(const SortEvent *event, long step, const int arr[], int n, int *value_a, int *value_b);
+
+// Used by the instrumented sorts: the stream of the enclosing SortRunEvents for this array, else local
+// set up to replay the events to cb (NULL if cb is NULL). Close flushes and restores the enclosing stream.
+SortEventStream *SortEventsOpen(SortEventStream *local, int tab[], int n, VizCallback cb);
+void SortEventsClose(SortEventStream *stream, SortEventStream *local);
+void SortEventsFlush(SortEventStream *stream);
+// Adds a range operation to the batch; flushes when the batch is full or the range's values do not fit.
+void SortEventsPushRange(SortEventStream *stream, int type, int a, int b, int len);
+
+#endif // EVENTS_H
@@ -0,0 +1,412 @@
+#include "online.h"
+#include "sorting.h"
+#include "tuning.h"
+#include "../utils/alloc.h"
+#include "../utils/threadpool.h"
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file online.c
+ * @brief Conteneur trié alimenté par lots (journal de suites triées, LSM).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Chaque lot inséré est copié, trié, puis empilé comme une suite. Tant qu'une suite n'est pas plus courte
+ * que la suivante, les deux sont fusionnées dans un nouveau tableau : les longueurs des suites forment un
+ * compteur binaire, chaque valeur est fusionnée O(log n) fois et une lecture parcourt O(log n) suites.
+ * Les fusions d'au moins SORTED_STREAM_BACKGROUND_MIN valeurs peuvent être confiées à un thread : les deux
+ * suites restent lisibles pendant la fusion (elles ne sont que lues) et le résultat les remplace au premier
+ * appel qui suit sa fin. Une seule fusion en arrière-plan existe à la fois ; une insertion n'attend que si
+ * la fusion suivante a besoin de son résultat.
+ */
+
+/**
+ * @brief Fusion en arrière-plan des suites first et first + 1.
+ */
+typedef struct SortedMerge {
+    const int *a;
+    int na;
+    const int *b;
+    int nb;
+    int *out;
+    int first;
+    atomic_int done;
+} SortedMerge;
+
+/**
+ * @brief Fusionne deux suites triées dans out. À chaque pas, la comparaison choisit la source au lieu d'un
+ * saut conditionnel, imprévisible sur des données aléatoires.
+ */
+static void merge_runs(const int *a, int na, const int *b, int nb, int *out) {
+    int i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        int x = a[i], y = b[j];
+        int fromB = y < x;
+        out[k++] = fromB ? y : x;
+        i += !fromB;
+        j += fromB;
+    }
+    memcpy(out + k, a + i, (size_t)(na - i) * sizeof(int));
+    memcpy(out + k + na - i, b + j, (size_t)(nb - j) * sizeof(int));
+}
+
+static void merge_task(void *arg) {
+    SortedMerge *merge = (SortedMerge*)arg;
+    merge_runs(merge->a, merge->na, merge->b, merge->nb, merge->out);
+    atomic_store_explicit(&merge->done, 1, memory_order_release);
+}
+
+/**
+ * @brief Indique si la suite index est en cours de fusion en arrière-plan.
+ */
+static int is_merging(const SortedStream *stream, int index) {
+    return stream->merge != NULL && (index == stream->merge->first || index == stream->merge->first + 1);
+}
+
+/**
+ * @brief Remplace les suites first et first + 1 par leur fusion values, puis prévient le crochet.
+ */
+static void replace_pair(SortedStream *stream, int first, int *values) {
+    SortedRun *runs = stream->runs;
+    int count = runs[first].count + runs[first + 1].count;
+    SortFree(runs[first + 1].values);
+    SortFree(runs[first].values);
+    runs[first].values = values;
+    runs[first].count = count;
+
+    memmove(runs + first + 1, runs + first + 2, (size_t)(stream->nbRuns - first - 2) * sizeof(SortedRun));
+    stream->nbRuns--;
+    if (stream->merge != NULL && stream->merge->first > first) stream->merge->first--;
+
+    if (stream->onMerge != NULL) {
+        long long start = 0;
+        for (int r = 0; r < first; r++) start += runs[r].count;
+        stream->onMerge(stream->hookUser, start, values, count);
+    }
+}
+
+/**
+ * @brief Installe le résultat de la fusion en arrière-plan si elle est terminée.
+ *
+ * @param wait 1 pour attendre la fin de la fusion.
+ */
+static void collect(SortedStream *stream, int wait) {
+    SortedMerge *merge = stream->merge;
+    if (merge == NULL) return;
+    if (!wait && !atomic_load_explicit(&merge->done, memory_order_acquire)) return;
+
+    ThreadPoolWait(stream->pool);
+    stream->merge = NULL;
+    replace_pair(stream, merge->first, merge->out);
+    SortFree(merge);
+}
+
+/**
+ * @brief Fusionne les suites first et first + 1, en arrière-plan si la fusion est assez grande.
+ *
+ * @return 0 en cas de succès, -1 en cas d'échec d'allocation.
+ */
+static int merge_pair(SortedStream *stream, int first) {
+    const SortedRun *a = &stream->runs[first], *b = &stream->runs[first + 1];
+    size_t total = (size_t)a->count + (size_t)b->count;
+    int *out = (int*)SortMalloc(total * sizeof(int));
+    if (out == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+
+    if (stream->background && total >= SORTED_STREAM_BACKGROUND_MIN) {
+        if (stream->pool == NULL) stream->pool = ThreadPoolCreate(1);
+        SortedMerge *merge = stream->pool != NULL ? (SortedMerge*)SortMalloc(sizeof(SortedMerge)) : NULL;
+        if (merge != NULL) {
+            merge->a = a->values;
+            merge->na = a->count;
+            merge->b = b->values;
+            merge->nb = b->count;
+            merge->out = out;
+            merge->first = first;
+            atomic_init(&merge->done, 0);
+            stream->merge = merge;
+            if (ThreadPoolSubmit(stream->pool, merge_task, merge) == 0) return 0;
+            stream->merge = NULL;
+            SortFree(merge);
+        }
+    }
+
+    // Small merge, or no worker: on this thread.
+    merge_runs(a->values, a->count, b->values, b->count, out);
+    replace_pair(stream, first, out);
+    return 0;
+}
+
+/**
+ * @brief Rétablit la règle des suites : une suite est fusionnée avec la suivante tant qu'elle n'est pas
+ * plus longue. Les suites en cours de fusion sont laissées de côté ; une seconde grande fusion attend la
+ * première.
+ *
+ * @return 0 en cas de succès, -1 en cas d'échec d'allocation.
+ */
+static int compact(SortedStream *stream) {
+    for (;;) {
+        collect(stream, 0);
+        int pair = -1;
+        for (int i = stream->nbRuns - 1; i >= 1 && pair < 0; i--) {
+            if (stream->runs[i - 1].count <= stream->runs[i].count && !is_merging(stream, i - 1) &&
+                !is_merging(stream, i)) {
+                pair = i - 1;
+            }
+        }
+        if (pair < 0) return 0;
+
+        size_t total = (size_t)stream->runs[pair].count + (size_t)stream->runs[pair + 1].count;
+        if (stream->merge != NULL && stream->background && total >= SORTED_STREAM_BACKGROUND_MIN) {
+            collect(stream, 1);
+            continue;
+        }
+        if (merge_pair(stream, pair) != 0) return -1;
+    }
+}
+
+/**
+ * @brief Prépare un conteneur vide.
+ *
+ * @param stream Le conteneur.
+ * @param background 1 pour fusionner les grandes suites sur un thread.
+ */
+void SortedStreamInit(SortedStream *stream, int background) {
+    stream->nbRuns = 0;
+    stream->count = 0;
+    stream->background = background;
+    stream->pool = NULL;
+    stream->merge = NULL;
+    stream->onMerge = NULL;
+    stream->hookUser = NULL;
+}
+
+/**
+ * @brief Installe le crochet appelé à chaque fusion de deux suites (NULL pour le retirer).
+ *
+ * @param stream Le conteneur.
+ * @param onMerge Le crochet.
+ * @param user Donnée transmise au crochet.
+ */
+void SortedStreamSetHook(SortedStream *stream, SortedStreamMergeHook onMerge, void *user) {
+    stream->onMerge = onMerge;
+    stream->hookUser = user;
+}
+
+/**
+ * @brief Libère un conteneur, après la fin de la fusion en arrière-plan.
+ */
+void SortedStreamFree(SortedStream *stream) {
+    collect(stream, 1);
+    for (int r = stream->nbRuns - 1; r >= 0; r--) SortFree(stream->runs[r].values);
+    ThreadPoolDestroy(stream->pool);
+    SortedStreamInit(stream, stream->background);
+}
+
+/**
+ * @brief Insère un lot de valeurs : le lot est copié, trié, empilé, puis les suites sont fusionnées selon
+ * la règle du compteur binaire.
+ *
+ * @param stream Le conteneur.
+ * @param values Les valeurs du lot (non modifiées).
+ * @param n Le nombre de valeurs.
+ * @return 0 en cas de succès, -1 en cas d'échec d'allocation.
+ */
+int SortedStreamInsert(SortedStream *stream, const int values[], int n) {
+    if (n <= 0) return 0;
+    if (stream->nbRuns == SORTED_STREAM_MAX_RUNS) {
+        // Only reachable while the background merge holds back the compaction.
+        collect(stream, 1);
+        if (compact(stream) != 0 || stream->nbRuns == SORTED_STREAM_MAX_RUNS) return -1;
+    }
+
+    int *run = (int*)SortMalloc((size_t)n * sizeof(int));
+    if (run == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+    memcpy(run, values, (size_t)n * sizeof(int));
+    ParallelQuickSort(run, n);
+
+    stream->runs[stream->nbRuns].values = run;
+    stream->runs[stream->nbRuns].count = n;
+    stream->nbRuns++;
+    stream->count += n;
+    return compact(stream);
+}
+
+/**
+ * @brief Fusionne toutes les suites en une, en partant des plus courtes.
+ *
+ * @return 0 en cas de succès, -1 en cas d'échec d'allocation.
+ */
+int SortedStreamFlush(SortedStream *stream) {
+    collect(stream, 1);
+    while (stream->nbRuns > 1) {
+        int first = stream->nbRuns - 2;
+        const SortedRun *a = &stream->runs[first], *b = &stream->runs[first + 1];
+        int *out = (int*)SortMalloc(((size_t)a->count + (size_t)b->count) * sizeof(int));
+        if (out == NULL) {
+            fprintf(stderr, "Memory allocation failed\n");
+            return -1;
+        }
+        merge_runs(a->values, a->count, b->values, b->count, out);
+        replace_pair(stream, first, out);
+    }
+    return 0;
+}
+
+/**
+ * @brief Getteur du nombre de valeurs insérées.
+ */
+long long SortedStreamCount(const SortedStream *stream) {
+    return stream->count;
+}
+
+/**
+ * @brief Nombre de valeurs d'une suite strictement inférieures à value (recherche dichotomique).
+ * value est un long long pour accepter INT_MAX + 1.
+ */
+static int count_below(const SortedRun *run, long long value) {
+    int low = 0, high = run->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (run->values[mid] < value) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief Rang d'une valeur : nombre de valeurs qui lui sont strictement inférieures.
+ *
+ * @param stream Le conteneur.
+ * @param value La valeur.
+ * @return Le nombre de valeurs < value.
+ */
+long long SortedStreamRank(const SortedStream *stream, int value) {
+    long long rank = 0;
+    for (int r = 0; r < stream->nbRuns; r++) rank += count_below(&stream->runs[r], value);
+    return rank;
+}
+
+/**
+ * @brief Nombre de valeurs comprises entre low et high (inclus).
+ */
+long long SortedStreamCountRange(const SortedStream *stream, int low, int high) {
+    if (low > high) return 0;
+    long long count = 0;
+    for (int r = 0; r < stream->nbRuns; r++) {
+        count += count_below(&stream->runs[r], (long long)high + 1) - count_below(&stream->runs[r], low);
+    }
+    return count;
+}
+
+/**
+ * @brief Valeur d'un rang donné dans l'ordre croissant, par dichotomie sur les valeurs : O(32 x suites x log n).
+ *
+ * @param stream Le conteneur.
+ * @param rank Le rang (0 pour la plus petite valeur).
+ * @param value La valeur trouvée.
+ * @return 0 en cas de succès, -1 si le rang est hors du conteneur.
+ */
+int SortedStreamSelect(const SortedStream *stream, long long rank, int *value) {
+    if (rank < 0 || rank >= stream->count) return -1;
+    // Smallest v such that more than rank values are <= v.
+    long long low = INT_MIN, high = INT_MAX;
+    while (low < high) {
+        long long mid = low + (high - low) / 2;
+        long long atMost = 0;
+        for (int r = 0; r < stream->nbRuns; r++) atMost += count_below(&stream->runs[r], mid + 1);
+        if (atMost > rank) high = mid;
+        else low = mid + 1;
+    }
+    *value = (int)low;
+    return 0;
+}
+
+/**
+ * @brief Place un curseur sur les valeurs comprises entre low et high (inclus) ; la plage de chaque suite
+ * est trouvée par dichotomie.
+ *
+ * @param cursor Le curseur.
+ * @param stream Le conteneur.
+ * @param low Borne inférieure (INT_MIN pour tout parcourir).
+ * @param high Borne supérieure (INT_MAX pour tout parcourir).
+ */
+void SortedStreamSeek(SortedStreamCursor *cursor, const SortedStream *stream, int low, int high) {
+    cursor->nbRuns = 0;
+    if (low > high) return;
+    for (int r = 0; r < stream->nbRuns; r++) {
+        const SortedRun *run = &stream->runs[r];
+        int begin = count_below(run, low);
+        int end = count_below(run, (long long)high + 1);
+        if (begin < end) {
+            cursor->next[cursor->nbRuns] = run->values + begin;
+            cursor->end[cursor->nbRuns] = run->values + end;
+            cursor->nbRuns++;
+        }
+    }
+}
+
+/**
+ * @brief Lit la valeur suivante du curseur : la plus petite des têtes de suites. Une suite épuisée est
+ * remplacée par la dernière, si bien que seules les suites restantes sont comparées.
+ *
+ * @param cursor Le curseur.
+ * @param value La valeur lue.
+ * @return 1 si une valeur a été lue, 0 si la plage est épuisée.
+ */
+int SortedStreamNext(SortedStreamCursor *cursor, int *value) {
+    if (cursor->nbRuns == 0) return 0;
+    int best = 0;
+    for (int r = 1; r < cursor->nbRuns; r++) {
+        if (*cursor->next[r] < *cursor->next[best]) best = r;
+    }
+    *value = *cursor->next[best]++;
+    if (cursor->next[best] == cursor->end[best]) {
+        cursor->nbRuns--;
+        cursor->next[best] = cursor->next[cursor->nbRuns];
+        cursor->end[best] = cursor->end[cursor->nbRuns];
+    }
+    return 1;
+}
+
+/**
+ * @brief Taille des lots de OnlineSort : n / 64, entre 8 et SORTED_STREAM_BATCH.
+ */
+int OnlineSortBatch(int n) {
+    int batch = n / 64;
+    if (batch < 8) batch = 8;
+    return batch < SORTED_STREAM_BATCH ? batch : SORTED_STREAM_BATCH;
+}
+
+/**
+ * @brief Tri en ligne : le tableau est inséré par lots dans un conteneur trié, comme des données qui
+ * arrivent au fil de l'eau, puis relu dans l'ordre. Les grandes fusions passent en arrière-plan quand le
+ * profil de réglage prévoit plusieurs threads. Si le conteneur ne peut pas allouer ses suites, le tableau,
+ * resté intact, est trié par le tri rapide parallèle.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void OnlineSort(int tab[], int n) {
+    SortedStream stream;
+    SortedStreamInit(&stream, TuningThreads() > 1);
+    int batch = OnlineSortBatch(n);
+    int status = 0;
+    for (int i = 0; i < n && status == 0; i += batch) {
+        status = SortedStreamInsert(&stream, tab + i, n - i < batch ? n - i : batch);
+    }
+    if (status == 0 && SortedStreamFlush(&stream) == 0 && stream.nbRuns == 1) {
+        memcpy(tab, stream.runs[0].values, (size_t)n * sizeof(int));
+    } else if (n > 1) {
+        ParallelQuickSort(tab, n);
+    }
+    SortedStreamFree(&stream);
+}
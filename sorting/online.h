@@ -0,0 +1,75 @@
+/**
+ * @file sorting/online.h
+ * @brief Conteneur trié alimenté en continu : journal de suites triées fusionnées au fil des insertions (LSM).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef ONLINE_H
+#define ONLINE_H
+
+// Upper bound on the runs of a stream: run lengths at least halve from one run to the next.
+#define SORTED_STREAM_MAX_RUNS 64
+// Merges producing at least this many values run on the stream's worker thread (when enabled).
+#define SORTED_STREAM_BACKGROUND_MIN (1 << 16)
+// Largest batch OnlineSort feeds at once.
+#define SORTED_STREAM_BATCH 4096
+
+typedef struct SortedRun {
+    int *values;
+    int count;
+} SortedRun;
+
+// Called on the inserting thread each time two neighbouring runs are replaced by their merge (background
+// merges included, when their result is installed). start is the number of values in the older runs: laid
+// end to end, the runs hold the merged values at [start, start + count).
+typedef void (*SortedStreamMergeHook)(void *user, long long start, const int merged[], int count);
+
+// Multiset of ints kept sorted as it grows. Every inserted batch is sorted into a new run; a run is merged
+// with the previous one as long as that one is not longer (a binary counter of runs), so every value is
+// merged O(log n) times and reads look at O(log n) runs.
+typedef struct SortedStream {
+    SortedRun runs[SORTED_STREAM_MAX_RUNS]; // oldest (longest) first
+    int nbRuns;
+    long long count;
+    int background;              // large merges run on a worker thread
+    struct ThreadPool *pool;     // one worker, created with the first background merge
+    struct SortedMerge *merge;   // background merge in progress, NULL if none
+    SortedStreamMergeHook onMerge; // NULL if none
+    void *hookUser;
+} SortedStream;
+
+// Ordered read of the values in [low, high], merged on the fly from every run. Invalidated by the next
+// insertion, flush or free of the stream.
+typedef struct SortedStreamCursor {
+    const int *next[SORTED_STREAM_MAX_RUNS];
+    const int *end[SORTED_STREAM_MAX_RUNS];
+    int nbRuns;  // runs not exhausted yet
+} SortedStreamCursor;
+
+// background: merges of at least SORTED_STREAM_BACKGROUND_MIN values are left to a worker thread, and
+// insertions only wait for one when the next large merge needs its result.
+void SortedStreamInit(SortedStream *stream, int background);
+void SortedStreamFree(SortedStream *stream);
+void SortedStreamSetHook(SortedStream *stream, SortedStreamMergeHook onMerge, void *user);
+// Copy, sort and add n values. Returns 0, or -1 on allocation failure.
+int SortedStreamInsert(SortedStream *stream, const int values[], int n);
+// Wait for the background merge and merge every run into one: later reads are plain array scans.
+int SortedStreamFlush(SortedStream *stream);
+
+long long SortedStreamCount(const SortedStream *stream);
+// Number of values smaller than value.
+long long SortedStreamRank(const SortedStream *stream, int value);
+// Number of values in [low, high].
+long long SortedStreamCountRange(const SortedStream *stream, int low, int high);
+// Value with exactly rank smaller values before it in sorted order (0 <= rank < count). Returns 0, or -1.
+int SortedStreamSelect(const SortedStream *stream, long long rank, int *value);
+
+void SortedStreamSeek(SortedStreamCursor *cursor, const SortedStream *stream, int low, int high);
+// Next value in ascending order: returns 1, or 0 once the range is exhausted.
+int SortedStreamNext(SortedStreamCursor *cursor, int *value);
+
+// Batch size OnlineSort feeds an array of n values in (n / 64, between 8 and SORTED_STREAM_BATCH).
+int OnlineSortBatch(int n);
+
+#endif // ONLINE_H
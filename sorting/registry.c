@@ -0,0 +1,136 @@
+#include "registry.h"
+#include "autosort.h"
+#include <stdio.h>
+#include <strings.h>
+
+/**
+ * @file registry.c
+ * @brief Registre des algorithmes de tri.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Ajouter un algorithme revient à écrire ses deux versions (sorting_impl.h et sorting.c) puis à l'inscrire
+ * ici : le menu, les tâches, les mesures, le balayage des tailles et l'analyse de caches le proposent alors
+ * sans autre modification.
+ */
+
+/**
+ * @brief Tri rapide avec la signature (tableau, taille).
+ */
+static void quick_sort_n(int tab[], int n) {
+    QuickSort(tab, 0, n - 1);
+}
+
+/**
+ * @brief Tri par fusion avec la signature (tableau, taille).
+ */
+static void merge_sort_n(int tab[], int n) {
+    MergeSort(tab, 0, n - 1);
+}
+
+/**
+ * @brief Algorithmes inscrits, dans l'ordre du menu : nom, version silencieuse, version instrumentée,
+ * classe de coût, complexités moyenne et dans le pire cas, mémoire auxiliaire, stable, en place, parallèle.
+ */
+static const SortAlgorithm algorithms[] = {
+    { "SelectSort", SelectSort, SelectSort_viz, SORT_COST_QUADRATIC,
+      "n^2", "n^2", "O(1)", 0, 1, 0 },
+    { "BubbleSort", BubbleSort, BubbleSort_viz, SORT_COST_QUADRATIC,
+      "n^2", "n^2", "O(1)", 1, 1, 0 },
+    { "CombSort", CombSort, CombSort_viz, SORT_COST_SUBQUADRATIC,
+      "~n log n", "n^2", "O(1)", 0, 1, 0 },
+    { "InsertionSort", InsertionSort, InsertionSort_viz, SORT_COST_QUADRATIC,
+      "n^2", "n^2", "O(1)", 1, 1, 0 },
+    { "BinaryInsert", BinaryInsertionSort, BinaryInsertionSort_viz, SORT_COST_QUADRATIC,
+      "n^2 moves", "n^2", "O(1)", 1, 1, 0 },
+    { "ShellSort", ShellSort, ShellSort_viz, SORT_COST_SUBQUADRATIC,
+      "~n^1.3", "unproven", "O(1)", 0, 1, 0 },
+    { "QuickSort", quick_sort_n, QuickSort_viz_wrapper, SORT_COST_N_LOG_N,
+      "n log n", "n^2", "O(log n) stack", 0, 1, 0 },
+    { "MergeSort", merge_sort_n, MergeSort_viz_wrapper, SORT_COST_N_LOG_N,
+      "n log n", "n log n", "O(n)", 1, 0, 0 },
+    { "NaturalMerge", NaturalMergeSort, NaturalMergeSort_viz, SORT_COST_N_LOG_N,
+      "n log n", "n log n", "O(n)", 1, 0, 0 },
+    { "BlockMerge", BlockMergeSort, BlockMergeSort_viz, SORT_COST_N_LOG_N,
+      "n log n", "n log n", "O(sqrt n)", 1, 1, 0 },
+    { "CountingSort", CountingSort, CountingSort_viz, SORT_COST_LINEAR,
+      "n + range", "n + range", "O(n + range)", 0, 0, 0 },
+    { "RadixSort", RadixSort, RadixSort_viz, SORT_COST_LINEAR,
+      "n x digits", "n x digits", "O(n)", 1, 0, 0 },
+    { "ParallelSort", ParallelSort, ParallelSort_viz, SORT_COST_N_LOG_N,
+      "n log n / p", "n log n", "O(n)", 1, 0, 1 },
+    { "ParallelQuick", ParallelQuickSort, ParallelQuickSort_viz, SORT_COST_N_LOG_N,
+      "n log n / p", "n^2", "O(log n) stack", 0, 1, 1 },
+    { "OnlineLSM", OnlineSort, OnlineSort_viz, SORT_COST_N_LOG_N,
+      "n log n", "n log n", "O(n)", 0, 0, 1 },
+    { "AutoSort", AutoSort, AutoSort_viz, SORT_COST_N_LOG_N,
+      "n .. n log n", "n^2", "O(n)", 0, 0, 0 },
+};
+
+/**
+ * @brief Getteur du nombre d'algorithmes inscrits.
+ */
+int SortAlgorithmCount(void) {
+    return (int)(sizeof(algorithms) / sizeof(algorithms[0]));
+}
+
+/**
+ * @brief Getteur d'un algorithme inscrit.
+ *
+ * @param index Indice de l'algorithme (0 <= index < SortAlgorithmCount()).
+ * @return L'algorithme, ou NULL si l'indice est invalide.
+ */
+const SortAlgorithm *SortGetAlgorithm(int index) {
+    if (index < 0 || index >= SortAlgorithmCount()) return NULL;
+    return &algorithms[index];
+}
+
+/**
+ * @brief Cherche un algorithme par son nom, sans tenir compte de la casse.
+ *
+ * @param name Le nom.
+ * @return L'algorithme, ou NULL s'il n'est pas inscrit.
+ */
+const SortAlgorithm *SortFindAlgorithm(const char *name) {
+    for (int a = 0; a < SortAlgorithmCount(); a++) {
+        if (strcasecmp(algorithms[a].name, name) == 0) return &algorithms[a];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Indique si l'algorithme vaut la peine d'être lancé sur n éléments : les tris quadratiques sont
+ * écartés au-delà de SORT_QUADRATIC_MAX.
+ *
+ * @param algo L'algorithme.
+ * @param n Le nombre d'éléments.
+ * @return 1 si l'algorithme peut être lancé, 0 sinon.
+ */
+int SortAlgorithmFits(const SortAlgorithm *algo, int n) {
+    return algo->cost != SORT_COST_QUADRATIC || n <= SORT_QUADRATIC_MAX;
+}
+
+/**
+ * @brief Exposant de croissance nominal d'une classe de coût (facteurs logarithmiques omis).
+ */
+double SortCostExponent(SortCost cost) {
+    switch (cost) {
+        case SORT_COST_SUBQUADRATIC: return 1.3;
+        case SORT_COST_QUADRATIC: return 2.0;
+        default: return 1.0;
+    }
+}
+
+/**
+ * @brief Affiche le registre : une ligne par algorithme avec ses complexités et ses propriétés.
+ */
+void SortPrintAlgorithms(void) {
+    printf("%-16s %-13s %-11s %-15s %-7s %-9s %s\n",
+           "Algorithm", "average", "worst", "memory", "stable", "in place", "parallel");
+    for (int a = 0; a < SortAlgorithmCount(); a++) {
+        const SortAlgorithm *algo = &algorithms[a];
+        printf("%-16s %-13s %-11s %-15s %-7s %-9s %s\n", algo->name, algo->average, algo->worst, algo->memory,
+               algo->stable ? "yes" : "no", algo->inPlace ? "yes" : "no", algo->parallel ? "yes" : "no");
+    }
+    printf("Quadratic algorithms are skipped above n = %d.\n", SORT_QUADRATIC_MAX);
+}
@@ -0,0 +1,52 @@
+/**
+ * @file sorting/registry.h
+ * @brief Registre des algorithmes de tri : points d'entrée et propriétés, lu par le menu, les tâches, les
+ * mesures et le choix automatique.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#include "sorting.h"
+
+// Silent sort with the (array, length) signature.
+typedef void (*SortFunction)(int arr[], int n);
+// Instrumented sort with the (array, length, callback) signature.
+typedef void (*VizSortFunction)(int arr[], int n, VizCallback cb);
+
+// Expected running time on a random input: size limits and extrapolations are derived from it.
+typedef enum SortCost {
+    SORT_COST_LINEAR,        // n + range, n x digits
+    SORT_COST_N_LOG_N,
+    SORT_COST_SUBQUADRATIC,  // gap sorts (Shell, comb): measured between n log n and n^2
+    SORT_COST_QUADRATIC
+} SortCost;
+
+// Quadratic algorithms are skipped above this size by the menu, the batch jobs and the benchmark.
+#define SORT_QUADRATIC_MAX (1 << 16)
+
+typedef struct SortAlgorithm {
+    const char *name;
+    SortFunction sort;
+    VizSortFunction sortViz;
+    SortCost cost;
+    const char *average;  // time complexity, as displayed
+    const char *worst;
+    const char *memory;   // auxiliary memory
+    int stable;           // equal keys keep their order
+    int inPlace;          // at most O(sqrt n) auxiliary memory
+    int parallel;         // uses the thread pool: measured without pinning the thread to one CPU
+} SortAlgorithm;
+
+int SortAlgorithmCount(void);
+const SortAlgorithm *SortGetAlgorithm(int index);
+const SortAlgorithm *SortFindAlgorithm(const char *name); // case-insensitive, NULL if unknown
+// 0 when the algorithm is not worth running on n elements (quadratic above SORT_QUADRATIC_MAX).
+int SortAlgorithmFits(const SortAlgorithm *algo, int n);
+// Nominal growth exponent of the cost class (log factors left out), for extrapolations.
+double SortCostExponent(SortCost cost);
+void SortPrintAlgorithms(void);
+
+#endif // REGISTRY_H
@@ -0,0 +1,230 @@
+/**
+ * @file sorting/selection_impl.h
+ * @brief Corps uniques des algorithmes de sélection (k-ième élément, tri partiel, k plus petits).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Comme sorting_impl.h, ce fichier est inclus deux fois par sorting.c et s'appuie sur les mêmes macros
+ * (SORT_FN, SORT_CTX_PARAMS, SORT_CTX_ARGS, SORT_COMPARE, SORT_SWAP).
+ */
+
+#ifndef SELECT_SMALL
+/**
+ * @brief Taille en dessous de laquelle la sélection finit par un tri par insertion.
+ */
+#define SELECT_SMALL 16
+#endif
+
+static void SORT_FN(select_range)(int tab[], int low, int high, int nth, int budget SORT_CTX_PARAMS);
+
+/**
+ * @brief Indice de la médiane des cases low, milieu et high.
+ */
+static int SORT_FN(median_of_three)(int tab[], int low, int high SORT_CTX_PARAMS) {
+    int mid = low + (high - low) / 2;
+    SORT_COMPARE(low, mid);
+    if (tab[low] > tab[mid]) {
+        int t = low; low = mid; mid = t;
+    }
+    // Now tab[low] <= tab[mid].
+    SORT_COMPARE(mid, high);
+    if (tab[mid] <= tab[high]) return mid;
+    SORT_COMPARE(low, high);
+    return tab[low] > tab[high] ? low : high;
+}
+
+/**
+ * @brief Médiane des médianes : trie chaque groupe de 5, ramène les médianes en tête de la zone et
+ * sélectionne leur médiane. Le pivot obtenu garantit une sélection en temps linéaire.
+ *
+ * @return L'indice du pivot.
+ */
+static int SORT_FN(median_of_medians)(int tab[], int low, int high SORT_CTX_PARAMS) {
+    int count = 0;
+    for (int group = low; group <= high; group += 5) {
+        int end = group + 4 <= high ? group + 4 : high;
+        SORT_FN(insertion_range)(tab, group, end SORT_CTX_ARGS);
+
+        int median = group + (end - group) / 2;
+        int dest = low + count;
+        if (dest != median) {
+            int temp = tab[dest];
+            tab[dest] = tab[median];
+            tab[median] = temp;
+            SORT_SWAP(dest, median);
+        }
+        count++;
+    }
+
+    int mid = low + (count - 1) / 2;
+    SORT_FN(select_range)(tab, low, low + count - 1, mid, -1 SORT_CTX_ARGS);
+    return mid;
+}
+
+/**
+ * @brief Introselect : sélection rapide avec pivot médiane de trois, puis médiane des médianes une fois
+ * le budget de partitions épuisé. La partition en trois zones (<, =, >) absorbe les doublons.
+ *
+ * @param tab Tableau.
+ * @param low Indice de début de la zone.
+ * @param high Indice de fin de la zone.
+ * @param nth Indice à placer (low <= nth <= high).
+ * @param budget Partitions autorisées avant le repli (négatif : médiane des médianes dès le départ).
+ */
+static void SORT_FN(select_range)(int tab[], int low, int high, int nth, int budget SORT_CTX_PARAMS) {
+    while (high - low > SELECT_SMALL) {
+        int p;
+        if (budget > 0) {
+            budget--;
+            p = SORT_FN(median_of_three)(tab, low, high SORT_CTX_ARGS);
+        } else {
+            p = SORT_FN(median_of_medians)(tab, low, high SORT_CTX_ARGS);
+        }
+        int pivot = tab[p];
+
+        int lt = low, i = low, gt = high;
+        while (i <= gt) {
+            SORT_COMPARE(i, lt);
+            if (tab[i] < pivot) {
+                int temp = tab[lt];
+                tab[lt] = tab[i];
+                tab[i] = temp;
+                SORT_SWAP(lt, i);
+                lt++;
+                i++;
+            } else if (tab[i] > pivot) {
+                int temp = tab[gt];
+                tab[gt] = tab[i];
+                tab[i] = temp;
+                SORT_SWAP(i, gt);
+                gt--;
+            } else {
+                i++;
+            }
+        }
+
+        if (nth < lt) {
+            high = lt - 1;
+        } else if (nth > gt) {
+            low = gt + 1;
+        } else {
+            return;
+        }
+    }
+    SORT_FN(insertion_range)(tab, low, high SORT_CTX_ARGS);
+}
+
+/**
+ * @brief Place le k-ième plus petit élément à l'indice nth ; les éléments avant lui sont inférieurs ou
+ * égaux, ceux après supérieurs ou égaux.
+ *
+ * @param tab Tableau.
+ * @param n Nombre d'éléments.
+ * @param nth Indice à placer.
+ */
+static void SORT_FN(nth_element)(int tab[], int n, int nth SORT_CTX_PARAMS) {
+    if (n <= 1 || nth < 0 || nth >= n) return;
+    int budget = 0;
+    for (int m = n; m > 1; m >>= 1) budget += 2;
+    SORT_FN(select_range)(tab, 0, n - 1, nth, budget SORT_CTX_ARGS);
+}
+
+/**
+ * @brief Descente dans un tas max stocké dans les cases base à base + size - 1.
+ */
+static void SORT_FN(heap_sift_down)(int tab[], int base, int root, int size SORT_CTX_PARAMS) {
+    for (;;) {
+        int child = 2 * root + 1;
+        if (child >= size) break;
+        if (child + 1 < size) {
+            SORT_COMPARE(base + child, base + child + 1);
+            if (tab[base + child + 1] > tab[base + child]) child++;
+        }
+        SORT_COMPARE(base + root, base + child);
+        if (tab[base + root] >= tab[base + child]) break;
+
+        int temp = tab[base + root];
+        tab[base + root] = tab[base + child];
+        tab[base + child] = temp;
+        SORT_SWAP(base + root, base + child);
+        root = child;
+    }
+}
+
+/**
+ * @brief Remontée du nœud node dans un tas max stocké à partir de la case base.
+ */
+static void SORT_FN(heap_sift_up)(int tab[], int base, int node SORT_CTX_PARAMS) {
+    while (node > 0) {
+        int parent = (node - 1) / 2;
+        SORT_COMPARE(base + parent, base + node);
+        if (tab[base + parent] >= tab[base + node]) break;
+
+        int temp = tab[base + parent];
+        tab[base + parent] = tab[base + node];
+        tab[base + node] = temp;
+        SORT_SWAP(base + parent, base + node);
+        node = parent;
+    }
+}
+
+/**
+ * @brief Transforme un tas max de size éléments (à partir de la case base) en suite croissante.
+ */
+static void SORT_FN(heap_extract_all)(int tab[], int base, int size SORT_CTX_PARAMS) {
+    for (int end = size - 1; end > 0; end--) {
+        int temp = tab[base];
+        tab[base] = tab[base + end];
+        tab[base + end] = temp;
+        SORT_SWAP(base, base + end);
+        SORT_FN(heap_sift_down)(tab, base, 0, end SORT_CTX_ARGS);
+    }
+}
+
+/**
+ * @brief Tri partiel : les k plus petits éléments, triés, aux indices 0 à k - 1 ; le reste est dans un
+ * ordre quelconque. Introselect isole les k plus petits, puis un tri par tas les ordonne : O(n + k log k).
+ *
+ * @param tab Tableau.
+ * @param n Nombre d'éléments.
+ * @param k Nombre d'éléments à ordonner.
+ */
+static void SORT_FN(partial_sort)(int tab[], int n, int k SORT_CTX_PARAMS) {
+    if (k <= 0 || n <= 0) return;
+    if (k > n) k = n;
+    if (k < n) SORT_FN(nth_element)(tab, n, k - 1 SORT_CTX_ARGS);
+
+    for (int i = k / 2 - 1; i >= 0; i--) {
+        SORT_FN(heap_sift_down)(tab, 0, i, k SORT_CTX_ARGS);
+    }
+    SORT_FN(heap_extract_all)(tab, 0, k SORT_CTX_ARGS);
+}
+
+/**
+ * @brief k plus petits éléments en un seul passage, comme sur un flux : un tas max borné à k éléments
+ * (cases 0 à k - 1) garde les meilleurs vus jusque-là ; O(n log k), sans mémoire supplémentaire.
+ * Les k plus petits finissent triés en tête du tableau.
+ *
+ * @param tab Tableau.
+ * @param n Nombre d'éléments.
+ * @param k Nombre d'éléments à garder.
+ */
+static void SORT_FN(top_k)(int tab[], int n, int k SORT_CTX_PARAMS) {
+    if (k <= 0 || n <= 0) return;
+    if (k > n) k = n;
+
+    for (int j = 1; j < k; j++) {
+        SORT_FN(heap_sift_up)(tab, 0, j SORT_CTX_ARGS);
+    }
+    for (int j = k; j < n; j++) {
+        SORT_COMPARE(j, 0);
+        if (tab[j] < tab[0]) {
+            int temp = tab[0];
+            tab[0] = tab[j];
+            tab[j] = temp;
+            SORT_SWAP(0, j);
+            SORT_FN(heap_sift_down)(tab, 0, 0, k SORT_CTX_ARGS);
+        }
+    }
+    SORT_FN(heap_extract_all)(tab, 0, k SORT_CTX_ARGS);
+}
@@ -1,406 +1,1098 @@
-#include "sorting.h"
-#include "../utils/utils.h"
-#include <stdio.h>
-#include <stdlib.h>
-#include <stdbool.h>
-
-/**
- * @brief Tri par sélection. Il va chercher l'élément minimum dans le tableau non trié et le place au début.
- *
- * @param tab Tableau à trier.
- * @param n Nombre d'éléments dans le tableau.
- */
-void SelectSort(int tab[], int n) {
-    for (int i = 0; i < n - 1; i++) {
-        int index = i;
-        for (int j = i + 1; j < n; j++) {
-            if (tab[j] < tab[index]) {
-                index = j;
-            }
-        }
-        if (index != i) {
-            int temp = tab[i];
-            tab[i] = tab[index];
-            tab[index] = temp;
-        }
-    }
-
-    PrintTab(tab, n);
-}
-
-/**
- * @brief Tri à bulles. Il compare chaque paire d'éléments adjacents et les échange s'ils sont supérieurs ou inférieurs entre eux.
- * 
- * @param tab Tableau à trier.
- * @param n Nombre d'éléments dans le tableau.
- */
-void BubbleSort(int tab[], int n) {
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - i - 1; j++) {
-            if (tab[j] > tab[j + 1]) {
-                int temp = tab[j];
-                tab[j] = tab[j + 1];
-                tab[j + 1] = temp;
-            }
-        }
-    }
-
-    PrintTab(tab, n);
-}
-
-/**
- * @brief Tri par insertion. Il construit le tableau trié un élément à la fois en insérant chaque nouvel élément à sa position correcte.
- * 
- * @param tab Tableau à trier.
- * @param n Nombre d'éléments dans le tableau.
- */
-void InsertionSort(int tab[], int n) {
-    for (int i = 1; i < n; i++) {
-        int key = tab[i];
-        int j = i - 1;
-        while (j >= 0 && tab[j] > key) {
-            tab[j + 1] = tab[j];
-            j--;
-        }
-        tab[j + 1] = key;
-    }
-
-    PrintTab(tab, n);
-}
-
-/**
- * @brief Tri rapide (QuickSort). Il utilise la méthode du pivot pour diviser le tableau en sous-tableaux.
- * 
- * @param tab Tableau à trier.
- * @param low Indice de début.
- * @param high Indice de fin.
- */
-void QuickSort(int tab[], int low, int high) {
-    if (low < high) {
-        int pivot = tab[high];
-        int i = (low - 1);
-        for (int j = low; j < high; j++) {
-            if (tab[j] < pivot) {
-                i++;
-                int temp = tab[i];
-                tab[i] = tab[j];
-                tab[j] = temp;
-            }
-        }
-        int temp = tab[i + 1];
-        tab[i + 1] = tab[high];
-        tab[high] = temp;
-        int pi = i + 1;
-
-        QuickSort(tab, low, pi - 1);
-        QuickSort(tab, pi + 1, high);
-    }
-
-    PrintTab(tab, high - low + 1);
-}
-
-/**
- * @brief Fusionne deux sous-tableaux pour le tri par fusion.
- * 
- * @param tab Tableau à trier.
- * @param left Indice de début.
- * @param mid Indice du milieu.
- * @param right Indice de fin.
- */
-void Merge(int tab[], int left, int mid, int right) {
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
-
-    int* L = (int*)malloc(n1 * sizeof(int));
-    int* R = (int*)malloc(n2 * sizeof(int));
-
-    for (int i = 0; i < n1; i++)
-        L[i] = tab[left + i];
-    for (int j = 0; j < n2; j++)
-        R[j] = tab[mid + 1 + j];
-
-    int i = 0;
-    int j = 0;
-    int k = left;
-    while (i < n1 && j < n2) {
-        if (L[i] <= R[j]) {
-            tab[k] = L[i];
-            i++;
-        } else {
-            tab[k] = R[j];
-            j++;
-        }
-        k++;
-    }
-
-    while (i < n1) {
-        tab[k] = L[i];
-        i++;
-        k++;
-    }
-
-    while (j < n2) {
-        tab[k] = R[j];
-        j++;
-        k++;
-    }
-
-    free(L);
-    free(R);
-}
-
-/**
- * @brief Tri par fusion (MergeSort). Il divise le tableau en deux moitiés, trie chaque moitié et les fusionne.
- * 
- * @param tab Tableau à trier.
- * @param left Indice de début.
- * @param right Indice de fin.
- */
-void MergeSort(int tab[], int left, int right) {
-    if (left < right) {
-        int mid = left + (right - left) / 2;
-
-        MergeSort(tab, left, mid);
-        MergeSort(tab, mid + 1, right);
-
-        Merge(tab, left, mid, right);
-    }
-
-    PrintTab(tab, right - left + 1);
-}
-
-
-// ------------------------- Versions instrumentées -------------------------
-// Se sont les même fonctions que précédemment, mais avec un callback de visualisation.
-// afin d'afficher les comparaisons et les échanges de positions pas à pas.
-// Cela me permet d'utiliser une méthode de visualisation générique pour tous les algorithmes de tri, 
-// en passant la fonction de tri appropriée en paramètre.
-// M'évitant de dupliquer le code de gestion de la fenêtre SDL et du rendu graphique pour chaque algorithme de tri.
-
-/**
- * @brief Tri par sélection prévue pour la visualisation.
- * 
- * @param tab Tableau à trier.
- * @param n Nombre d'éléments dans le tableau.
- * @param cb Callback de visualisation.
- */
-void SelectSort_viz(int tab[], int n, VizCallback cb) {
-    for (int i = 0; i < n - 1; i++) {
-        int index = i;
-        for (int j = i + 1; j < n; j++) {
-            if (cb) cb(tab, n, index, j); // show comparison
-            if (tab[j] < tab[index]) {
-                index = j;
-            }
-        }
-        if (index != i) {
-            int temp = tab[i];
-            tab[i] = tab[index];
-            tab[index] = temp;
-            if (cb) cb(tab, n, i, index); // show swap
-        }
-    }
-}
-
-/**
- * @brief Tri à bulles prévu pour la visualisation.
- * 
- * @param tab Tableau à trier.
- * @param n Nombre d'éléments dans le tableau.
- * @param cb Callback de visualisation.
- */
-void BubbleSort_viz(int tab[], int n, VizCallback cb) {
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - i - 1; j++) {
-            if (cb) 
-                cb(tab, n, j, j+1); // comparison
-            if (tab[j] > tab[j + 1]) {
-                int temp = tab[j];
-                tab[j] = tab[j + 1];
-                tab[j + 1] = temp;
-                if (cb) 
-                    cb(tab, n, j, j+1); // swap
-            }
-        }
-    }
-}
-
-/**
- * @brief Tri par insertion prévu pour la visualisation.
- * 
- * @param tab Tableau à trier.
- * @param n Nombre d'éléments dans le tableau.
- * @param cb Callback de visualisation.
- */
-void InsertionSort_viz(int tab[], int n, VizCallback cb) {
-    for (int i = 1; i < n; i++) {
-        int key = tab[i];
-        int j = i - 1;
-        while (j >= 0) {
-            if (cb) cb(tab, n, j, i);
-            if (tab[j] > key) {
-                tab[j + 1] = tab[j];
-                j--;
-                if (cb) cb(tab, n, j+1, j+2);
-            } else {
-                break;
-            }
-        }
-        tab[j + 1] = key;
-        if (cb) cb(tab, n, j+1, i);
-    }
-}
-
-/**
- * @brief Fonction récursive de tri rapide prévue pour la visualisation. La méthode permet de garder la taille totale du tableau pour le callback de visualisation.
- * 
- * @param tab Tableau à trier.
- * @param low Indice de début.
- * @param high Indice de fin.
- * @param total_n Taille totale du tableau pour le callback.
- * @param cb Callback de visualisation.
- */
-static void QuickSort_viz_rec(int tab[], int low, int high, int total_n, VizCallback cb) {
-    if (low < high) {
-        int pivot = tab[high];
-        int i = (low - 1);
-        for (int j = low; j < high; j++) {
-            if (cb) cb(tab, total_n, j, high);
-            if (tab[j] < pivot) {
-                i++;
-                int temp = tab[i];
-                tab[i] = tab[j];
-                tab[j] = temp;
-                if (cb) cb(tab, total_n, i, j);
-            }
-        }
-        int temp = tab[i + 1];
-        tab[i + 1] = tab[high];
-        tab[high] = temp;
-        if (cb) cb(tab, total_n, i+1, high);
-
-        QuickSort_viz_rec(tab, low, i - 0, total_n, cb);
-        QuickSort_viz_rec(tab, i + 2, high, total_n, cb);
-    }
-}
-
-/**
- * @brief Tri rapide prévu pour la visualisation.
- * 
- * @param tab Tableau à trier.
- * @param debut Indice de début.
- * @param fin Indice de fin.
- */
-void QuickSort_viz(int tab[], int debut, int fin, VizCallback cb) {
-    // Not used directly for wrapper; keep signature for compatibility.
-    QuickSort_viz_rec(tab, debut, fin, fin - debut + 1, cb);
-}
-
-/**
- * @brief Wrapper pour le tri rapide prévu pour la visualisation.
- * 
- * @param tab Tableau à trier.
- * @param n Nombre d'éléments dans le tableau.
- * @param cb Callback de visualisation.
- */
-void QuickSort_viz_wrapper(int tab[], int n, VizCallback cb) {
-    QuickSort_viz_rec(tab, 0, n - 1, n, cb);
-}
-
-/**
- * @brief Fusionne deux sous-tableaux pour le tri par fusion prévu pour la visualisation.
- * 
- * @param tab Tableau à trier.
- * @param gauche Indice de début.
- * @param centre Indice du milieu.
- * @param droite Indice de fin.
- * @param total_n Taille totale du tableau pour le callback.
- * @param cb Callback de visualisation.
- */
-static void Merge_viz(int tab[], int gauche, int centre, int droite, int total_n, VizCallback cb) {
-    int n1 = centre - gauche + 1;
-    int n2 = droite - centre;
-
-    int* Gauche = (int*)malloc(n1 * sizeof(int));
-    int* Droite = (int*)malloc(n2 * sizeof(int));
-
-    for (int i = 0; i < n1; i++)
-        Gauche[i] = tab[gauche + i];
-    for (int j = 0; j < n2; j++)
-        Droite[j] = tab[centre + 1 + j];
-
-    int i = 0;
-    int j = 0;
-    int k = gauche;
-    while (i < n1 && j < n2) {
-        if (cb) cb(tab, total_n, k, centre+1+j);
-            if (Gauche[i] <= Droite[j]) {
-                tab[k] = Gauche[i];
-                i++;
-            } else {
-                tab[k] = Droite[j];
-                j++;
-            }
-        if (cb) 
-            cb(tab, total_n, k, k);
-        k++;
-    }
-
-    while (i < n1) {
-        tab[k] = Gauche[i];
-        i++;
-        k++;
-        if (cb) 
-            cb(tab, total_n, k-1, k-1);
-    }
-
-    while (j < n2) {
-        tab[k] = Droite[j];
-        j++;
-        k++;
-    if (cb) 
-        cb(tab, total_n, k-1, k-1);
-    }
-
-    free(Gauche);
-    free(Droite);
-}
-
-/**
- * @brief Fonction récursive de tri par fusion prévue pour la visualisation. La méthode permet de garder la taille totale du tableau pour le callback de visualisation.
- * 
- * @param tab Tableau à trier.
- * @param gauche Indice de début.
- * @param droite Indice de fin.
- * @param total_n Taille totale du tableau pour le callback.
- * @param cb Callback de visualisation.
- */
-static void MergeSort_viz_rec(int tab[], int gauche, int droite, int total_n, VizCallback cb) {
-    if (gauche < droite) {
-        int centre = gauche + (droite - gauche) / 2;
-
-        MergeSort_viz_rec(tab, gauche, centre, total_n, cb);
-        MergeSort_viz_rec(tab, centre + 1, droite, total_n, cb);
-
-        Merge_viz(tab, gauche, centre, droite, total_n, cb);
-    }
-}
-
-/**
- * @brief Tri par fusion prévu pour la visualisation.
- * 
- * @param tab Tableau à trier.
- * @param n Nombre d'éléments dans le tableau.
- * @param cb Callback de visualisation.
- */
-void MergeSort_viz_wrapper(int tab[], int n, VizCallback cb) {
-    MergeSort_viz_rec(tab, 0, n - 1, n, cb);
-}
-
-
-
-
-
-
-
-
+#include "sorting.h"
+#include "tuning.h"
+#include "events.h"
+#include "online.h"
+#include "../stats/stats.h"
+#include "../utils/alloc.h"
+#include "../utils/threadpool.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// Chaque algorithme est écrit une seule fois dans sorting_impl.h, puis instancié deux fois :
+// une version silencieuse dont les hooks disparaissent à la compilation, et une version
+// instrumentée dont les hooks alimentent les compteurs de stats et le callback de visualisation
+// (affichage, enregistrement de trace, export...).
+
+// ------------------------- Versions silencieuses -------------------------
+
+#define SORT_FN(name) name
+#define SORT_CTX_PARAMS
+#define SORT_CTX_ARGS
+#define SORT_COMPARE(a, b) ((void)0)
+#define SORT_SWAP(a, b) ((void)0)
+#define SORT_WRITE(i, hl) ((void)0)
+#define SORT_WRITE_RANGE(low, len) ((void)0)
+#define SORT_SWAP_BLOCK(a, b, len) ((void)0)
+#define SORT_REVERSE(low, high) ((void)0)
+#include "sorting_impl.h"
+#include "selection_impl.h"
+#undef SORT_FN
+#undef SORT_CTX_PARAMS
+#undef SORT_CTX_ARGS
+#undef SORT_COMPARE
+#undef SORT_SWAP
+#undef SORT_WRITE
+#undef SORT_WRITE_RANGE
+#undef SORT_SWAP_BLOCK
+#undef SORT_REVERSE
+
+/**
+ * @brief Tri par sélection.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void SelectSort(int tab[], int n) {
+    select_sort(tab, n);
+}
+
+/**
+ * @brief Tri à bulles.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void BubbleSort(int tab[], int n) {
+    bubble_sort(tab, n);
+}
+
+/**
+ * @brief Tri à peigne.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void CombSort(int tab[], int n) {
+    comb_sort(tab, n);
+}
+
+/**
+ * @brief Tri par insertion.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void InsertionSort(int tab[], int n) {
+    insertion_sort(tab, n);
+}
+
+/**
+ * @brief Tri par insertion dichotomique.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void BinaryInsertionSort(int tab[], int n) {
+    binary_insertion_sort(tab, n);
+}
+
+/**
+ * @brief Tri de Shell (écarts de Ciura).
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void ShellSort(int tab[], int n) {
+    shell_sort(tab, n);
+}
+
+/**
+ * @brief Tri rapide : pivot médiane de trois (ou de neuf), partition de Hoare et pile bornée (O(log n)
+ * niveaux), y compris sur les entrées triées, inversées ou aux valeurs toutes égales.
+ *
+ * @param tab Tableau à trier.
+ * @param low Indice de début.
+ * @param high Indice de fin.
+ */
+void QuickSort(int tab[], int low, int high) {
+    quick_sort_range(tab, low, high);
+}
+
+/**
+ * @brief Tri par fusion dont les tampons de fusion sont servis par une arène : à chaque instant, seuls les
+ * deux tampons de la fusion en cours existent (libérés dans l'ordre inverse), une arène de la taille de la
+ * zone suffit donc et le tri ne fait qu'une allocation au lieu de deux par fusion.
+ */
+static void merge_sort_scratch(int tab[], int left, int right) {
+    int n = right - left + 1;
+    size_t sizes[2] = { (size_t)(n + 1) / 2 * sizeof(int), (size_t)(n / 2) * sizeof(int) };
+    Arena arena;
+    if (n - 1 < GetTuning()->insertionCutoff || n < 2 || ArenaInit(&arena, ArenaFootprint(sizes, 2)) != 0) {
+        merge_sort(tab, left, right);
+        return;
+    }
+
+    Allocator scratch = ArenaAllocator(&arena);
+    Allocator previous = AllocSetBackend(&scratch);
+    merge_sort(tab, left, right);
+    AllocSetBackend(&previous);
+    ArenaRelease(&arena);
+}
+
+/**
+ * @brief Tri par fusion.
+ *
+ * @param tab Tableau à trier.
+ * @param left Indice de début.
+ * @param right Indice de fin.
+ */
+void MergeSort(int tab[], int left, int right) {
+    merge_sort_scratch(tab, left, right);
+}
+
+/**
+ * @brief Tri par fusion naturel (suites déjà triées exploitées).
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void NaturalMergeSort(int tab[], int n) {
+    natural_merge_sort(tab, n);
+}
+
+/**
+ * @brief Tampon de travail du tri par fusion par blocs, sur la pile : suffisant pour les rangs des blocs et
+ * un cache de racine(n) éléments jusqu'à environ 2^18 éléments ; au-delà, le tampon est alloué.
+ */
+#define BLOCK_MERGE_STACK 1024
+
+/**
+ * @brief Tri par fusion par blocs, stable et en place : O(n log n) avec O(racine(n)) mémoire supplémentaire
+ * (sur la pile jusqu'à environ 2^18 éléments).
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void BlockMergeSort(int tab[], int n) {
+    int stack[BLOCK_MERGE_STACK];
+    int need = 2 * (int_sqrt(n) + 3);
+    if (need <= BLOCK_MERGE_STACK) {
+        block_merge_sort(tab, n, stack, BLOCK_MERGE_STACK);
+        return;
+    }
+
+    int *buffer = (int*)SortMalloc(need * sizeof(int));
+    if (buffer == NULL) {
+        // Still sorted, by rotations only.
+        fprintf(stderr, "Memory allocation failed\n");
+        block_merge_sort(tab, n, NULL, 0);
+        return;
+    }
+    block_merge_sort(tab, n, buffer, need);
+    SortFree(buffer);
+}
+
+/**
+ * @brief Tri par fusion par blocs avec un tampon fourni. Avec au moins 2 * (racine(n) + 3) cases, O(n log n) ;
+ * les cases en plus accélèrent les petites fusions ; sans tampon (size 0), O(1) mémoire et O(n log² n).
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param buffer Tampon de travail, ou NULL.
+ * @param size Nombre de cases du tampon.
+ */
+void BlockMergeSortBuffer(int tab[], int n, int buffer[], int size) {
+    block_merge_sort(tab, n, buffer, size);
+}
+
+/**
+ * @brief Tri par dénombrement (clés denses).
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void CountingSort(int tab[], int n) {
+    counting_sort(tab, n);
+}
+
+/**
+ * @brief Tri par base, chiffres de radixBits bits (voir tuning.h).
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void RadixSort(int tab[], int n) {
+    radix_sort(tab, n, GetTuning()->radixBits);
+}
+
+/**
+ * @brief Inverse l'ordre du tableau.
+ *
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void ReverseArray(int tab[], int n) {
+    reverse_range(tab, 0, n - 1);
+}
+
+/**
+ * @brief Place le k-ième plus petit élément à l'indice nth (introselect).
+ *
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param nth Indice à placer.
+ */
+void NthElement(int tab[], int n, int nth) {
+    nth_element(tab, n, nth);
+}
+
+/**
+ * @brief Trie uniquement les k plus petits éléments, placés en tête du tableau.
+ *
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param k Nombre d'éléments à ordonner.
+ */
+void PartialSort(int tab[], int n, int k) {
+    partial_sort(tab, n, k);
+}
+
+/**
+ * @brief k plus petits éléments en un passage avec un tas borné, triés en tête du tableau.
+ *
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param k Nombre d'éléments à garder.
+ */
+void TopK(int tab[], int n, int k) {
+    top_k(tab, n, k);
+}
+
+/**
+ * @brief Prépare un flux de k plus petits éléments.
+ *
+ * @param stream Le flux.
+ * @param k Nombre d'éléments à garder.
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+int TopKStreamInit(TopKStream *stream, int k) {
+    stream->k = k > 0 ? k : 0;
+    stream->count = 0;
+    stream->heap = NULL;
+    if (stream->k == 0) return 0;
+
+    stream->heap = (int*)SortMalloc(stream->k * sizeof(int));
+    if (stream->heap == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        stream->k = 0;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Ajoute un bloc de valeurs au flux ; seule la mémoire du tas (k éléments) est conservée.
+ *
+ * @param stream Le flux.
+ * @param values Les valeurs du bloc.
+ * @param n Le nombre de valeurs.
+ */
+void TopKStreamPush(TopKStream *stream, const int values[], int n) {
+    int *heap = stream->heap;
+    for (int i = 0; i < n; i++) {
+        if (stream->count < stream->k) {
+            heap[stream->count] = values[i];
+            heap_sift_up(heap, 0, stream->count);
+            stream->count++;
+        } else if (stream->k > 0 && values[i] < heap[0]) {
+            heap[0] = values[i];
+            heap_sift_down(heap, 0, 0, stream->k);
+        }
+    }
+}
+
+/**
+ * @brief Copie les k plus petits éléments vus jusque-là, en ordre croissant. Le flux reste utilisable.
+ *
+ * @param stream Le flux.
+ * @param out Tableau d'au moins k cases.
+ * @return Le nombre d'éléments copiés (min(k, nombre de valeurs reçues)).
+ */
+int TopKStreamResult(const TopKStream *stream, int out[]) {
+    if (stream->count == 0) return 0;  // heap is NULL when k == 0
+    memcpy(out, stream->heap, stream->count * sizeof(int));
+    heap_extract_all(out, 0, stream->count);
+    return stream->count;
+}
+
+/**
+ * @brief Libère un flux de k plus petits éléments.
+ */
+void TopKStreamFree(TopKStream *stream) {
+    SortFree(stream->heap);
+    stream->heap = NULL;
+    stream->k = 0;
+    stream->count = 0;
+}
+
+/**
+ * @brief Taille des blocs du tri parallèle : au moins parallelGrain éléments, et environ quatre blocs par
+ * thread pour équilibrer la charge.
+ */
+static int parallel_chunk(int n, int threads) {
+    int grain = GetTuning()->parallelGrain;
+    long chunk = ((long)n + threads * 4L - 1) / (threads * 4L);
+    return chunk > grain ? (int)chunk : grain;
+}
+
+/**
+ * @brief Zone confiée à un thread du tri parallèle : tri des cases low à high, ou fusion des zones
+ * low..mid et mid+1..high.
+ */
+typedef struct ParallelTask {
+    int *tab;
+    int low, mid, high;
+} ParallelTask;
+
+static void parallel_sort_task(void *arg) {
+    ParallelTask *task = (ParallelTask*)arg;
+    merge_sort_scratch(task->tab, task->low, task->high);
+}
+
+static void parallel_merge_task(void *arg) {
+    ParallelTask *task = (ParallelTask*)arg;
+    merge(task->tab, task->low, task->mid, task->high);
+}
+
+/**
+ * @brief Soumet une tâche à la réserve, ou l'exécute sur place si elle n'a pas pu être mise en file.
+ */
+static void parallel_submit(ThreadPool *pool, ThreadTask run, ParallelTask *task) {
+    if (ThreadPoolSubmit(pool, run, task) != 0) run(task);
+}
+
+/**
+ * @brief Tri par fusion parallèle. Le tableau est découpé en blocs triés par les threads de la réserve,
+ * puis fusionnés deux à deux, chaque niveau de fusions étant lui aussi réparti entre les threads.
+ * Le nombre de threads et la taille minimale des blocs viennent du profil de réglage (voir tuning.h) ;
+ * sous deux blocs, le tri par fusion séquentiel est utilisé.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void ParallelSort(int tab[], int n) {
+    int threads = TuningThreads();
+    if (threads <= 1 || n < 2 * GetTuning()->parallelGrain) {
+        merge_sort_scratch(tab, 0, n - 1);
+        return;
+    }
+
+    int chunk = parallel_chunk(n, threads);
+    int nbChunks = (int)(((long)n + chunk - 1) / chunk);
+    ParallelTask *tasks = (ParallelTask*)SortMalloc(nbChunks * sizeof(ParallelTask));
+    ThreadPool *pool = tasks ? ThreadPoolCreate(threads) : NULL;
+    if (pool == NULL) {
+        SortFree(tasks);
+        merge_sort_scratch(tab, 0, n - 1);
+        return;
+    }
+
+    for (int c = 0; c < nbChunks; c++) {
+        long high = (long)(c + 1) * chunk - 1;
+        tasks[c] = (ParallelTask){ tab, c * chunk, 0, high < n ? (int)high : n - 1 };
+        parallel_submit(pool, parallel_sort_task, &tasks[c]);
+    }
+    ThreadPoolWait(pool);
+
+    for (long width = chunk; width < n; width *= 2) {
+        int count = 0;
+        for (long low = 0; low + width < n; low += 2 * width) {
+            long high = low + 2 * width - 1;
+            tasks[count] = (ParallelTask){ tab, (int)low, (int)(low + width - 1), high < n ? (int)high : n - 1 };
+            parallel_submit(pool, parallel_merge_task, &tasks[count]);
+            count++;
+        }
+        ThreadPoolWait(pool);
+    }
+
+    ThreadPoolDestroy(pool);
+    SortFree(tasks);
+}
+
+/**
+ * @brief Contexte du tri rapide parallèle : la réserve, les descripteurs de tâches (distribués sous verrou)
+ * et les participants de la partition par blocs.
+ */
+typedef struct QuickShared QuickShared;
+
+/**
+ * @brief Zone low..high confiée à une tâche du tri rapide parallèle.
+ */
+typedef struct QuickTask {
+    QuickShared *shared;
+    int low, high;
+} QuickTask;
+
+/**
+ * @brief Participant w d'une partition par blocs.
+ */
+typedef struct PartitionTask {
+    BlockPartition *part;
+    int w;
+} PartitionTask;
+
+struct QuickShared {
+    int *tab;
+    int grain;
+    ThreadPool *pool;
+    int threads;
+    QuickTask *tasks;
+    int capacity;
+    int used;
+    pthread_mutex_t lock;
+    PartitionTask *workers;  // threads entries
+    int *leftover;           // 2 * threads entries
+};
+
+static void partition_task(void *arg) {
+    PartitionTask *task = (PartitionTask*)arg;
+    partition_worker(task->part, task->w);
+}
+
+/**
+ * @brief Partition de la zone low..high par tous les threads de la réserve : les participants neutralisent
+ * des blocs pris aux deux bords, puis le thread appelant range les blocs restants et partitionne le milieu.
+ *
+ * @return L'indice du pivot.
+ */
+static int parallel_partition(QuickShared *shared, int low, int high) {
+    BlockPartition part;
+    int nbWorkers = shared->threads;
+    if (nbWorkers > (high - low) / (2 * PARTITION_BLOCK)) nbWorkers = (high - low) / (2 * PARTITION_BLOCK);
+    partition_begin(&part, shared->tab, low, high, nbWorkers, shared->leftover);
+    for (int w = 0; w < nbWorkers; w++) {
+        shared->workers[w] = (PartitionTask){ &part, w };
+        if (ThreadPoolSubmit(shared->pool, partition_task, &shared->workers[w]) != 0) {
+            partition_task(&shared->workers[w]);
+        }
+    }
+    ThreadPoolWait(shared->pool);
+    return partition_finish(&part);
+}
+
+/**
+ * @brief Réserve un descripteur de tâche pour la zone low..high.
+ *
+ * @return Le descripteur, ou NULL s'ils sont tous pris (la zone est alors triée par l'appelant).
+ */
+static QuickTask *quick_task_reserve(QuickShared *shared, int low, int high) {
+    QuickTask *task = NULL;
+    pthread_mutex_lock(&shared->lock);
+    if (shared->used < shared->capacity) task = &shared->tasks[shared->used++];
+    pthread_mutex_unlock(&shared->lock);
+    if (task != NULL) *task = (QuickTask){ shared, low, high };
+    return task;
+}
+
+static void quick_task(void *arg);
+
+/**
+ * @brief Confie la zone low..high à une nouvelle tâche, ou la trie sur place faute de descripteur.
+ */
+static void quick_spawn(QuickShared *shared, int low, int high) {
+    QuickTask *task = quick_task_reserve(shared, low, high);
+    if (task == NULL || ThreadPoolSubmit(shared->pool, quick_task, task) != 0) {
+        quick_sort_range(shared->tab, low, high);
+    }
+}
+
+/**
+ * @brief Tâche du tri rapide parallèle : partitionne sa zone, confie la plus petite moitié à une nouvelle
+ * tâche si elle dépasse le grain et continue sur la plus grande ; sous le grain, tri rapide séquentiel.
+ */
+static void quick_task(void *arg) {
+    QuickTask *task = (QuickTask*)arg;
+    QuickShared *shared = task->shared;
+    int *tab = shared->tab;
+    int low = task->low, high = task->high;
+
+    while (high - low + 1 > shared->grain) {
+        pivot_to_front(tab, low, high);
+        int p = place_pivot(tab, low, split_range(tab, low + 1, high + 1, low));
+        if (p - low < high - p) {
+            if (p - low > shared->grain) quick_spawn(shared, low, p - 1);
+            else quick_sort_range(tab, low, p - 1);
+            low = p + 1;
+        } else {
+            if (high - p > shared->grain) quick_spawn(shared, p + 1, high);
+            else quick_sort_range(tab, p + 1, high);
+            high = p - 1;
+        }
+    }
+    quick_sort_range(tab, low, high);
+}
+
+/**
+ * @brief Taille au-delà de laquelle une zone du tri rapide parallèle est partitionnée par tous les threads :
+ * environ une part par thread, et au moins quatre blocs par participant.
+ */
+static int parallel_partition_limit(int n, int threads) {
+    long limit = n / threads;
+    long least = 4L * threads * PARTITION_BLOCK;
+    return (int)(limit > least ? limit : least);
+}
+
+/**
+ * @brief Premier temps du tri rapide parallèle, sur le thread appelant : les zones plus grandes que limit
+ * sont partitionnées en parallèle, les autres mises de côté pour les tâches (ou triées sur place faute de
+ * descripteur).
+ */
+static void parallel_quick_split(QuickShared *shared, int low, int high, int limit) {
+    while (high - low + 1 > limit) {
+        int p = parallel_partition(shared, low, high);
+        if (p - low < high - p) {
+            parallel_quick_split(shared, low, p - 1, limit);
+            low = p + 1;
+        } else {
+            parallel_quick_split(shared, p + 1, high, limit);
+            high = p - 1;
+        }
+    }
+    if (low < high && quick_task_reserve(shared, low, high) == NULL) quick_sort_range(shared->tab, low, high);
+}
+
+/**
+ * @brief Tri rapide parallèle en place. Les premières partitions, les plus coûteuses, sont elles-mêmes
+ * parallèles : les threads neutralisent des blocs pris aux deux bords de la zone. Les zones obtenues sont
+ * ensuite confiées à des tâches, qui confient à leur tour chaque moitié plus grande que le grain. Aucun
+ * tableau auxiliaire : la pile reste en O(log n) et les seuls ajouts sont les descripteurs de tâches
+ * (O(n / grain)) et deux cases par thread. Threads et grain viennent du profil de réglage (voir tuning.h).
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+void ParallelQuickSort(int tab[], int n) {
+    int threads = TuningThreads();
+    int grain = GetTuning()->parallelGrain;
+    if (threads <= 1 || n < 2 * grain) {
+        quick_sort_range(tab, 0, n - 1);
+        return;
+    }
+
+    QuickShared shared = { tab, grain, NULL, threads, NULL, 0, 0, PTHREAD_MUTEX_INITIALIZER, NULL, NULL };
+    shared.capacity = 4 * (n / grain) + 4 * threads;
+    shared.tasks = (QuickTask*)SortMalloc(shared.capacity * sizeof(QuickTask));
+    shared.workers = (PartitionTask*)SortMalloc(threads * sizeof(PartitionTask));
+    shared.leftover = (int*)SortMalloc(2 * threads * sizeof(int));
+    shared.pool = shared.tasks && shared.workers && shared.leftover ? ThreadPoolCreate(threads) : NULL;
+    if (shared.pool == NULL) {
+        SortFree(shared.leftover);
+        SortFree(shared.workers);
+        SortFree(shared.tasks);
+        quick_sort_range(tab, 0, n - 1);
+        return;
+    }
+
+    parallel_quick_split(&shared, 0, n - 1, parallel_partition_limit(n, threads));
+    int deferred = shared.used;
+    for (int t = 0; t < deferred; t++) {
+        if (ThreadPoolSubmit(shared.pool, quick_task, &shared.tasks[t]) != 0) quick_task(&shared.tasks[t]);
+    }
+    ThreadPoolWait(shared.pool);
+
+    ThreadPoolDestroy(shared.pool);
+    pthread_mutex_destroy(&shared.lock);
+    SortFree(shared.leftover);
+    SortFree(shared.workers);
+    SortFree(shared.tasks);
+}
+
+
+// ------------------------- Versions instrumentées -------------------------
+// Se sont les même fonctions que précédemment, mais avec un callback de visualisation.
+// afin d'afficher les comparaisons et les échanges de positions pas à pas.
+// Cela me permet d'utiliser une méthode de visualisation générique pour tous les algorithmes de tri, 
+// en passant la fonction de tri appropriée en paramètre.
+// M'évitant de dupliquer le code de gestion de la fenêtre SDL et du rendu graphique pour chaque algorithme de tri.
+// Les hooks écrivent des événements (events.h) : livrés par lots sous SortRunEvents, ou rejoués un par un
+// vers le callback passé aux fonctions *_viz.
+
+
+/**
+ * @brief Ajoute un événement au flux et livre le lot quand il est plein. Pour un VizCallback, une opération
+ * ponctuelle lui est passée directement ; une opération sur une zone recopie ses valeurs (SortEventsPushRange).
+ */
+static inline void push_event(SortEventStream *events, int type, int a, int b, int len) {
+    if (type >= SORT_EVENT_WRITE_RANGE) {
+        SortEventsPushRange(events, type, a, b, len);
+        return;
+    }
+    if (events->cb != NULL) {
+        events->cb(events->tab, events->n, a, b);
+        return;
+    }
+
+    SortEvent *event = &events->events[events->count++];
+    event->type = type;
+    event->a = a;
+    event->b = b;
+    event->len = len;
+    event->value_a = (unsigned int)a < (unsigned int)events->n ? events->tab[a] : 0;
+    event->value_b = (unsigned int)b < (unsigned int)events->n ? events->tab[b] : 0;
+    event->values = NULL;
+    if (events->count == events->capacity) SortEventsFlush(events);
+}
+
+#define SORT_FN(name) name##_viz
+#define SORT_CTX_PARAMS , SortEventStream *events
+#define SORT_CTX_ARGS , events
+#define SORT_COMPARE(a, b) do { StatsCountComparison(); if (events) push_event(events, SORT_EVENT_COMPARE, (a), (b), 0); } while (0)
+#define SORT_SWAP(a, b) do { StatsCountWrites(2); if (events) push_event(events, SORT_EVENT_SWAP, (a), (b), 0); } while (0)
+#define SORT_WRITE(i, hl) do { StatsCountWrites(1); if (events) push_event(events, SORT_EVENT_WRITE, (i), (hl), 0); } while (0)
+#define SORT_WRITE_RANGE(low, len) do { StatsCountWrites(len); \
+    if (events && (len) > 0) push_event(events, SORT_EVENT_WRITE_RANGE, (low), (low), (len)); } while (0)
+#define SORT_SWAP_BLOCK(a, b, len) do { StatsCountWrites(2 * (len)); \
+    if (events && (len) > 0) push_event(events, SORT_EVENT_SWAP_BLOCK, (a), (b), (len)); } while (0)
+#define SORT_REVERSE(low, high) do { StatsCountWrites(2 * (((high) - (low) + 1) / 2)); \
+    if (events && (high) > (low)) push_event(events, SORT_EVENT_REVERSE, (low), (high), (high) - (low) + 1); } while (0)
+#include "sorting_impl.h"
+#include "selection_impl.h"
+#undef SORT_FN
+#undef SORT_CTX_PARAMS
+#undef SORT_CTX_ARGS
+#undef SORT_COMPARE
+#undef SORT_SWAP
+#undef SORT_WRITE
+#undef SORT_WRITE_RANGE
+#undef SORT_SWAP_BLOCK
+#undef SORT_REVERSE
+
+/**
+ * @brief Tri par sélection prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void SelectSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    select_sort_viz(tab, n, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri à bulles prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void BubbleSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    bubble_sort_viz(tab, n, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri à peigne prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void CombSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    comb_sort_viz(tab, n, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri par insertion prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void InsertionSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    insertion_sort_viz(tab, n, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri par insertion dichotomique prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void BinaryInsertionSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    binary_insertion_sort_viz(tab, n, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri de Shell prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void ShellSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    shell_sort_viz(tab, n, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri rapide prévu pour la visualisation. Le callback reçoit le tableau depuis l'indice 0.
+ * 
+ * @param tab Tableau à trier.
+ * @param debut Indice de début.
+ * @param fin Indice de fin.
+ * @param cb Callback de visualisation.
+ */
+void QuickSort_viz(int tab[], int debut, int fin, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, fin + 1, cb);
+    quick_sort_range_viz(tab, debut, fin, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Wrapper pour le tri rapide prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void QuickSort_viz_wrapper(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    quick_sort_range_viz(tab, 0, n - 1, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri par fusion prévu pour la visualisation. Le callback reçoit le tableau depuis l'indice 0.
+ * 
+ * @param tab Tableau à trier.
+ * @param gauche Indice de début.
+ * @param droite Indice de fin.
+ * @param cb Callback de visualisation.
+ */
+void MergeSort_viz(int tab[], int gauche, int droite, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, droite + 1, cb);
+    merge_sort_viz(tab, gauche, droite, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri par fusion prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void MergeSort_viz_wrapper(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    merge_sort_viz(tab, 0, n - 1, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri par fusion naturel prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void NaturalMergeSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    natural_merge_sort_viz(tab, n, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri par dénombrement prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void CountingSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    counting_sort_viz(tab, n, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri par base prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void RadixSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    radix_sort_viz(tab, n, GetTuning()->radixBits, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Inversion du tableau prévue pour la visualisation.
+ * 
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void ReverseArray_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    reverse_range_viz(tab, 0, n - 1, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Sélection du k-ième élément prévue pour la visualisation.
+ * 
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param nth Indice à placer.
+ * @param cb Callback de visualisation.
+ */
+void NthElement_viz(int tab[], int n, int nth, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    nth_element_viz(tab, n, nth, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri partiel prévu pour la visualisation.
+ * 
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param k Nombre d'éléments à ordonner.
+ * @param cb Callback de visualisation.
+ */
+void PartialSort_viz(int tab[], int n, int k, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    partial_sort_viz(tab, n, k, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief k plus petits éléments par tas borné, prévu pour la visualisation.
+ * 
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param k Nombre d'éléments à garder.
+ * @param cb Callback de visualisation.
+ */
+void TopK_viz(int tab[], int n, int k, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    top_k_viz(tab, n, k, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Wrapper de la sélection prévue pour la visualisation : place la médiane.
+ * 
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void NthElement_viz_wrapper(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    nth_element_viz(tab, n, n / 2, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Wrapper du tri partiel prévu pour la visualisation : ordonne le premier dixième.
+ * 
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void PartialSort_viz_wrapper(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    partial_sort_viz(tab, n, n / 10 > 0 ? n / 10 : 1, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Wrapper des k plus petits éléments prévu pour la visualisation : garde le premier dixième.
+ * 
+ * @param tab Tableau.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void TopK_viz_wrapper(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    top_k_viz(tab, n, n / 10 > 0 ? n / 10 : 1, events);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri par fusion parallèle prévu pour la visualisation. Le callback n'est pas prévu pour être appelé
+ * depuis plusieurs threads : les blocs et les niveaux de fusion du tri parallèle sont rejoués l'un après
+ * l'autre, dans le même découpage.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void ParallelSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    int threads = TuningThreads();
+    if (threads <= 1 || n < 2 * GetTuning()->parallelGrain) {
+        merge_sort_viz(tab, 0, n - 1, events);
+        SortEventsClose(events, &local);
+        return;
+    }
+
+    int chunk = parallel_chunk(n, threads);
+    for (long low = 0; low < n; low += chunk) {
+        long high = low + chunk - 1;
+        merge_sort_viz(tab, (int)low, high < n ? (int)high : n - 1, events);
+    }
+    for (long width = chunk; width < n; width *= 2) {
+        for (long low = 0; low + width < n; low += 2 * width) {
+            long high = low + 2 * width - 1;
+            merge_viz(tab, (int)low, (int)(low + width - 1), high < n ? (int)high : n - 1, events);
+        }
+    }
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Premier temps du tri rapide parallèle rejoué sur un seul thread : les mêmes zones sont
+ * partitionnées par blocs, avec un seul participant.
+ */
+static void parallel_quick_split_viz(int tab[], int low, int high, int limit, int leftover[],
+                                     SortEventStream *events) {
+    while (high - low + 1 > limit) {
+        BlockPartition part;
+        partition_begin_viz(&part, tab, low, high, 1, leftover, events);
+        partition_worker_viz(&part, 0, events);
+        int p = partition_finish_viz(&part, events);
+        if (p - low < high - p) {
+            parallel_quick_split_viz(tab, low, p - 1, limit, leftover, events);
+            low = p + 1;
+        } else {
+            parallel_quick_split_viz(tab, p + 1, high, limit, leftover, events);
+            high = p - 1;
+        }
+    }
+    quick_sort_range_viz(tab, low, high, events);
+}
+
+/**
+ * @brief Tri rapide parallèle prévu pour la visualisation. Le callback n'est pas prévu pour être appelé
+ * depuis plusieurs threads : les partitions par blocs sont rejouées par un seul participant, puis les zones
+ * des tâches l'une après l'autre (leurs partitions sont celles du tri rapide séquentiel à pile bornée).
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void ParallelQuickSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    int threads = TuningThreads();
+    if (threads <= 1 || n < 2 * GetTuning()->parallelGrain) {
+        quick_sort_range_viz(tab, 0, n - 1, events);
+    } else {
+        int leftover[2];
+        parallel_quick_split_viz(tab, 0, n - 1, parallel_partition_limit(n, threads), leftover, events);
+    }
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Suivi d'un tri en ligne visualisé : le tableau montre les suites du conteneur bout à bout.
+ */
+typedef struct OnlineViz {
+    int *tab;
+    SortEventStream *events;
+} OnlineViz;
+
+/**
+ * @brief Crochet du conteneur : la fusion qu'il vient d'installer est recopiée à la place de ses deux suites.
+ */
+static void online_merge_viz(void *user, long long start, const int merged[], int count) {
+    OnlineViz *viz = (OnlineViz*)user;
+    SortEventStream *events = viz->events;
+    memcpy(viz->tab + start, merged, (size_t)count * sizeof(int));
+    StatsCountWrites(count);
+    if (events) push_event(events, SORT_EVENT_WRITE_RANGE, (int)start, (int)start, count);
+}
+
+/**
+ * @brief Tri en ligne prévu pour la visualisation : les lots sont insérés dans un vrai conteneur trié
+ * (SortedStream), dont les suites sont des zones consécutives du tableau. Chaque lot est trié à sa place
+ * par le tri rapide (celui que le conteneur applique à sa copie) puis inséré ; le crochet du conteneur
+ * recopie chaque fusion au moment où elle est installée, y compris celles faites en arrière-plan.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void OnlineSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    OnlineViz viz = { tab, events };
+    SortedStream stream;
+    SortedStreamInit(&stream, TuningThreads() > 1);
+    SortedStreamSetHook(&stream, online_merge_viz, &viz);
+
+    int batch = OnlineSortBatch(n);
+    int status = 0;
+    for (int start = 0; start < n && status == 0; start += batch) {
+        int len = n - start < batch ? n - start : batch;
+        quick_sort_range_viz(tab, start, start + len - 1, events);
+        status = SortedStreamInsert(&stream, tab + start, len);
+    }
+    if ((status != 0 || SortedStreamFlush(&stream) != 0 || stream.nbRuns != 1) && n > 1) {
+        // The runs shown so far are permutations of their zones: finish on the array.
+        quick_sort_range_viz(tab, 0, n - 1, events);
+    }
+    SortedStreamFree(&stream);
+    SortEventsClose(events, &local);
+}
+
+/**
+ * @brief Tri par fusion par blocs prévu pour la visualisation.
+ * 
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param cb Callback de visualisation.
+ */
+void BlockMergeSort_viz(int tab[], int n, VizCallback cb) {
+    SortEventStream local;
+    SortEventStream *events = SortEventsOpen(&local, tab, n, cb);
+    int stack[BLOCK_MERGE_STACK];
+    int need = 2 * (int_sqrt_viz(n) + 3);
+    int *buffer = need <= BLOCK_MERGE_STACK ? stack : (int*)SortMalloc(need * sizeof(int));
+    if (buffer == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        block_merge_sort_viz(tab, n, NULL, 0, events);
+    } else {
+        block_merge_sort_viz(tab, n, buffer, buffer == stack ? BLOCK_MERGE_STACK : need, events);
+        if (buffer != stack) SortFree(buffer);
+    }
+    SortEventsClose(events, &local);
+}
@@ -1,31 +1,78 @@
-/**
- * @file sorting/sorting.h
- * @brief Déclarations des algorithmes de tri et des versions instrumentées pour la visualisation.
- * @author MUZARD Thomas
- * @date 27/10/2025
- */
-
-#ifndef SORTING_H
-
-#define SORTING_H
-
-// Simple (silent) algorithms
-void SelectSort(int arr[], int n);
-void BubbleSort(int arr[], int n);
-void InsertionSort(int arr[], int n);
-void QuickSort(int arr[], int low, int high);
-void MergeSort(int arr[], int left, int right);
-
-// Instrumentation callback used for visualization: highlight indices a and b.
-typedef void (*VizCallback)(int arr[], int n, int a, int b);
-
-// Instrumented algorithms that call the VizCallback at comparisons / swaps.
-void SelectSort_viz(int arr[], int n, VizCallback cb);
-void BubbleSort_viz(int arr[], int n, VizCallback cb);
-void InsertionSort_viz(int arr[], int n, VizCallback cb);
-void QuickSort_viz(int arr[], int low, int high, VizCallback cb); // low/high version keeps compatibility
-void QuickSort_viz_wrapper(int arr[], int n, VizCallback cb); // wrapper matching (arr,n,cb)
-void MergeSort_viz(int arr[], int left, int right, VizCallback cb);
-void MergeSort_viz_wrapper(int arr[], int n, VizCallback cb); // wrapper matching (arr,n,cb)
-
+/**
+ * @file sorting/sorting.h
+ * @brief Déclarations des algorithmes de tri et des versions instrumentées pour la visualisation.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef SORTING_H
+
+#define SORTING_H
+
+// Simple (silent) algorithms
+void SelectSort(int arr[], int n);
+void BubbleSort(int arr[], int n);
+void InsertionSort(int arr[], int n);
+void BinaryInsertionSort(int arr[], int n); // binary search for the slot, then one block move: stable
+void ShellSort(int arr[], int n);        // Ciura gaps, extended by x2.25
+void CombSort(int arr[], int n);         // bubble sort with a gap shrinking by 1.3
+void QuickSort(int arr[], int low, int high);
+void MergeSort(int arr[], int left, int right);
+void NaturalMergeSort(int arr[], int n); // merges the existing runs: O(n) on sorted input
+void BlockMergeSort(int arr[], int n);   // stable and in place: O(n log n), O(sqrt n) scratch
+void BlockMergeSortBuffer(int arr[], int n, int buffer[], int size); // caller scratch; size 0: rotations, O(n log^2 n)
+void CountingSort(int arr[], int n);     // dense keys; falls back to RadixSort when the range exceeds 4n
+void RadixSort(int arr[], int n);        // LSD, digit width from the tuning profile
+void ParallelSort(int arr[], int n);     // merge sort on the thread pool, threads and grain from the tuning profile
+void ParallelQuickSort(int arr[], int n); // in place: parallel block partitions, then one task per range
+void OnlineSort(int arr[], int n);       // fed in batches to a SortedStream (online.h), then read in order
+void ReverseArray(int arr[], int n);
+
+// Selection: only part of the array ends up ordered.
+void NthElement(int arr[], int n, int nth);   // arr[nth] in place, smaller before, larger after
+void PartialSort(int arr[], int n, int k);    // the k smallest, sorted, in arr[0..k-1]
+void TopK(int arr[], int n, int k);           // same result in one pass with a bounded heap
+
+// Streaming top-k: keeps the k smallest values pushed so far in O(k) memory.
+typedef struct TopKStream {
+    int k;
+    int count;
+    int *heap;
+} TopKStream;
+
+int TopKStreamInit(TopKStream *stream, int k);
+void TopKStreamPush(TopKStream *stream, const int values[], int n);
+int TopKStreamResult(const TopKStream *stream, int out[]); // ascending, returns the count
+void TopKStreamFree(TopKStream *stream);
+
+// Instrumentation callback used for visualization: highlight indices a and b.
+// Called once per step; SortRunEvents (events.h) delivers the same steps as batched events instead.
+typedef void (*VizCallback)(int arr[], int n, int a, int b);
+
+// Instrumented algorithms that call the VizCallback at comparisons / swaps.
+void SelectSort_viz(int arr[], int n, VizCallback cb);
+void BubbleSort_viz(int arr[], int n, VizCallback cb);
+void InsertionSort_viz(int arr[], int n, VizCallback cb);
+void BinaryInsertionSort_viz(int arr[], int n, VizCallback cb);
+void ShellSort_viz(int arr[], int n, VizCallback cb);
+void CombSort_viz(int arr[], int n, VizCallback cb);
+void QuickSort_viz(int arr[], int low, int high, VizCallback cb); // low/high version keeps compatibility
+void QuickSort_viz_wrapper(int arr[], int n, VizCallback cb); // wrapper matching (arr,n,cb)
+void MergeSort_viz(int arr[], int left, int right, VizCallback cb);
+void MergeSort_viz_wrapper(int arr[], int n, VizCallback cb); // wrapper matching (arr,n,cb)
+void NaturalMergeSort_viz(int arr[], int n, VizCallback cb);
+void BlockMergeSort_viz(int arr[], int n, VizCallback cb);
+void CountingSort_viz(int arr[], int n, VizCallback cb);
+void RadixSort_viz(int arr[], int n, VizCallback cb);
+void ParallelSort_viz(int arr[], int n, VizCallback cb); // same blocks and merges, replayed on one thread
+void ParallelQuickSort_viz(int arr[], int n, VizCallback cb); // block partitions with a single worker
+void OnlineSort_viz(int arr[], int n, VizCallback cb); // drives a SortedStream, its runs shown end to end
+void ReverseArray_viz(int arr[], int n, VizCallback cb);
+void NthElement_viz(int arr[], int n, int nth, VizCallback cb);
+void PartialSort_viz(int arr[], int n, int k, VizCallback cb);
+void TopK_viz(int arr[], int n, int k, VizCallback cb);
+void NthElement_viz_wrapper(int arr[], int n, VizCallback cb);  // median
+void PartialSort_viz_wrapper(int arr[], int n, VizCallback cb); // k = n / 10
+void TopK_viz_wrapper(int arr[], int n, VizCallback cb);        // k = n / 10
+
 #endif // SORTING_H
\ No newline at end of file
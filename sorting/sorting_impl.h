@@ -0,0 +1,1067 @@
+/**
+ * @file sorting/sorting_impl.h
+ * @brief Corps uniques des algorithmes de tri, écrits contre une couche de points d'accroche (hooks).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Ce fichier n'est pas un en-tête autonome (pas de garde d'inclusion) : sorting.c l'inclut deux fois,
+ * après avoir défini les macros suivantes.
+ *
+ * - SORT_FN(name)      : nom de la fonction générée (name ou name_viz).
+ * - SORT_CTX_PARAMS    : paramètres supplémentaires des fonctions (vide, ou ", SortEventStream *events").
+ * - SORT_CTX_ARGS      : arguments correspondants pour les appels récursifs.
+ * - SORT_COMPARE(a, b) : comparaison entre les cases a et b.
+ * - SORT_SWAP(a, b)    : échange des cases a et b (déjà effectué).
+ * - SORT_WRITE(i, hl)  : écriture de la case i (déjà effectuée), mise en évidence avec la case hl.
+ * - SORT_WRITE_RANGE(low, len)  : écriture des cases [low, low + len) (déjà effectuée).
+ * - SORT_SWAP_BLOCK(a, b, len)  : échange des zones [a, a + len) et [b, b + len) (déjà effectué).
+ * - SORT_REVERSE(low, high)     : inversion des cases low à high incluses (déjà effectuée).
+ *
+ * Une opération sur toute une zone se signale par un seul hook une fois terminée, pas élément par élément.
+ *
+ * Dans la version silencieuse, les hooks sont vides et le code compilé est celui d'un tri écrit à la main.
+ * Les types et fonctions sans hook (partition par blocs) ne sont définis qu'à la première inclusion.
+ */
+
+/**
+ * @brief Tri par sélection. Il va chercher l'élément minimum dans le tableau non trié et le place au début.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+static void SORT_FN(select_sort)(int tab[], int n SORT_CTX_PARAMS) {
+    for (int i = 0; i < n - 1; i++) {
+        int index = i;
+        for (int j = i + 1; j < n; j++) {
+            SORT_COMPARE(index, j);
+            if (tab[j] < tab[index]) {
+                index = j;
+            }
+        }
+        if (index != i) {
+            int temp = tab[i];
+            tab[i] = tab[index];
+            tab[index] = temp;
+            SORT_SWAP(i, index);
+        }
+    }
+}
+
+/**
+ * @brief Tri à bulles. Il compare chaque paire d'éléments adjacents et les échange s'ils sont supérieurs ou inférieurs entre eux.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+static void SORT_FN(bubble_sort)(int tab[], int n SORT_CTX_PARAMS) {
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = 0; j < n - i - 1; j++) {
+            SORT_COMPARE(j, j + 1);
+            if (tab[j] > tab[j + 1]) {
+                int temp = tab[j];
+                tab[j] = tab[j + 1];
+                tab[j + 1] = temp;
+                SORT_SWAP(j, j + 1);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tri à peigne (comb sort). Comme le tri à bulles, mais les éléments comparés sont séparés d'un écart
+ * divisé par 1,3 à chaque passe, ce qui déplace vite les petites valeurs restées en fin de tableau.
+ * Les passes avec un écart de 1 continuent tant qu'un échange a lieu.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+static void SORT_FN(comb_sort)(int tab[], int n SORT_CTX_PARAMS) {
+    int gap = n;
+    int swapped = 1;
+    while (gap > 1 || swapped) {
+        gap = gap * 10 / 13;
+        if (gap == 9 || gap == 10) gap = 11; // avoids the slow 9, 6, 4, 3, 2, 1 sequence
+        if (gap < 1) gap = 1;
+
+        swapped = 0;
+        for (int i = 0; i + gap < n; i++) {
+            SORT_COMPARE(i, i + gap);
+            if (tab[i] > tab[i + gap]) {
+                int temp = tab[i];
+                tab[i] = tab[i + gap];
+                tab[i + gap] = temp;
+                SORT_SWAP(i, i + gap);
+                swapped = 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tri par insertion. Il construit le tableau trié un élément à la fois en insérant chaque nouvel élément à sa position correcte.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+static void SORT_FN(insertion_sort)(int tab[], int n SORT_CTX_PARAMS) {
+    for (int i = 1; i < n; i++) {
+        int key = tab[i];
+        int j = i - 1;
+        while (j >= 0) {
+            SORT_COMPARE(j, i);
+            if (tab[j] <= key) break;
+            tab[j + 1] = tab[j];
+            j--;
+        }
+        tab[j + 1] = key;
+        SORT_WRITE_RANGE(j + 1, i - j);
+    }
+}
+
+/**
+ * @brief Tri par insertion des cases low à high (incluses).
+ */
+static void SORT_FN(insertion_range)(int tab[], int low, int high SORT_CTX_PARAMS) {
+    for (int i = low + 1; i <= high; i++) {
+        int key = tab[i];
+        int j = i - 1;
+        while (j >= low) {
+            SORT_COMPARE(j, i);
+            if (tab[j] <= key) break;
+            tab[j + 1] = tab[j];
+            j--;
+        }
+        tab[j + 1] = key;
+        SORT_WRITE_RANGE(j + 1, i - j);
+    }
+}
+
+/**
+ * @brief Tri par insertion dichotomique. La place de chaque élément est cherchée par dichotomie dans la partie
+ * déjà triée (après les éléments égaux, le tri reste stable), puis la fin de cette partie est décalée d'un bloc :
+ * O(n log n) comparaisons, mais toujours O(n²) déplacements.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+static void SORT_FN(binary_insertion_sort)(int tab[], int n SORT_CTX_PARAMS) {
+    for (int i = 1; i < n; i++) {
+        int key = tab[i];
+        int low = 0, high = i;
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            SORT_COMPARE(mid, i);
+            if (tab[mid] <= key) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (low == i) continue;
+        memmove(tab + low + 1, tab + low, (size_t)(i - low) * sizeof(int));
+        tab[low] = key;
+        SORT_WRITE_RANGE(low, i - low + 1);
+    }
+}
+
+/**
+ * @brief Tri de Shell avec les écarts de Ciura (1, 4, 10, 23, 57, 132, 301, 701), prolongés au-delà de 701
+ * en multipliant par 2,25. Chaque écart est un tri par insertion des éléments distants de cet écart.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+static void SORT_FN(shell_sort)(int tab[], int n SORT_CTX_PARAMS) {
+    static const int ciura[] = { 1, 4, 10, 23, 57, 132, 301, 701 };
+    int gaps[40];
+    int count = 0;
+    while (count < 8 && ciura[count] < n) {
+        gaps[count] = ciura[count];
+        count++;
+    }
+    for (long gap = 701 * 9 / 4; count >= 8 && gap < n && count < 40; gap = gap * 9 / 4) {
+        gaps[count++] = (int)gap;
+    }
+
+    while (count > 0) {
+        int gap = gaps[--count];
+        for (int i = gap; i < n; i++) {
+            int key = tab[i];
+            int j = i;
+            while (j >= gap) {
+                SORT_COMPARE(j - gap, i);
+                if (tab[j - gap] <= key) break;
+                tab[j] = tab[j - gap];
+                SORT_WRITE(j, j - gap);
+                j -= gap;
+            }
+            if (j != i) {
+                tab[j] = key;
+                SORT_WRITE(j, i);
+            }
+        }
+    }
+}
+
+static void SORT_FN(merge_rotate)(int tab[], int low, int mid, int high SORT_CTX_PARAMS);
+static void SORT_FN(block_merge_sort)(int tab[], int n, int buffer[], int size SORT_CTX_PARAMS);
+
+/**
+ * @brief Fusionne deux sous-tableaux pour le tri par fusion. Sans mémoire pour les copies, la fusion se fait
+ * sur place par rotations (merge_rotate), toujours stable.
+ *
+ * @param tab Tableau à trier.
+ * @param left Indice de début.
+ * @param mid Indice du milieu.
+ * @param right Indice de fin.
+ */
+static void SORT_FN(merge)(int tab[], int left, int mid, int right SORT_CTX_PARAMS) {
+    int n1 = mid - left + 1;
+    int n2 = right - mid;
+
+    int* L = (int*)SortMalloc(n1 * sizeof(int));
+    int* R = (int*)SortMalloc(n2 * sizeof(int));
+    if (L == NULL || R == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        SortFree(R);
+        SortFree(L);
+        SORT_FN(merge_rotate)(tab, left, mid + 1, right + 1 SORT_CTX_ARGS);
+        return;
+    }
+
+    for (int i = 0; i < n1; i++)
+        L[i] = tab[left + i];
+    for (int j = 0; j < n2; j++)
+        R[j] = tab[mid + 1 + j];
+
+    int i = 0;
+    int j = 0;
+    int k = left;
+    while (i < n1 && j < n2) {
+        SORT_COMPARE(k, mid + 1 + j);
+        if (L[i] <= R[j]) {
+            tab[k] = L[i];
+            i++;
+        } else {
+            tab[k] = R[j];
+            j++;
+        }
+        SORT_WRITE(k, k);
+        k++;
+    }
+
+    // What is left of R is already in place.
+    if (i < n1) {
+        memcpy(tab + k, L + i, (n1 - i) * sizeof(int));
+        SORT_WRITE_RANGE(k, n1 - i);
+    }
+
+    // Reverse order of allocation, so that an arena gets both blocks back.
+    SortFree(R);
+    SortFree(L);
+}
+
+/**
+ * @brief Tri par fusion (MergeSort). Il divise le tableau en deux moitiés, trie chaque moitié et les fusionne.
+ * Les zones d'au plus insertionCutoff éléments (voir tuning.h) finissent par un tri par insertion.
+ *
+ * @param tab Tableau à trier.
+ * @param left Indice de début.
+ * @param right Indice de fin.
+ */
+static void SORT_FN(merge_sort)(int tab[], int left, int right SORT_CTX_PARAMS) {
+    if (right - left < GetTuning()->insertionCutoff) {
+        SORT_FN(insertion_range)(tab, left, right SORT_CTX_ARGS);
+    } else if (left < right) {
+        int mid = left + (right - left) / 2;
+
+        SORT_FN(merge_sort)(tab, left, mid SORT_CTX_ARGS);
+        SORT_FN(merge_sort)(tab, mid + 1, right SORT_CTX_ARGS);
+
+        SORT_FN(merge)(tab, left, mid, right SORT_CTX_ARGS);
+    }
+}
+
+/**
+ * @brief Inverse l'ordre des cases low à high (incluses).
+ *
+ * @param tab Tableau.
+ * @param low Indice de début.
+ * @param high Indice de fin.
+ */
+static void SORT_FN(reverse_range)(int tab[], int low, int high SORT_CTX_PARAMS) {
+    for (int i = low, j = high; i < j; i++, j--) {
+        int temp = tab[i];
+        tab[i] = tab[j];
+        tab[j] = temp;
+    }
+    SORT_REVERSE(low, high);
+}
+
+/**
+ * @brief Tri par fusion naturel. Il repère les suites déjà croissantes (les suites strictement décroissantes
+ * sont retournées), puis fusionne les suites voisines deux à deux : O(n) sur une entrée triée, O(n log n) au pire.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+static void SORT_FN(natural_merge_sort)(int tab[], int n SORT_CTX_PARAMS) {
+    if (n < 2) return;
+
+    int *runs = (int*)SortMalloc((n + 1) * sizeof(int));
+    int *buffer = (int*)SortMalloc(n * sizeof(int));
+    if (runs == NULL || buffer == NULL) {
+        // Still sorted and stable, by rotations only.
+        fprintf(stderr, "Memory allocation failed\n");
+        SortFree(runs);
+        SortFree(buffer);
+        SORT_FN(block_merge_sort)(tab, n, NULL, 0 SORT_CTX_ARGS);
+        return;
+    }
+
+    // runs[r] is the first index of run r; runs[nbRuns] == n.
+    int nbRuns = 0;
+    int start = 0;
+    while (start < n) {
+        int end = start + 1;
+        if (end < n) {
+            SORT_COMPARE(start, end);
+            if (tab[end] < tab[start]) {
+                while (end + 1 < n) {
+                    SORT_COMPARE(end, end + 1);
+                    if (tab[end + 1] >= tab[end]) break;
+                    end++;
+                }
+                SORT_FN(reverse_range)(tab, start, end SORT_CTX_ARGS);
+                end++;
+            } else {
+                while (end + 1 < n) {
+                    SORT_COMPARE(end, end + 1);
+                    if (tab[end + 1] < tab[end]) break;
+                    end++;
+                }
+                end++;
+            }
+        }
+        runs[nbRuns++] = start;
+        start = end;
+    }
+    runs[nbRuns] = n;
+
+    while (nbRuns > 1) {
+        int merged = 0;
+        for (int r = 0; r < nbRuns; r += 2) {
+            runs[merged++] = runs[r];
+            if (r + 1 >= nbRuns) break;
+
+            int left = runs[r], mid = runs[r + 1], right = runs[r + 2];
+            int n1 = mid - left;
+            memcpy(buffer, tab + left, n1 * sizeof(int));
+
+            int i = 0, j = mid, k = left;
+            while (i < n1 && j < right) {
+                SORT_COMPARE(k, j);
+                if (buffer[i] <= tab[j]) {
+                    tab[k] = buffer[i++];
+                } else {
+                    tab[k] = tab[j++];
+                }
+                SORT_WRITE(k, k);
+                k++;
+            }
+            if (i < n1) {
+                memcpy(tab + k, buffer + i, (n1 - i) * sizeof(int));
+                SORT_WRITE_RANGE(k, n1 - i);
+            }
+        }
+        runs[merged] = n;
+        nbRuns = merged;
+    }
+
+    SortFree(runs);
+    SortFree(buffer);
+}
+
+/**
+ * @brief Partie entière de la racine carrée de n (n >= 0).
+ */
+static int SORT_FN(int_sqrt)(int n) {
+    int r = 0;
+    while ((long)(r + 1) * (r + 1) <= n) r++;
+    return r;
+}
+
+/**
+ * @brief Rotation des cases low à high - 1 : la zone [mid, high) passe devant la zone [low, mid), par trois
+ * inversions (sans mémoire supplémentaire).
+ */
+static void SORT_FN(rotate_range)(int tab[], int low, int mid, int high SORT_CTX_PARAMS) {
+    if (low == mid || mid == high) return;
+    SORT_FN(reverse_range)(tab, low, mid - 1 SORT_CTX_ARGS);
+    SORT_FN(reverse_range)(tab, mid, high - 1 SORT_CTX_ARGS);
+    SORT_FN(reverse_range)(tab, low, high - 1 SORT_CTX_ARGS);
+}
+
+/**
+ * @brief Échange les count cases à partir de a avec les count cases à partir de b (zones disjointes).
+ */
+static void SORT_FN(block_swap)(int tab[], int a, int b, int count SORT_CTX_PARAMS) {
+    for (int i = 0; i < count; i++) {
+        int temp = tab[a + i];
+        tab[a + i] = tab[b + i];
+        tab[b + i] = temp;
+    }
+    SORT_SWAP_BLOCK(a, b, count);
+}
+
+/**
+ * @brief Premier indice de [low, high) dont la valeur est supérieure ou égale à la case key
+ * (high si aucun).
+ */
+static int SORT_FN(lower_bound)(int tab[], int low, int high, int key SORT_CTX_PARAMS) {
+    int value = tab[key];
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        SORT_COMPARE(mid, key);
+        if (tab[mid] < value) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief Premier indice de [low, high) dont la valeur est strictement supérieure à la case key
+ * (high si aucun).
+ */
+static int SORT_FN(upper_bound)(int tab[], int low, int high, int key SORT_CTX_PARAMS) {
+    int value = tab[key];
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        SORT_COMPARE(mid, key);
+        if (tab[mid] <= value) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief Fusion stable sans tampon de [low, mid) et [mid, high) : la plus longue zone est coupée en son
+ * milieu, la position correspondante est cherchée dans l'autre, puis une rotation échange les deux
+ * morceaux du centre. O(n log n) déplacements par fusion, O(log n) de pile.
+ */
+static void SORT_FN(merge_rotate)(int tab[], int low, int mid, int high SORT_CTX_PARAMS) {
+    while (low < mid && mid < high) {
+        if (high - low == 2) {
+            SORT_COMPARE(low, mid);
+            if (tab[mid] < tab[low]) {
+                int temp = tab[low];
+                tab[low] = tab[mid];
+                tab[mid] = temp;
+                SORT_SWAP(low, mid);
+            }
+            return;
+        }
+
+        int cut1, cut2;
+        if (mid - low > high - mid) {
+            cut1 = low + (mid - low) / 2;
+            cut2 = SORT_FN(lower_bound)(tab, mid, high, cut1 SORT_CTX_ARGS);
+        } else {
+            cut2 = mid + (high - mid) / 2;
+            cut1 = SORT_FN(upper_bound)(tab, low, mid, cut2 SORT_CTX_ARGS);
+        }
+        SORT_FN(rotate_range)(tab, cut1, mid, cut2 SORT_CTX_ARGS);
+
+        // Recurse on the smaller side, loop on the larger one.
+        int newMid = cut1 + (cut2 - mid);
+        if (newMid - low < high - newMid) {
+            SORT_FN(merge_rotate)(tab, low, cut1, newMid SORT_CTX_ARGS);
+            low = newMid;
+            mid = cut2;
+        } else {
+            SORT_FN(merge_rotate)(tab, newMid, cut2, high SORT_CTX_ARGS);
+            high = newMid;
+            mid = cut1;
+        }
+    }
+}
+
+/**
+ * @brief Fusionne les na valeurs de cache (dont les cases [start, start + na) sont libres) avec les valeurs
+ * triées des cases [start + na, end), en écrivant à partir de start. Les valeurs du cache passent avant
+ * les valeurs égales du tableau.
+ */
+static void SORT_FN(merge_from_cache)(int tab[], int start, const int cache[], int na, int end SORT_CTX_PARAMS) {
+    int a = 0, b = start + na, k = start;
+    while (a < na && b < end) {
+        SORT_COMPARE(b, k);
+        if (tab[b] < cache[a]) {
+            tab[k] = tab[b];
+            b++;
+        } else {
+            tab[k] = cache[a];
+            a++;
+        }
+        SORT_WRITE(k, k);
+        k++;
+    }
+    if (a < na) {
+        memcpy(tab + k, cache + a, (na - a) * sizeof(int));
+        SORT_WRITE_RANGE(k, na - a);
+    }
+}
+
+/**
+ * @brief Fusion stable en place de [a0, a1) et [a1, b1), de la famille des fusions par blocs (WikiSort).
+ *
+ * A est découpé en blocs de s = racine(|A|) éléments qui « roulent » à travers B : le bloc A de tête est
+ * échangé avec le bloc B suivant, et le plus petit bloc A est déposé dès que la dernière valeur B passée
+ * est au moins égale à sa première valeur. Chaque bloc déposé est fusionné avec les valeurs B qui le
+ * suivent grâce au cache de s éléments. Les blocs A de même première valeur sont départagés par leur rang
+ * d'origine, gardé dans tags, ce qui rend la fusion stable. O(|A| + |B|) opérations.
+ *
+ * @param cache Tampon de cacheSize cases ; si |A| y tient, fusion directe.
+ * @param tags Rangs des blocs A (au moins racine(|A|) + 2 cases), ou NULL : fusion par rotations.
+ */
+static void SORT_FN(block_merge)(int tab[], int a0, int a1, int b1, int cache[], int cacheSize, int tags[]
+                                 SORT_CTX_PARAMS) {
+    if (a0 >= a1 || a1 >= b1) return;
+    SORT_COMPARE(a1 - 1, a1);
+    if (tab[a1 - 1] <= tab[a1]) return;
+    SORT_COMPARE(a0, b1 - 1);
+    if (tab[b1 - 1] < tab[a0]) {
+        SORT_FN(rotate_range)(tab, a0, a1, b1 SORT_CTX_ARGS);
+        return;
+    }
+
+    int lenA = a1 - a0;
+    if (lenA <= cacheSize) {
+        memcpy(cache, tab + a0, lenA * sizeof(int));
+        SORT_FN(merge_from_cache)(tab, a0, cache, lenA, b1 SORT_CTX_ARGS);
+        return;
+    }
+    int s = SORT_FN(int_sqrt)(lenA);
+    if (tags == NULL || s > cacheSize) {
+        SORT_FN(merge_rotate)(tab, a0, a1, b1 SORT_CTX_ARGS);
+        return;
+    }
+
+    // The previous A block lives in the cache; its slots in the array are free.
+    int lastA = a0, lastALen = lenA % s;
+    int lastB = a0 + lastALen, lastBEnd = lastB;
+    int blockA = a0 + lastALen, blockAEnd = a1;
+    int blockB = a1, blockBEnd = a1 + (s < b1 - a1 ? s : b1 - a1);
+    int nbBlocks = (blockAEnd - blockA) / s;
+    for (int i = 0; i < nbBlocks; i++) tags[i] = i;
+    int minSlot = 0;
+    memcpy(cache, tab + lastA, lastALen * sizeof(int));
+
+    for (;;) {
+        int minA = blockA + minSlot * s;
+        int drop = blockB == blockBEnd;
+        if (!drop && lastBEnd > lastB) {
+            SORT_COMPARE(minA, lastBEnd - 1);
+            drop = tab[minA] <= tab[lastBEnd - 1];
+        }
+
+        if (drop) {
+            // Drop the smallest A block behind the B values smaller than its first value.
+            int split = SORT_FN(lower_bound)(tab, lastB, lastBEnd, minA SORT_CTX_ARGS);
+            int remaining = lastBEnd - split;
+            SORT_FN(block_swap)(tab, blockA, minA, minSlot > 0 ? s : 0 SORT_CTX_ARGS);
+            int tag = tags[0];
+            tags[0] = tags[minSlot];
+            tags[minSlot] = tag;
+
+            SORT_FN(merge_from_cache)(tab, lastA, cache, lastALen, split SORT_CTX_ARGS);
+
+            // The dropped block becomes the cached one; the B values after the split take the end of its slot.
+            memcpy(cache, tab + blockA, s * sizeof(int));
+            SORT_FN(block_swap)(tab, split, blockA + s - remaining, remaining SORT_CTX_ARGS);
+            lastA = blockA - remaining;
+            lastALen = s;
+            lastB = lastA + s;
+            lastBEnd = lastB + remaining;
+
+            blockA += s;
+            nbBlocks--;
+            memmove(tags, tags + 1, nbBlocks * sizeof(int));
+            if (nbBlocks == 0) break;
+
+            minSlot = 0;
+            for (int i = 1; i < nbBlocks; i++) {
+                int candidate = blockA + i * s, best = blockA + minSlot * s;
+                SORT_COMPARE(candidate, best);
+                if (tab[candidate] < tab[best] || (tab[candidate] == tab[best] && tags[i] < tags[minSlot])) {
+                    minSlot = i;
+                }
+            }
+        } else if (blockBEnd - blockB < s) {
+            // Last, shorter B block: rotate it in front of the remaining A blocks.
+            int len = blockBEnd - blockB;
+            SORT_FN(rotate_range)(tab, blockA, blockB, blockBEnd SORT_CTX_ARGS);
+            lastB = blockA;
+            lastBEnd = blockA + len;
+            blockA += len;
+            blockAEnd += len;
+            blockB = blockBEnd;
+        } else {
+            // Roll the leading A block to the end by swapping it with the next B block.
+            SORT_FN(block_swap)(tab, blockA, blockB, s SORT_CTX_ARGS);
+            lastB = blockA;
+            lastBEnd = blockA + s;
+            int tag = tags[0];
+            memmove(tags, tags + 1, (nbBlocks - 1) * sizeof(int));
+            tags[nbBlocks - 1] = tag;
+            minSlot = minSlot == 0 ? nbBlocks - 1 : minSlot - 1;
+
+            blockA += s;
+            blockAEnd += s;
+            blockB += s;
+            blockBEnd = blockBEnd > b1 - s ? b1 : blockBEnd + s;
+        }
+    }
+
+    SORT_FN(merge_from_cache)(tab, lastA, cache, lastALen, b1 SORT_CTX_ARGS);
+}
+
+/**
+ * @brief Tri par fusion par blocs (stable, en place). Des suites de insertionCutoff éléments sont triées par
+ * insertion, puis fusionnées deux à deux par block_merge. Avec racine(n) + 3 cases de rangs en fin de tampon
+ * et au moins autant de cache, chaque fusion est linéaire : O(n log n) ; un cache plus grand fusionne
+ * directement les petites zones. Sans tampon (size 0), les fusions se font par rotations : O(n log² n).
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param buffer Tampon de travail (cache puis rangs des blocs), ou NULL.
+ * @param size Nombre de cases du tampon.
+ */
+static void SORT_FN(block_merge_sort)(int tab[], int n, int buffer[], int size SORT_CTX_PARAMS) {
+    if (n < 2) return;
+    int run = GetTuning()->insertionCutoff > 1 ? GetTuning()->insertionCutoff : 1;
+    for (int i = 0; i < n; i += run) {
+        SORT_FN(insertion_range)(tab, i, (n - i > run ? i + run : n) - 1 SORT_CTX_ARGS);
+    }
+
+    int tagCapacity = SORT_FN(int_sqrt)(n) + 3;
+    int *tags = NULL;
+    int cacheSize = buffer != NULL ? size : 0;
+    if (cacheSize >= 2 * tagCapacity) {
+        tags = buffer + size - tagCapacity;
+        cacheSize -= tagCapacity;
+    }
+
+    for (long width = run; width < n; width *= 2) {
+        for (long low = 0; low + width < n; low += 2 * width) {
+            long high = low + 2 * width < n ? low + 2 * width : n;
+            SORT_FN(block_merge)(tab, (int)low, (int)(low + width), (int)high, buffer, cacheSize, tags SORT_CTX_ARGS);
+        }
+    }
+}
+
+#ifndef PARTITION_BLOCK
+/**
+ * @brief Taille des blocs de la partition par blocs (16 Kio d'entiers).
+ */
+#define PARTITION_BLOCK 4096
+
+/**
+ * @brief Taille au-delà de laquelle le pivot est la médiane de neuf échantillons.
+ */
+#define PIVOT_NINTHER 128
+
+/**
+ * @brief Partition par blocs de la zone [low, high) autour du pivot placé en low - 1. Les blocs sont
+ * distribués depuis les deux bords : le k-ième bloc gauche commence en low + k * PARTITION_BLOCK, le k-ième
+ * bloc droit finit en high - k * PARTITION_BLOCK. Chaque participant note en leftover[2w] et leftover[2w + 1]
+ * ses blocs gauche et droit restés à moitié traités (-1 sinon).
+ */
+typedef struct BlockPartition {
+    int *tab;
+    int low, high;
+    int nbBlocks;
+    int nextLeft, nextRight;  // blocks already handed out on each side
+    int nbWorkers;
+    int *leftover;
+    pthread_mutex_t lock;
+} BlockPartition;
+
+/**
+ * @brief Premier indice du k-ième bloc d'un côté (0 : gauche, 1 : droit).
+ */
+static int partition_block_start(const BlockPartition *part, int side, int k) {
+    return side == 0 ? part->low + k * PARTITION_BLOCK : part->high - (k + 1) * PARTITION_BLOCK;
+}
+
+/**
+ * @brief Distribue le bloc suivant d'un côté.
+ *
+ * @return L'indice du bloc dans son côté, ou -1 s'il ne reste plus de bloc.
+ */
+static int partition_fetch(BlockPartition *part, int side) {
+    int k = -1;
+    pthread_mutex_lock(&part->lock);
+    if (part->nextLeft + part->nextRight < part->nbBlocks) {
+        k = side == 0 ? part->nextLeft++ : part->nextRight++;
+    }
+    pthread_mutex_unlock(&part->lock);
+    return k;
+}
+
+/**
+ * @brief Indique si le k-ième bloc d'un côté est resté à moitié traité.
+ */
+static int partition_is_leftover(const BlockPartition *part, int side, int k) {
+    for (int w = 0; w < part->nbWorkers; w++) {
+        if (part->leftover[2 * w + side] == k) return 1;
+    }
+    return 0;
+}
+#endif
+
+/**
+ * @brief Ordonne les cases a et b (tab[a] <= tab[b]).
+ */
+static void SORT_FN(order2)(int tab[], int a, int b SORT_CTX_PARAMS) {
+    SORT_COMPARE(a, b);
+    if (tab[b] < tab[a]) {
+        int temp = tab[a];
+        tab[a] = tab[b];
+        tab[b] = temp;
+        SORT_SWAP(a, b);
+    }
+}
+
+/**
+ * @brief Ordonne les cases a, b et c (tab[a] <= tab[b] <= tab[c]).
+ */
+static void SORT_FN(sort3)(int tab[], int a, int b, int c SORT_CTX_PARAMS) {
+    SORT_FN(order2)(tab, a, b SORT_CTX_ARGS);
+    SORT_FN(order2)(tab, b, c SORT_CTX_ARGS);
+    SORT_FN(order2)(tab, a, b SORT_CTX_ARGS);
+}
+
+/**
+ * @brief Place le pivot en tête de la zone low..high : médiane des cases low, milieu et high, ou au-delà de
+ * PIVOT_NINTHER éléments médiane de trois médianes de trois (ninther). Les échantillons sont ordonnés sur
+ * place, ce qui évite les partitions dégénérées sur les entrées triées, inversées ou en dents de scie.
+ */
+static void SORT_FN(pivot_to_front)(int tab[], int low, int high SORT_CTX_PARAMS) {
+    int mid = low + (high - low) / 2;
+    if (high - low <= PIVOT_NINTHER) {
+        // The median lands on low, the smallest sample on mid, the largest on high.
+        SORT_FN(sort3)(tab, mid, low, high SORT_CTX_ARGS);
+        return;
+    }
+
+    int q = (high - low) / 8;
+    SORT_FN(sort3)(tab, low + 1, low + 1 + q, low + 1 + 2 * q SORT_CTX_ARGS);
+    SORT_FN(sort3)(tab, mid - q, mid, mid + q SORT_CTX_ARGS);
+    SORT_FN(sort3)(tab, high - 1 - 2 * q, high - 1 - q, high - 1 SORT_CTX_ARGS);
+    SORT_FN(sort3)(tab, low + 1 + q, mid, high - 1 - q SORT_CTX_ARGS);
+    int temp = tab[low];
+    tab[low] = tab[mid];
+    tab[mid] = temp;
+    SORT_SWAP(low, mid);
+}
+
+/**
+ * @brief Partition de Hoare de [low, high) autour de la case pivotAt (hors de la zone). Les deux curseurs
+ * s'arrêtent sur les valeurs égales au pivot, qui se répartissent ainsi des deux côtés.
+ *
+ * @return L'indice split : [low, split) <= pivot et [split, high) >= pivot.
+ */
+static int SORT_FN(split_range)(int tab[], int low, int high, int pivotAt SORT_CTX_PARAMS) {
+    int pivot = tab[pivotAt];
+    int i = low;
+    int j = high - 1;
+    while (1) {
+        while (i <= j) {
+            SORT_COMPARE(i, pivotAt);
+            if (tab[i] >= pivot) break;
+            i++;
+        }
+        while (i <= j) {
+            SORT_COMPARE(j, pivotAt);
+            if (tab[j] <= pivot) break;
+            j--;
+        }
+        if (i >= j) return i;
+        int temp = tab[i];
+        tab[i] = tab[j];
+        tab[j] = temp;
+        SORT_SWAP(i, j);
+        i++;
+        j--;
+    }
+}
+
+/**
+ * @brief Ramène le pivot (en tête de la zone low..high) à sa place définitive après la partition.
+ *
+ * @param split Indice rendu par split_range sur [low + 1, high + 1).
+ * @return L'indice du pivot : low..pivot - 1 <= pivot <= pivot + 1..high.
+ */
+static int SORT_FN(place_pivot)(int tab[], int low, int split SORT_CTX_PARAMS) {
+    int at = split - 1;
+    if (at != low) {
+        int temp = tab[low];
+        tab[low] = tab[at];
+        tab[at] = temp;
+        SORT_SWAP(low, at);
+    }
+    return at;
+}
+
+/**
+ * @brief Tri rapide en place à pile bornée : pivot médiane de trois (ou de neuf), partition de Hoare, appel
+ * récursif sur la plus petite moitié et boucle sur la plus grande, soit O(log n) niveaux de pile quelle que
+ * soit l'entrée.
+ *
+ * @param tab Tableau à trier.
+ * @param low Indice de début.
+ * @param high Indice de fin.
+ */
+static void SORT_FN(quick_sort_range)(int tab[], int low, int high SORT_CTX_PARAMS) {
+    while (low < high && high - low >= GetTuning()->insertionCutoff) {
+        SORT_FN(pivot_to_front)(tab, low, high SORT_CTX_ARGS);
+        int split = SORT_FN(split_range)(tab, low + 1, high + 1, low SORT_CTX_ARGS);
+        int p = SORT_FN(place_pivot)(tab, low, split SORT_CTX_ARGS);
+        if (p - low < high - p) {
+            SORT_FN(quick_sort_range)(tab, low, p - 1 SORT_CTX_ARGS);
+            low = p + 1;
+        } else {
+            SORT_FN(quick_sort_range)(tab, p + 1, high SORT_CTX_ARGS);
+            high = p - 1;
+        }
+    }
+    if (low < high) SORT_FN(insertion_range)(tab, low, high SORT_CTX_ARGS);
+}
+
+/**
+ * @brief Neutralise un bloc gauche contre un bloc droit : les valeurs >= pivot du bloc gauche sont échangées
+ * avec les valeurs <= pivot du bloc droit, jusqu'à épuiser l'un des deux. Les curseurs avancent en place,
+ * le bloc restant reprend où il s'est arrêté face au bloc suivant.
+ *
+ * @param i Curseur du bloc gauche (croissant, jusqu'à iEnd exclu).
+ * @param j Curseur du bloc droit (décroissant, jusqu'à jStart inclus).
+ * @param pivotAt Case du pivot.
+ */
+static void SORT_FN(neutralize)(int tab[], int *i, int iEnd, int *j, int jStart, int pivotAt SORT_CTX_PARAMS) {
+    int pivot = tab[pivotAt];
+    int a = *i;
+    int b = *j;
+    while (a < iEnd && b >= jStart) {
+        SORT_COMPARE(a, pivotAt);
+        if (tab[a] < pivot) {
+            a++;
+            continue;
+        }
+        SORT_COMPARE(b, pivotAt);
+        if (tab[b] > pivot) {
+            b--;
+            continue;
+        }
+        int temp = tab[a];
+        tab[a] = tab[b];
+        tab[b] = temp;
+        SORT_SWAP(a, b);
+        a++;
+        b--;
+    }
+    *i = a;
+    *j = b;
+}
+
+/**
+ * @brief Participant w de la partition par blocs : prend un bloc de chaque côté, les neutralise l'un contre
+ * l'autre et remplace celui qui est épuisé, jusqu'à ce qu'il ne reste plus de bloc à distribuer.
+ */
+static void SORT_FN(partition_worker)(BlockPartition *part, int w SORT_CTX_PARAMS) {
+    int left = -1, right = -1;
+    int i = 0, iEnd = 0, j = 0, jStart = 0;
+    while (1) {
+        if (left < 0) {
+            left = partition_fetch(part, 0);
+            if (left < 0) break;
+            i = partition_block_start(part, 0, left);
+            iEnd = i + PARTITION_BLOCK;
+        }
+        if (right < 0) {
+            right = partition_fetch(part, 1);
+            if (right < 0) break;
+            jStart = partition_block_start(part, 1, right);
+            j = jStart + PARTITION_BLOCK - 1;
+        }
+        SORT_FN(neutralize)(part->tab, &i, iEnd, &j, jStart, part->low - 1 SORT_CTX_ARGS);
+        if (i == iEnd) left = -1;
+        if (j < jStart) right = -1;
+    }
+    part->leftover[2 * w] = left;
+    part->leftover[2 * w + 1] = right;
+}
+
+/**
+ * @brief Range les blocs d'un côté restés à moitié traités contre le milieu de la zone, en les échangeant
+ * avec des blocs neutralisés.
+ *
+ * @return Le nombre de blocs neutralisés de ce côté, désormais contigus depuis le bord.
+ */
+static int SORT_FN(gather_leftovers)(BlockPartition *part, int side SORT_CTX_PARAMS) {
+    int taken = side == 0 ? part->nextLeft : part->nextRight;
+    int count = 0;
+    for (int w = 0; w < part->nbWorkers; w++) {
+        if (part->leftover[2 * w + side] >= 0) count++;
+    }
+
+    // Slots [done, taken) receive the leftovers; those already there stay.
+    int done = taken - count;
+    int slot = done;
+    for (int w = 0; w < part->nbWorkers; w++) {
+        int k = part->leftover[2 * w + side];
+        if (k < 0 || k >= done) continue;
+        while (partition_is_leftover(part, side, slot)) slot++;
+        SORT_FN(block_swap)(part->tab, partition_block_start(part, side, k),
+                            partition_block_start(part, side, slot), PARTITION_BLOCK SORT_CTX_ARGS);
+        slot++;
+    }
+    return done;
+}
+
+/**
+ * @brief Prépare la partition par blocs de la zone low..high : le pivot passe en tête, la zone
+ * [low + 1, high + 1) est découpée en blocs.
+ *
+ * @param leftover Deux cases par participant.
+ */
+static void SORT_FN(partition_begin)(BlockPartition *part, int tab[], int low, int high, int nbWorkers,
+                                     int leftover[] SORT_CTX_PARAMS) {
+    SORT_FN(pivot_to_front)(tab, low, high SORT_CTX_ARGS);
+    part->tab = tab;
+    part->low = low + 1;
+    part->high = high + 1;
+    part->nbBlocks = (high - low) / PARTITION_BLOCK;
+    part->nextLeft = 0;
+    part->nextRight = 0;
+    part->nbWorkers = nbWorkers;
+    part->leftover = leftover;
+    pthread_mutex_init(&part->lock, NULL);
+}
+
+/**
+ * @brief Termine la partition par blocs une fois tous les participants revenus : les blocs à moitié traités
+ * sont rangés au milieu, qui est partitionné seul, puis le pivot rejoint sa place.
+ *
+ * @return L'indice du pivot.
+ */
+static int SORT_FN(partition_finish)(BlockPartition *part SORT_CTX_PARAMS) {
+    pthread_mutex_destroy(&part->lock);
+    int left = SORT_FN(gather_leftovers)(part, 0 SORT_CTX_ARGS);
+    int right = SORT_FN(gather_leftovers)(part, 1 SORT_CTX_ARGS);
+    int split = SORT_FN(split_range)(part->tab, part->low + left * PARTITION_BLOCK,
+                                     part->high - right * PARTITION_BLOCK, part->low - 1 SORT_CTX_ARGS);
+    return SORT_FN(place_pivot)(part->tab, part->low - 1, split SORT_CTX_ARGS);
+}
+
+/**
+ * @brief Tri par base (LSD). Les clés, décalées pour ordonner les négatifs, sont réparties chiffre par
+ * chiffre de bits bits, du poids faible au poids fort ; un chiffre identique pour toutes les clés est sauté.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param bits Largeur d'un chiffre (1 à 16 bits).
+ */
+static void SORT_FN(radix_sort)(int tab[], int n, int bits SORT_CTX_PARAMS) {
+    if (n < 2) return;
+    if (bits < 1) bits = 1;
+    if (bits > 16) bits = 16;
+
+    size_t buckets = (size_t)1 << bits;
+    unsigned int mask = (unsigned int)(buckets - 1);
+    int *buffer = (int*)SortMalloc(n * sizeof(int));
+    size_t *count = (size_t*)SortMalloc(buckets * sizeof(size_t));
+    if (buffer == NULL || count == NULL) {
+        // Still sorted and stable, by rotations only.
+        fprintf(stderr, "Memory allocation failed\n");
+        SortFree(buffer);
+        SortFree(count);
+        SORT_FN(block_merge_sort)(tab, n, NULL, 0 SORT_CTX_ARGS);
+        return;
+    }
+
+    int *src = tab, *dst = buffer;
+    for (int shift = 0; shift < 32; shift += bits) {
+        memset(count, 0, buckets * sizeof(size_t));
+        for (int i = 0; i < n; i++) {
+            count[(((unsigned int)src[i] ^ 0x80000000u) >> shift) & mask]++;
+        }
+        if (count[(((unsigned int)src[0] ^ 0x80000000u) >> shift) & mask] == (size_t)n) continue;
+
+        size_t sum = 0;
+        for (size_t b = 0; b < buckets; b++) {
+            size_t c = count[b];
+            count[b] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < n; i++) {
+            size_t pos = count[(((unsigned int)src[i] ^ 0x80000000u) >> shift) & mask]++;
+            dst[pos] = src[i];
+            if (dst == tab) SORT_WRITE((int)pos, (int)pos);
+        }
+
+        int *swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != tab) {
+        for (int i = 0; i < n; i++) {
+            tab[i] = src[i];
+            SORT_WRITE(i, i);
+        }
+    }
+    SortFree(buffer);
+    SortFree(count);
+}
+
+/**
+ * @brief Tri par dénombrement. Il compte les occurrences de chaque clé entre le minimum et le maximum, puis
+ * réécrit le tableau dans l'ordre : O(n + étendue). Si les clés sont trop dispersées (étendue supérieure à
+ * 4n + 1024), le tri par base prend le relais.
+ *
+ * @param tab Tableau à trier.
+ * @param n Nombre d'éléments dans le tableau.
+ */
+static void SORT_FN(counting_sort)(int tab[], int n SORT_CTX_PARAMS) {
+    if (n < 2) return;
+
+    int min = tab[0], max = tab[0];
+    for (int i = 1; i < n; i++) {
+        if (tab[i] < min) min = tab[i];
+        if (tab[i] > max) max = tab[i];
+    }
+
+    size_t range = (size_t)((long long)max - min) + 1;
+    if (range > (size_t)n * 4 + 1024) {
+        SORT_FN(radix_sort)(tab, n, GetTuning()->radixBits SORT_CTX_ARGS);
+        return;
+    }
+
+    int *count = (int*)SortCalloc(range, sizeof(int));
+    if (count == NULL) {
+        // Counting sort is not stable either: the in-place quicksort takes over.
+        fprintf(stderr, "Memory allocation failed\n");
+        SORT_FN(quick_sort_range)(tab, 0, n - 1 SORT_CTX_ARGS);
+        return;
+    }
+    for (int i = 0; i < n; i++) count[tab[i] - min]++;
+
+    int k = 0;
+    for (size_t v = 0; v < range; v++) {
+        int value = (int)(min + (long long)v);
+        for (int c = 0; c < count[v]; c++) tab[k + c] = value;
+        SORT_WRITE_RANGE(k, count[v]);
+        k += count[v];
+    }
+    SortFree(count);
+}
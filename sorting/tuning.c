@@ -0,0 +1,152 @@
+#include "tuning.h"
+#include "../utils/host.h"
+#include "../utils/threadpool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file tuning.c
+ * @brief Paramètres réglables des tris et profil de réglage de la machine.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Le profil est un fichier texte de lignes clé=valeur (commentaires #), écrit par le réglage automatique
+ * et chargé au démarrage. Il porte l'empreinte de la machine : un profil réglé ailleurs est ignoré.
+ */
+
+/**
+ * @brief Paramètres en vigueur.
+ */
+static SortTuning tuning = { 16, 8, 1 << 16, 0 };
+
+/**
+ * @brief Valeurs par défaut : insertion sous 16 éléments, chiffres de 8 bits, 65 536 éléments par tâche,
+ * un thread par processeur.
+ *
+ * @param t Les paramètres à remplir.
+ */
+void TuningDefaults(SortTuning *t) {
+    t->insertionCutoff = 16;
+    t->radixBits = 8;
+    t->parallelGrain = 1 << 16;
+    t->threads = 0;
+}
+
+/**
+ * @brief Getteur des paramètres en vigueur.
+ */
+const SortTuning *GetTuning(void) {
+    return &tuning;
+}
+
+/**
+ * @brief Setteur des paramètres ; les valeurs hors limites sont ramenées dans leur intervalle.
+ *
+ * @param t Les nouveaux paramètres.
+ */
+void SetTuning(const SortTuning *t) {
+    tuning = *t;
+    if (tuning.insertionCutoff < 0) tuning.insertionCutoff = 0;
+    if (tuning.radixBits < 1) tuning.radixBits = 1;
+    if (tuning.radixBits > 16) tuning.radixBits = 16;
+    if (tuning.parallelGrain < 1024) tuning.parallelGrain = 1024;
+    if (tuning.threads < 0) tuning.threads = 0;
+}
+
+/**
+ * @brief Nombre de threads des tris parallèles.
+ *
+ * @return threads, ou le nombre de processeurs si threads vaut 0.
+ */
+int TuningThreads(void) {
+    return tuning.threads > 0 ? tuning.threads : GetCpuCount();
+}
+
+/**
+ * @brief Charge un profil de réglage et l'applique.
+ *
+ * @param path Le fichier de profil.
+ * @return 0 si le profil est appliqué, 1 si le fichier n'existe pas, -1 s'il est invalide ou provient
+ * d'une autre machine (les paramètres en vigueur sont alors conservés).
+ */
+int TuningLoad(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) return 1;
+
+    SortTuning loaded = tuning;
+    char host[64] = "";
+    int version = 0, status = 0, lineNumber = 0;
+    char line[256];
+
+    while (status == 0 && fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        char key[64], value[64];
+        if (sscanf(line, " %63[^= \t] = %63s", key, value) != 2) {
+            if (strspn(line, " \t\r\n") != strlen(line)) {
+                fprintf(stderr, "%s:%d: expected key=value\n", path, lineNumber);
+                status = -1;
+            }
+            continue;
+        }
+
+        if (strcmp(key, "version") == 0) version = atoi(value);
+        else if (strcmp(key, "host") == 0) snprintf(host, sizeof(host), "%s", value);
+        else if (strcmp(key, "insertion_cutoff") == 0) loaded.insertionCutoff = atoi(value);
+        else if (strcmp(key, "radix_bits") == 0) loaded.radixBits = atoi(value);
+        else if (strcmp(key, "parallel_grain") == 0) loaded.parallelGrain = atoi(value);
+        else if (strcmp(key, "threads") == 0) loaded.threads = atoi(value);
+        else fprintf(stderr, "%s:%d: unknown key '%s' ignored\n", path, lineNumber, key);
+    }
+    fclose(file);
+    if (status != 0) return -1;
+
+    if (version != TUNING_VERSION) {
+        fprintf(stderr, "%s: unsupported tuning profile version %d, using defaults\n", path, version);
+        return -1;
+    }
+
+    HostInfo info;
+    GetHostInfo(&info);
+    if (strcmp(host, info.fingerprint) != 0) {
+        fprintf(stderr, "%s: profile was tuned on another host (%s), using defaults\n", path, host);
+        return -1;
+    }
+
+    SetTuning(&loaded);
+    return 0;
+}
+
+/**
+ * @brief Écrit un profil de réglage pour la machine courante.
+ *
+ * @param path Le fichier de profil.
+ * @param t Les paramètres à enregistrer.
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+int TuningSave(const char *path, const SortTuning *t) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    HostInfo info;
+    GetHostInfo(&info);
+    fprintf(file, "# Sort tuning profile for %s (%s, %d CPUs)\n", info.cpu, info.system, info.cpus);
+    fprintf(file, "version=%d\n", TUNING_VERSION);
+    fprintf(file, "host=%s\n", info.fingerprint);
+    fprintf(file, "insertion_cutoff=%d\n", t->insertionCutoff);
+    fprintf(file, "radix_bits=%d\n", t->radixBits);
+    fprintf(file, "parallel_grain=%d\n", t->parallelGrain);
+    fprintf(file, "threads=%d\n", t->threads);
+
+    if (fclose(file) != 0) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
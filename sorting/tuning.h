@@ -0,0 +1,32 @@
+/**
+ * @file sorting/tuning.h
+ * @brief Paramètres réglables des tris (seuils, largeur de chiffre, parallélisme) et profil de réglage.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef TUNING_H
+#define TUNING_H
+
+#define TUNING_VERSION 1
+#define TUNING_DEFAULT_PATH "sort_tuning.profile"
+
+typedef struct SortTuning {
+    int insertionCutoff;  // QuickSort / MergeSort ranges of this size or less finish with insertion sort
+    int radixBits;        // digit width of RadixSort (1-16)
+    int parallelGrain;    // smallest range handed to a worker by the parallel sorts
+    int threads;          // workers of the parallel sorts (0: one per CPU)
+} SortTuning;
+
+void TuningDefaults(SortTuning *tuning);
+const SortTuning *GetTuning(void);
+void SetTuning(const SortTuning *tuning);
+// Workers used by the parallel sorts (threads, or the CPU count when threads is 0).
+int TuningThreads(void);
+
+// Load a profile written by TuningSave. Returns 0 if applied, 1 if the file does not exist,
+// -1 if it is invalid or was tuned on another host; the current values are kept in both cases.
+int TuningLoad(const char *path);
+int TuningSave(const char *path, const SortTuning *tuning);
+
+#endif // TUNING_H
@@ -0,0 +1,243 @@
+#include "verify.h"
+#include "tuning.h"
+#include "../utils/alloc.h"
+#include "../utils/threadpool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @file verify.c
+ * @brief Vérification du résultat d'un tri.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Le résultat doit être trié et contenir exactement les valeurs de l'entrée. L'ordre se vérifie en comparant
+ * chaque case à sa voisine, huit paires à la fois (SSE2) ; la permutation en comparant deux empreintes
+ * indépendantes de l'ordre : somme des valeurs et somme d'un mélange non linéaire de chaque valeur, calculées
+ * une fois sur l'entrée puis sur la sortie. Au-delà de VERIFY_PARALLEL_MIN éléments, le tableau est découpé
+ * entre les threads du profil de réglage.
+ */
+
+/**
+ * @brief Taille à partir de laquelle la vérification est répartie entre les threads.
+ */
+#define VERIFY_PARALLEL_MIN (1 << 20)
+
+/**
+ * @brief Cases traitées d'un bloc par un thread (32 Kio, le cache L1d).
+ */
+#define VERIFY_BLOCK 8192
+
+/**
+ * @brief Constantes du mélange de l'empreinte.
+ */
+#define CHECKSUM_K1 0x9E3779B9u
+#define CHECKSUM_K2 0x85EBCA6Bu
+
+/**
+ * @brief Mélange non linéaire d'une valeur : produit 32 x 32 -> 64 bits de deux masquages différents.
+ */
+static inline unsigned long long checksum_mix(unsigned int v) {
+    return (unsigned long long)(v ^ CHECKSUM_K1) * (unsigned long long)((v ^ CHECKSUM_K2) | 1u);
+}
+
+/**
+ * @brief Initialise une empreinte vide.
+ */
+void SortChecksumInit(SortChecksum *checksum) {
+    checksum->count = 0;
+    checksum->sum = 0;
+    checksum->hash = 0;
+}
+
+/**
+ * @brief Ajoute n valeurs à l'empreinte. L'ordre des appels et des valeurs est indifférent.
+ *
+ * @param checksum L'empreinte.
+ * @param tab Les valeurs.
+ * @param n Le nombre de valeurs.
+ */
+void SortChecksumAdd(SortChecksum *checksum, const int tab[], int n) {
+    unsigned long long sum = 0, hash = 0;
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i k1 = _mm_set1_epi32((int)CHECKSUM_K1);
+    const __m128i k2 = _mm_set1_epi32((int)CHECKSUM_K2);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sums = zero, hashes = zero;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(tab + i));
+        __m128i a = _mm_xor_si128(v, k1);
+        __m128i b = _mm_or_si128(_mm_xor_si128(v, k2), one);
+        // pmuludq multiplies the even lanes; the odd ones are shifted down first.
+        hashes = _mm_add_epi64(hashes, _mm_mul_epu32(a, b));
+        hashes = _mm_add_epi64(hashes, _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)));
+        sums = _mm_add_epi64(sums, _mm_unpacklo_epi32(v, zero));
+        sums = _mm_add_epi64(sums, _mm_unpackhi_epi32(v, zero));
+    }
+    unsigned long long lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, sums);
+    sum = lanes[0] + lanes[1];
+    _mm_storeu_si128((__m128i*)lanes, hashes);
+    hash = lanes[0] + lanes[1];
+#endif
+    for (; i < n; i++) {
+        sum += (unsigned int)tab[i];
+        hash += checksum_mix((unsigned int)tab[i]);
+    }
+    checksum->count += n;
+    checksum->sum += sum;
+    checksum->hash += hash;
+}
+
+/**
+ * @brief Indique si deux empreintes sont identiques.
+ */
+int SortChecksumEqual(const SortChecksum *a, const SortChecksum *b) {
+    return a->count == b->count && a->sum == b->sum && a->hash == b->hash;
+}
+
+/**
+ * @brief Premier indice i de [low, high) tel que tab[i] > tab[i + 1] (high <= n - 1), ou -1.
+ * Huit paires sont comparées par itération ; le premier groupe fautif est repris case par case.
+ */
+static int first_unsorted_range(const int tab[], int low, int high) {
+    int i = low;
+#if defined(__SSE2__)
+    for (; i + 8 <= high; i += 8) {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(tab + i));
+        __m128i b0 = _mm_loadu_si128((const __m128i*)(tab + i + 1));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(tab + i + 4));
+        __m128i b1 = _mm_loadu_si128((const __m128i*)(tab + i + 5));
+        __m128i bad = _mm_or_si128(_mm_cmpgt_epi32(a0, b0), _mm_cmpgt_epi32(a1, b1));
+        if (_mm_movemask_epi8(bad) != 0) break;
+    }
+#endif
+    for (; i < high; i++) {
+        if (tab[i] > tab[i + 1]) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Part du tableau vérifiée par un thread : les paires (i, i + 1) pour low <= i < high, et
+ * l'empreinte des cases [low, high) (ou [low, high] pour la dernière part).
+ */
+typedef struct VerifyTask {
+    const int *tab;
+    int low, high, last;
+    int checkOrder;
+    int checkSum;
+    int firstUnsorted;
+    SortChecksum checksum;
+} VerifyTask;
+
+static void verify_task(void *arg) {
+    VerifyTask *task = (VerifyTask*)arg;
+    task->firstUnsorted = -1;
+    SortChecksumInit(&task->checksum);
+    // Block by block, so that the checksum reads what the order check just brought into the cache.
+    int low = task->low;
+    do {
+        int high = task->high - low > VERIFY_BLOCK ? low + VERIFY_BLOCK : task->high;
+        if (task->checkOrder && task->firstUnsorted < 0) {
+            task->firstUnsorted = first_unsorted_range(task->tab, low, high);
+        }
+        if (task->checkSum) {
+            SortChecksumAdd(&task->checksum, task->tab + low, high - low + (task->last && high == task->high));
+        }
+        low = high;
+    } while (low < task->high);
+}
+
+/**
+ * @brief Parcourt le tableau en une passe, sur plusieurs threads s'il est assez grand.
+ *
+ * @param checksum Empreinte calculée (NULL : l'ordre seulement).
+ * @param checkOrder 0 pour ne calculer que l'empreinte.
+ * @return Le premier indice mal ordonné, ou -1.
+ */
+static int verify_pass(const int tab[], int n, int checkOrder, SortChecksum *checksum) {
+    if (checksum != NULL) SortChecksumInit(checksum);
+    if (n <= 0) return -1;
+
+    int threads = TuningThreads();
+    if (n < VERIFY_PARALLEL_MIN || threads < 2) threads = 1;
+    VerifyTask single;
+    VerifyTask *tasks = threads > 1 ? (VerifyTask*)SortMalloc(threads * sizeof(VerifyTask)) : &single;
+    ThreadPool *pool = tasks != NULL && threads > 1 ? ThreadPoolCreate(threads) : NULL;
+    if (pool == NULL) {
+        if (tasks != &single) SortFree(tasks);
+        tasks = &single;
+        threads = 1;
+    }
+
+    for (int t = 0; t < threads; t++) {
+        int last = t == threads - 1;
+        int low = (int)((long long)n * t / threads);
+        int high = last ? n - 1 : (int)((long long)n * (t + 1) / threads);
+        tasks[t] = (VerifyTask){ tab, low, high, last, checkOrder, checksum != NULL, -1, { 0, 0, 0 } };
+        if (pool == NULL || ThreadPoolSubmit(pool, verify_task, &tasks[t]) != 0) verify_task(&tasks[t]);
+    }
+    if (pool != NULL) ThreadPoolWait(pool);
+
+    int first = -1;
+    for (int t = 0; t < threads; t++) {
+        if (first < 0) first = tasks[t].firstUnsorted;
+        if (checksum != NULL) {
+            checksum->count += tasks[t].checksum.count;
+            checksum->sum += tasks[t].checksum.sum;
+            checksum->hash += tasks[t].checksum.hash;
+        }
+    }
+
+    ThreadPoolDestroy(pool);
+    if (tasks != &single) SortFree(tasks);
+    return first;
+}
+
+/**
+ * @brief Calcule l'empreinte d'un tableau entier.
+ *
+ * @param checksum L'empreinte calculée.
+ * @param tab Le tableau.
+ * @param n Le nombre d'éléments.
+ */
+void SortChecksumCompute(SortChecksum *checksum, const int tab[], int n) {
+    verify_pass(tab, n, 0, checksum);
+}
+
+/**
+ * @brief Cherche la première case plus grande que sa voisine de droite.
+ *
+ * @param tab Le tableau.
+ * @param n Le nombre d'éléments.
+ * @return Le premier indice i tel que tab[i] > tab[i + 1], ou -1 si le tableau est trié.
+ */
+int SortFirstUnsorted(const int tab[], int n) {
+    return verify_pass(tab, n, 1, NULL);
+}
+
+/**
+ * @brief Vérifie le résultat d'un tri : ordre croissant et même empreinte que l'entrée, en une seule passe.
+ *
+ * @param tab Le tableau trié.
+ * @param n Le nombre d'éléments.
+ * @param input L'empreinte de l'entrée (NULL : l'ordre seulement).
+ * @param verdict Le détail du résultat (peut être NULL).
+ * @return 0 si le tableau est une permutation triée de l'entrée, -1 sinon.
+ */
+int SortVerify(const int tab[], int n, const SortChecksum *input, SortVerdict *verdict) {
+    SortChecksum output;
+    int first = verify_pass(tab, n, 1, input != NULL ? &output : NULL);
+    int permutation = input == NULL || SortChecksumEqual(input, &output);
+    if (verdict != NULL) {
+        verdict->firstUnsorted = first;
+        verdict->permutation = permutation;
+    }
+    return first < 0 && permutation ? 0 : -1;
+}
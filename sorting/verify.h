@@ -0,0 +1,35 @@
+/**
+ * @file sorting/verify.h
+ * @brief Vérification du résultat d'un tri : ordre croissant et permutation de l'entrée (empreinte).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef VERIFY_H
+#define VERIFY_H
+
+// Order-independent fingerprint of a multiset of values: every permutation gives the same checksum.
+typedef struct SortChecksum {
+    long long count;
+    unsigned long long sum;   // values as unsigned, mod 2^64
+    unsigned long long hash;  // non-linear mix of every value, mod 2^64
+} SortChecksum;
+
+typedef struct SortVerdict {
+    int firstUnsorted;  // first i with arr[i] > arr[i + 1], -1 if sorted
+    int permutation;    // 1 if the checksum matches the input's
+} SortVerdict;
+
+void SortChecksumInit(SortChecksum *checksum);
+// Add n values to the checksum, e.g. block by block while an input is generated.
+void SortChecksumAdd(SortChecksum *checksum, const int arr[], int n);
+// Checksum of a whole array, split across the tuning threads for large arrays.
+void SortChecksumCompute(SortChecksum *checksum, const int arr[], int n);
+int SortChecksumEqual(const SortChecksum *a, const SortChecksum *b);
+
+// First i with arr[i] > arr[i + 1], or -1 if arr is sorted.
+int SortFirstUnsorted(const int arr[], int n);
+// Order and checksum in a single pass. Returns 0 for a sorted permutation of the input, -1 otherwise.
+int SortVerify(const int arr[], int n, const SortChecksum *input, SortVerdict *verdict);
+
+#endif // VERIFY_H
@@ -0,0 +1,255 @@
+#include "cachesim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file cachesim.c
+ * @brief Simulation d'une hiérarchie de caches associatifs par ensembles.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Chaque niveau est un cache associatif par ensembles à remplacement LRU, alloué en écriture, non inclusif :
+ * un accès est présenté à L1, puis au niveau suivant tant qu'il manque, et la ligne est chargée dans chaque
+ * niveau traversé. Les ensembles gardent leurs lignes de la plus récente à la plus ancienne.
+ */
+
+/**
+ * @brief Taille en octets d'un texte du type "48K", "2M" ou "32768", ou -1.
+ */
+static long parse_size(const char *text, char **end) {
+    char *stop;
+    long value = strtol(text, &stop, 10);
+    if (stop == text || value <= 0) return -1;
+    switch (*stop) {
+        case 'K': case 'k': value <<= 10; stop++; break;
+        case 'M': case 'm': value <<= 20; stop++; break;
+        case 'G': case 'g': value <<= 30; stop++; break;
+        default: break;
+    }
+    if (end) *end = stop;
+    return value;
+}
+
+/**
+ * @brief Lit un entier dans un fichier de sysfs, ou -1.
+ */
+static long read_sysfs_long(const char *dir, const char *file, int withSize) {
+    char path[256], line[64];
+    snprintf(path, sizeof(path), "%s/%s", dir, file);
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return -1;
+    long value = -1;
+    if (fgets(line, sizeof(line), f) != NULL) {
+        value = withSize ? parse_size(line, NULL) : strtol(line, NULL, 10);
+    }
+    fclose(f);
+    return value;
+}
+
+/**
+ * @brief Configuration des caches de données de cpu0 (sysfs), ou valeurs usuelles : L1d 32 Kio 8 voies,
+ * L2 1 Mio 16 voies, LLC 8 Mio 16 voies, lignes de 64 octets.
+ *
+ * @param config La configuration à remplir.
+ */
+void CacheDefaults(CacheConfig *config) {
+    memset(config, 0, sizeof(*config));
+
+    for (int index = 0; index < 10 && config->nbLevels < CACHE_MAX_LEVELS; index++) {
+        char dir[128], path[160], type[32] = "";
+        snprintf(dir, sizeof(dir), "/sys/devices/system/cpu/cpu0/cache/index%d", index);
+        snprintf(path, sizeof(path), "%s/type", dir);
+        FILE *f = fopen(path, "r");
+        if (f == NULL) break;
+        if (fgets(type, sizeof(type), f) == NULL) type[0] = '\0';
+        fclose(f);
+        if (strncmp(type, "Instruction", 11) == 0) continue;
+
+        long level = read_sysfs_long(dir, "level", 0);
+        long size = read_sysfs_long(dir, "size", 1);
+        long ways = read_sysfs_long(dir, "ways_of_associativity", 0);
+        long line = read_sysfs_long(dir, "coherency_line_size", 0);
+        if (level <= 0 || size <= 0 || ways <= 0 || line <= 0) continue;
+
+        CacheLevelConfig *c = &config->levels[config->nbLevels++];
+        snprintf(c->name, sizeof(c->name), "L%d", (int)(level % 100));
+        c->size = size;
+        c->ways = (int)ways;
+        config->lineSize = (int)line;
+    }
+
+    if (config->nbLevels == 0) {
+        CacheConfigParse(config, "line=64,L1=32K/8,L2=1M/16,L3=8M/16");
+    }
+}
+
+/**
+ * @brief Modifie une configuration à partir d'un texte "line=64,L1=48K/12,L2=2M/16". Si des niveaux sont
+ * donnés, ils remplacent tous les niveaux existants, dans l'ordre du texte.
+ *
+ * @param config La configuration à modifier (inchangée en cas d'erreur).
+ * @param spec Le texte.
+ * @return 0 en cas de succès, -1 si le texte est invalide.
+ */
+int CacheConfigParse(CacheConfig *config, const char *spec) {
+    CacheConfig result = *config;
+    int levelsGiven = 0;
+    const char *p = spec;
+
+    while (*p != '\0') {
+        const char *equal = strchr(p, '=');
+        if (equal == NULL) {
+            fprintf(stderr, "Invalid cache description '%s': expected key=value\n", p);
+            return -1;
+        }
+        size_t keyLen = (size_t)(equal - p);
+        char *end;
+
+        if (keyLen == 4 && strncmp(p, "line", 4) == 0) {
+            long line = strtol(equal + 1, &end, 10);
+            if (end == equal + 1 || line < 8 || (line & (line - 1)) != 0) {
+                fprintf(stderr, "Invalid cache line size in '%s'\n", spec);
+                return -1;
+            }
+            result.lineSize = (int)line;
+        } else if (keyLen >= 2 && keyLen < sizeof(result.levels[0].name) && (p[0] == 'L' || p[0] == 'l')) {
+            if (!levelsGiven) {
+                result.nbLevels = 0;
+                levelsGiven = 1;
+            }
+            long size = parse_size(equal + 1, &end);
+            long ways = size > 0 && *end == '/' ? strtol(end + 1, &end, 10) : -1;
+            if (size <= 0 || ways <= 0 || result.nbLevels == CACHE_MAX_LEVELS) {
+                fprintf(stderr, "Invalid cache level in '%s': expected Ln=SIZE/WAYS, at most %d levels\n",
+                        spec, CACHE_MAX_LEVELS);
+                return -1;
+            }
+            CacheLevelConfig *c = &result.levels[result.nbLevels++];
+            memcpy(c->name, p, keyLen);
+            c->name[keyLen] = '\0';
+            c->name[0] = 'L';
+            c->size = size;
+            c->ways = (int)ways;
+        } else {
+            fprintf(stderr, "Unknown cache key in '%s' (line, L1, L2...)\n", spec);
+            return -1;
+        }
+
+        if (*end != ',' && *end != '\0') {
+            fprintf(stderr, "Invalid cache description '%s'\n", spec);
+            return -1;
+        }
+        p = *end == ',' ? end + 1 : end;
+    }
+
+    for (int i = 0; i < result.nbLevels; i++) {
+        if (result.levels[i].size < (long)result.lineSize * result.levels[i].ways) {
+            fprintf(stderr, "Cache %s is smaller than one line per way\n", result.levels[i].name);
+            return -1;
+        }
+    }
+    *config = result;
+    return 0;
+}
+
+/**
+ * @brief Affiche la configuration sur une ligne.
+ */
+void CachePrintConfig(const CacheConfig *config) {
+    printf("line %d B", config->lineSize);
+    for (int i = 0; i < config->nbLevels; i++) {
+        const CacheLevelConfig *c = &config->levels[i];
+        if (c->size % (1 << 20) == 0) {
+            printf(", %s %ld MiB %d-way", c->name, c->size >> 20, c->ways);
+        } else {
+            printf(", %s %ld KiB %d-way", c->name, c->size >> 10, c->ways);
+        }
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Alloue les niveaux décrits par la configuration, vides.
+ *
+ * @param sim Le simulateur à initialiser.
+ * @param config La configuration (lignes puissance de 2).
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+int CacheSimInit(CacheSim *sim, const CacheConfig *config) {
+    memset(sim, 0, sizeof(*sim));
+    int shift = 0;
+    while ((1 << shift) < config->lineSize) shift++;
+    sim->lineShift = shift;
+
+    for (int i = 0; i < config->nbLevels; i++) {
+        CacheLevel *level = &sim->levels[i];
+        level->ways = config->levels[i].ways;
+        level->sets = config->levels[i].size / ((long)config->lineSize * level->ways);
+        if (level->sets < 1) level->sets = 1;
+        level->setMask = (level->sets & (level->sets - 1)) == 0 ? level->sets - 1 : -1;
+        level->tags = (unsigned long*)calloc((size_t)level->sets * level->ways, sizeof(unsigned long));
+        if (level->tags == NULL) {
+            fprintf(stderr, "Memory allocation failed\n");
+            CacheSimFree(sim);
+            return -1;
+        }
+        sim->nbLevels++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Libère les niveaux du simulateur.
+ */
+void CacheSimFree(CacheSim *sim) {
+    for (int i = 0; i < sim->nbLevels; i++) {
+        free(sim->levels[i].tags);
+        sim->levels[i].tags = NULL;
+    }
+    sim->nbLevels = 0;
+}
+
+/**
+ * @brief Vide les caches et remet les compteurs à zéro.
+ */
+void CacheSimReset(CacheSim *sim) {
+    for (int i = 0; i < sim->nbLevels; i++) {
+        CacheLevel *level = &sim->levels[i];
+        memset(level->tags, 0, (size_t)level->sets * level->ways * sizeof(unsigned long));
+        level->accesses = 0;
+        level->misses = 0;
+    }
+}
+
+/**
+ * @brief Simule un accès mémoire.
+ *
+ * @param sim Le simulateur.
+ * @param address L'adresse accédée.
+ * @return Le niveau qui a servi l'accès (0 pour L1), ou nbLevels s'il a fallu aller en mémoire.
+ */
+int CacheSimAccess(CacheSim *sim, unsigned long address) {
+    // Line numbers are stored plus one so that 0 marks an empty way.
+    unsigned long line = (address >> sim->lineShift) + 1;
+
+    for (int i = 0; i < sim->nbLevels; i++) {
+        CacheLevel *level = &sim->levels[i];
+        long set = level->setMask >= 0 ? (long)(line & (unsigned long)level->setMask) : (long)(line % level->sets);
+        unsigned long *ways = level->tags + set * level->ways;
+        level->accesses++;
+
+        int way = 0;
+        while (way < level->ways && ways[way] != line) way++;
+        if (way < level->ways) {
+            memmove(ways + 1, ways, way * sizeof(unsigned long));
+            ways[0] = line;
+            return i;
+        }
+
+        level->misses++;
+        memmove(ways + 1, ways, (level->ways - 1) * sizeof(unsigned long));
+        ways[0] = line;
+    }
+    return sim->nbLevels;
+}
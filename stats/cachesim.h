@@ -0,0 +1,52 @@
+/**
+ * @file stats/cachesim.h
+ * @brief Simulateur de hiérarchie de caches associatifs par ensembles (LRU), alimenté par des adresses.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef CACHESIM_H
+#define CACHESIM_H
+
+#define CACHE_MAX_LEVELS 4
+
+typedef struct CacheLevelConfig {
+    char name[8];
+    long size;  // bytes
+    int ways;
+} CacheLevelConfig;
+
+typedef struct CacheConfig {
+    int lineSize;  // bytes, shared by every level
+    int nbLevels;
+    CacheLevelConfig levels[CACHE_MAX_LEVELS]; // from the closest (L1d) to the last level
+} CacheConfig;
+
+typedef struct CacheLevel {
+    long sets;
+    int ways;
+    long setMask;          // sets - 1 when sets is a power of two, else -1
+    unsigned long *tags;   // sets * ways, most recently used first; 0 is an empty way
+    long long accesses;
+    long long misses;
+} CacheLevel;
+
+typedef struct CacheSim {
+    int lineShift;
+    int nbLevels;
+    CacheLevel levels[CACHE_MAX_LEVELS];
+} CacheSim;
+
+// Data and unified caches of cpu0 from sysfs, else 32K/8 L1d, 1M/16 L2 and 8M/16 LLC with 64-byte lines.
+void CacheDefaults(CacheConfig *config);
+// "line=64,L1=48K/12,L2=2M/16,L3=32M/16": the levels given replace the current ones. Returns 0 or -1.
+int CacheConfigParse(CacheConfig *config, const char *spec);
+void CachePrintConfig(const CacheConfig *config);
+
+int CacheSimInit(CacheSim *sim, const CacheConfig *config);
+void CacheSimFree(CacheSim *sim);
+void CacheSimReset(CacheSim *sim); // empty caches, zero counters
+// Level that served the access: 0 for L1, nbLevels for memory.
+int CacheSimAccess(CacheSim *sim, unsigned long address);
+
+#endif // CACHESIM_H
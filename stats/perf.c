@@ -0,0 +1,180 @@
+#define _GNU_SOURCE
+#include "perf.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file perf.c
+ * @brief Lecture des compteurs matériels via perf_event_open (Linux uniquement).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Chaque événement est ouvert séparément : si le noyau (perf_event_paranoid, machine virtuelle...)
+ * refuse l'un d'eux, les autres restent utilisables, et sans aucun compteur la mesure se limite au temps.
+ */
+
+static const char *event_names[PERF_EVENT_COUNT] = {
+    "cycles", "instructions", "branches", "branch-misses", "L1d-misses", "LLC-misses", "dTLB-misses"
+};
+
+/**
+ * @brief Nom lisible d'un événement.
+ */
+const char *PerfEventName(PerfEvent event) {
+    return (event >= 0 && event < PERF_EVENT_COUNT) ? event_names[event] : "?";
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Ouvre un compteur pour le processus courant, désactivé, hors noyau et hyperviseur. Le compteur est
+ * hérité par les threads créés ensuite (pools des tris parallèles, fusions en arrière-plan) : leurs
+ * événements s'ajoutent à sa lecture quand ils se terminent. Les compteurs étant lus un à un et non en
+ * groupe, l'héritage est permis.
+ *
+ * @return Le descripteur du compteur, ou -1 si le noyau le refuse.
+ */
+static int open_event(unsigned int type, unsigned long long config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.inherit = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    return fd < 0 ? -1 : (int)fd;
+}
+
+/**
+ * @brief Configuration d'un événement de cache (lecture manquée).
+ */
+static unsigned long long cache_miss(unsigned long long cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+/**
+ * @brief Ouvre tous les compteurs disponibles.
+ *
+ * @param counters Les compteurs à ouvrir.
+ * @return Le nombre de compteurs ouverts (0 : mesure du temps seulement).
+ */
+int PerfOpen(PerfCounters *counters) {
+    counters->fd[PERF_CYCLES] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    counters->fd[PERF_INSTRUCTIONS] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    counters->fd[PERF_BRANCHES] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS);
+    counters->fd[PERF_BRANCH_MISSES] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    counters->fd[PERF_L1D_MISSES] = open_event(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D));
+    counters->fd[PERF_LLC_MISSES] = open_event(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL));
+    counters->fd[PERF_DTLB_MISSES] = open_event(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB));
+
+    counters->nbOpen = 0;
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        if (counters->fd[e] >= 0) counters->nbOpen++;
+    }
+    return counters->nbOpen;
+}
+
+/**
+ * @brief Ferme les compteurs ouverts.
+ */
+void PerfClose(PerfCounters *counters) {
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        if (counters->fd[e] >= 0) close(counters->fd[e]);
+        counters->fd[e] = -1;
+    }
+    counters->nbOpen = 0;
+}
+
+/**
+ * @brief Remet à zéro et démarre les compteurs.
+ */
+void PerfStart(PerfCounters *counters) {
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        if (counters->fd[e] < 0) continue;
+        ioctl(counters->fd[e], PERF_EVENT_IOC_RESET, 0);
+        ioctl(counters->fd[e], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+/**
+ * @brief Arrête les compteurs et lit leurs valeurs, mises à l'échelle en cas de multiplexage.
+ *
+ * @param counters Les compteurs.
+ * @param sample Les valeurs lues.
+ */
+void PerfStop(PerfCounters *counters, PerfSample *sample) {
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        if (counters->fd[e] >= 0) ioctl(counters->fd[e], PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        unsigned long long data[3]; // value, time enabled, time running
+        sample->value[e] = 0;
+        sample->valid[e] = 0;
+        if (counters->fd[e] < 0) continue;
+        if (read(counters->fd[e], data, sizeof(data)) != (ssize_t)sizeof(data) || data[2] == 0) continue;
+
+        double scale = (double)data[1] / (double)data[2];
+        sample->value[e] = (long long)((double)data[0] * scale);
+        sample->valid[e] = 1;
+    }
+}
+
+#else
+
+int PerfOpen(PerfCounters *counters) {
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) counters->fd[e] = -1;
+    counters->nbOpen = 0;
+    return 0;
+}
+
+void PerfClose(PerfCounters *counters) {
+    (void)counters;
+}
+
+void PerfStart(PerfCounters *counters) {
+    (void)counters;
+}
+
+void PerfStop(PerfCounters *counters, PerfSample *sample) {
+    (void)counters;
+    memset(sample, 0, sizeof(*sample));
+}
+
+#endif
+
+/**
+ * @brief Instructions par cycle.
+ */
+double PerfIpc(const PerfSample *sample) {
+    if (!sample->valid[PERF_CYCLES] || !sample->valid[PERF_INSTRUCTIONS] || sample->value[PERF_CYCLES] == 0) return -1.0;
+    return (double)sample->value[PERF_INSTRUCTIONS] / (double)sample->value[PERF_CYCLES];
+}
+
+/**
+ * @brief Proportion de branchements mal prédits.
+ */
+double PerfBranchMissRate(const PerfSample *sample) {
+    if (!sample->valid[PERF_BRANCHES] || !sample->valid[PERF_BRANCH_MISSES] || sample->value[PERF_BRANCHES] == 0) return -1.0;
+    return (double)sample->value[PERF_BRANCH_MISSES] / (double)sample->value[PERF_BRANCHES];
+}
+
+/**
+ * @brief Nombre d'événements par élément trié.
+ */
+double PerfPerElement(const PerfSample *sample, PerfEvent event, long nbElements) {
+    if (!sample->valid[event] || nbElements <= 0) return -1.0;
+    return (double)sample->value[event] / (double)nbElements;
+}
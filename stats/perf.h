@@ -0,0 +1,47 @@
+/**
+ * @file stats/perf.h
+ * @brief Compteurs matériels (perf_event_open) autour d'une exécution d'algorithme.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef PERF_H
+#define PERF_H
+
+typedef enum PerfEvent {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCHES,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_EVENT_COUNT
+} PerfEvent;
+
+// One file descriptor per event; -1 when the kernel refused that event.
+typedef struct PerfCounters {
+    int fd[PERF_EVENT_COUNT];
+    int nbOpen;
+} PerfCounters;
+
+// Counter values of one measured region (scaled when the kernel multiplexed them).
+typedef struct PerfSample {
+    long long value[PERF_EVENT_COUNT];
+    int valid[PERF_EVENT_COUNT];
+} PerfSample;
+
+// Returns the number of counters opened (0: timing only).
+int PerfOpen(PerfCounters *counters);
+void PerfClose(PerfCounters *counters);
+void PerfStart(PerfCounters *counters);
+void PerfStop(PerfCounters *counters, PerfSample *sample);
+
+const char *PerfEventName(PerfEvent event);
+
+// Derived metrics; return a negative value when the inputs are not available.
+double PerfIpc(const PerfSample *sample);
+double PerfBranchMissRate(const PerfSample *sample);
+double PerfPerElement(const PerfSample *sample, PerfEvent event, long nbElements);
+
+#endif // PERF_H
@@ -0,0 +1,303 @@
+#define _POSIX_C_SOURCE 200809L
+#include "stats.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @file stats.c
+ * @brief Implémentation des méthodes de calcul de statistiques.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+/**
+ * @brief Compteurs d'opérations du dernier tri instrumenté de ce thread.
+ */
+static _Thread_local SortCounters counters = { 0, 0 };
+
+/**
+ * @brief Analyse et décision du dernier appel à AutoSort sur ce thread.
+ */
+static _Thread_local SortProfile lastAutoSort;
+
+/**
+ * @brief Nombre d'appels à AutoSort enregistrés sur ce thread.
+ */
+static _Thread_local long autoSortCount = 0;
+
+/**
+ * @brief Remet les compteurs d'opérations à zéro.
+ */
+void StatsResetCounters(void) {
+    counters.comparisons = 0;
+    counters.writes = 0;
+}
+
+/**
+ * @brief Getteur des compteurs d'opérations.
+ */
+SortCounters StatsGetCounters(void) {
+    return counters;
+}
+
+/**
+ * @brief Remet les compteurs d'opérations à une valeur lue plus tôt (StatsGetCounters), pour qu'une exécution
+ * auxiliaire du tri ne soit pas comptée.
+ *
+ * @param saved Les compteurs à rétablir.
+ */
+void StatsSetCounters(SortCounters saved) {
+    counters = saved;
+}
+
+/**
+ * @brief Compte une comparaison.
+ */
+void StatsCountComparison(void) {
+    counters.comparisons++;
+}
+
+/**
+ * @brief Compte des écritures dans le tableau.
+ *
+ * @param count Nombre d'écritures.
+ */
+void StatsCountWrites(int count) {
+    counters.writes += count;
+}
+
+/**
+ * @brief Horloge monotone, en secondes.
+ */
+double StatsNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Moyenne d'une série.
+ */
+double StatsMean(const double samples[], int count) {
+    if (count <= 0) return 0.0;
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) sum += samples[i];
+    return sum / count;
+}
+
+/**
+ * @brief Écart type (corrigé) d'une série.
+ */
+double StatsStddev(const double samples[], int count) {
+    if (count < 2) return 0.0;
+    double mean = StatsMean(samples, count);
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) sum += (samples[i] - mean) * (samples[i] - mean);
+    return sqrt(sum / (count - 1));
+}
+
+/**
+ * @brief Percentile d'une série triée (interpolation linéaire).
+ *
+ * @param sorted La série, triée par ordre croissant.
+ * @param count Le nombre de valeurs.
+ * @param p Le percentile, entre 0 et 1.
+ */
+double StatsPercentile(const double sorted[], int count, double p) {
+    if (count <= 0) return 0.0;
+    double pos = p * (count - 1);
+    int lo = (int)pos;
+    if (lo >= count - 1) return sorted[count - 1];
+    double frac = pos - lo;
+    return sorted[lo] + frac * (sorted[lo + 1] - sorted[lo]);
+}
+
+/**
+ * @brief Quantile 97,5 % de la loi de Student (intervalle de confiance bilatéral à 95 %).
+ *
+ * @param degrees Degrés de liberté.
+ */
+double StatsStudentT95(int degrees) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (degrees <= 0) return 0.0;
+    if (degrees <= 30) return table[degrees - 1];
+    if (degrees <= 60) return 2.000;
+    if (degrees <= 120) return 1.980;
+    return 1.960;
+}
+
+/**
+ * @brief Comparaison de deux doubles pour qsort.
+ */
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Résume une série de mesures : min, médiane, moyenne, écart type, p95 et intervalle de confiance à 95 %.
+ *
+ * Avec rejectOutliers, les valeurs dont le score z modifié (|x - médiane| / (1,4826 * MAD)) dépasse 3,5
+ * sont écartées avant le calcul.
+ *
+ * @param samples Les mesures.
+ * @param count Le nombre de mesures.
+ * @param rejectOutliers Écarter les valeurs aberrantes.
+ * @param summary Le résumé calculé.
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+int StatsSummarize(const double samples[], int count, int rejectOutliers, StatsSummary *summary) {
+    memset(summary, 0, sizeof(*summary));
+    if (count <= 0) return -1;
+
+    double *sorted = (double*)malloc(count * sizeof(double));
+    double *deviation = (double*)malloc(count * sizeof(double));
+    if (sorted == NULL || deviation == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(sorted);
+        free(deviation);
+        return -1;
+    }
+    memcpy(sorted, samples, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), compare_double);
+
+    int kept = count;
+    if (rejectOutliers && count >= 3) {
+        double median = StatsPercentile(sorted, count, 0.5);
+        for (int i = 0; i < count; i++) deviation[i] = fabs(sorted[i] - median);
+        qsort(deviation, count, sizeof(double), compare_double);
+        double mad = StatsPercentile(deviation, count, 0.5) * 1.4826;
+
+        if (mad > 0.0) {
+            kept = 0;
+            for (int i = 0; i < count; i++) {
+                if (fabs(sorted[i] - median) / mad <= 3.5) sorted[kept++] = sorted[i];
+            }
+        }
+    }
+
+    summary->count = kept;
+    summary->rejected = count - kept;
+    summary->min = sorted[0];
+    summary->max = sorted[kept - 1];
+    summary->median = StatsPercentile(sorted, kept, 0.5);
+    summary->p95 = StatsPercentile(sorted, kept, 0.95);
+    summary->mean = StatsMean(sorted, kept);
+    summary->stddev = StatsStddev(sorted, kept);
+
+    double half = kept > 1 ? StatsStudentT95(kept - 1) * summary->stddev / sqrt((double)kept) : 0.0;
+    summary->ciLow = summary->mean - half;
+    summary->ciHigh = summary->mean + half;
+
+    free(sorted);
+    free(deviation);
+    return 0;
+}
+
+/**
+ * @brief Mesure et origine (0 : première série, 1 : seconde) pour le classement du test de Mann-Whitney.
+ */
+typedef struct RankedSample {
+    double value;
+    int group;
+} RankedSample;
+
+/**
+ * @brief Comparaison de deux mesures classées pour qsort.
+ */
+static int compare_ranked(const void *a, const void *b) {
+    double x = ((const RankedSample*)a)->value, y = ((const RankedSample*)b)->value;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Test unilatéral de Mann-Whitney : la seconde série tend-elle à être plus grande que la première ?
+ *
+ * Les rangs ex æquo reçoivent leur rang moyen ; U est comparé à sa loi normale approchée, avec correction
+ * des ex æquo et de continuité.
+ *
+ * @param a La série de référence.
+ * @param na Le nombre de mesures de a.
+ * @param b La série comparée.
+ * @param nb Le nombre de mesures de b.
+ * @return La p-valeur (1 si le test n'est pas applicable).
+ */
+double StatsMannWhitneyGreater(const double a[], int na, const double b[], int nb) {
+    if (na <= 0 || nb <= 0) return 1.0;
+
+    int total = na + nb;
+    RankedSample *all = (RankedSample*)malloc(total * sizeof(RankedSample));
+    if (all == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return 1.0;
+    }
+    for (int i = 0; i < na; i++) all[i] = (RankedSample){ a[i], 0 };
+    for (int i = 0; i < nb; i++) all[na + i] = (RankedSample){ b[i], 1 };
+    qsort(all, total, sizeof(RankedSample), compare_ranked);
+
+    double rankSumB = 0.0, ties = 0.0;
+    for (int i = 0; i < total; ) {
+        int j = i;
+        while (j + 1 < total && all[j + 1].value == all[i].value) j++;
+        double rank = (i + j) / 2.0 + 1.0;
+        for (int k = i; k <= j; k++) {
+            if (all[k].group == 1) rankSumB += rank;
+        }
+        double t = j - i + 1;
+        ties += t * t * t - t;
+        i = j + 1;
+    }
+    free(all);
+
+    double u = rankSumB - nb * (nb + 1) / 2.0;
+    double mean = na * (double)nb / 2.0;
+    double variance = na * (double)nb / 12.0 * ((total + 1) - ties / ((double)total * (total - 1)));
+    if (variance <= 0.0) return 1.0;
+
+    double z = (u - mean - 0.5) / sqrt(variance);
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+/**
+ * @brief Enregistre l'analyse de l'entrée et la décision d'un appel à AutoSort.
+ *
+ * @param profile L'analyse et la décision.
+ */
+void StatsRecordAutoSort(const SortProfile *profile) {
+    lastAutoSort = *profile;
+    autoSortCount++;
+}
+
+/**
+ * @brief Getteur de la dernière analyse enregistrée (NULL si AutoSort n'a pas encore été appelé).
+ */
+const SortProfile *StatsLastAutoSort(void) {
+    return autoSortCount > 0 ? &lastAutoSort : NULL;
+}
+
+/**
+ * @brief Getteur du nombre d'appels à AutoSort enregistrés.
+ */
+long StatsAutoSortCount(void) {
+    return autoSortCount;
+}
+
+/**
+ * @brief Affiche une analyse et la décision associée.
+ *
+ * @param profile L'analyse (rien n'est affiché si NULL).
+ */
+void StatsPrintAutoSort(const SortProfile *profile) {
+    if (profile == NULL) return;
+    printf("AutoSort: n = %d, runs %d up / %d down, inversions ~%.3g (%.1f%% of pairs), keys [%d, %d] (range %.0f), duplicates %.1f%%\n",
+           profile->n, profile->ascendingRuns, profile->descendingRuns, profile->inversions,
+           profile->inversionRatio * 100.0, profile->min, profile->max, profile->range, profile->duplicateRatio * 100.0);
+    printf("AutoSort: %s (%s), analysis %.3f ms\n", profile->algorithm, profile->reason, profile->analysisSeconds * 1e3);
+}
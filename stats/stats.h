@@ -1,14 +1,71 @@
-/**
- * @file stats.h
- * @brief Ensemble des méthodes pour le calcul de statistiques.
- * @author MUZARD Thomas
- * @date 27/10/2025
- */
-
-#ifndef STATS_H
-
-#define STATS_H
-
-// TODO : Declare statistical functions
-
-#endif // STATS_H
\ No newline at end of file
+/**
+ * @file stats.h
+ * @brief Ensemble des méthodes pour le calcul de statistiques.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef STATS_H
+
+#define STATS_H
+
+// Operation counters fed by the instrumented algorithms (*_viz), one set per thread.
+typedef struct SortCounters {
+    long long comparisons;
+    long long writes;
+} SortCounters;
+
+void StatsResetCounters(void);
+SortCounters StatsGetCounters(void);
+void StatsSetCounters(SortCounters saved); // restore counters saved around an uncounted run
+void StatsCountComparison(void);
+void StatsCountWrites(int count);
+
+// Monotonic wall clock, in seconds.
+double StatsNow(void);
+
+// Summary of repeated measurements (after optional MAD outlier rejection).
+typedef struct StatsSummary {
+    int count;      // samples kept
+    int rejected;   // samples rejected as outliers
+    double min;
+    double max;
+    double median;
+    double mean;
+    double stddev;
+    double p95;
+    double ciLow;   // 95% confidence interval of the mean
+    double ciHigh;
+} StatsSummary;
+
+double StatsMean(const double samples[], int count);
+double StatsStddev(const double samples[], int count);
+double StatsPercentile(const double sorted[], int count, double p);
+double StatsStudentT95(int degrees);
+int StatsSummarize(const double samples[], int count, int rejectOutliers, StatsSummary *summary);
+
+// One-sided Mann-Whitney U test (normal approximation): p-value that b tends to exceed a.
+double StatsMannWhitneyGreater(const double a[], int na, const double b[], int nb);
+
+// Input analysis and decision of an AutoSort call.
+typedef struct SortProfile {
+    int n;
+    int ascendingRuns;      // maximal non-decreasing runs
+    int descendingRuns;     // maximal non-increasing runs
+    double inversionRatio;  // sampled fraction of inverted pairs (0: sorted, 1: reversed)
+    double inversions;      // inversionRatio * n(n-1)/2; exact up to 2n when ascendingRuns <= n/32
+    int min;
+    int max;
+    double range;           // max - min + 1
+    double duplicateRatio;  // 1 - distinct / n (exact for dense keys, sampled otherwise)
+    double analysisSeconds;
+    const char *algorithm;  // algorithm chosen by the dispatcher
+    const char *reason;
+} SortProfile;
+
+void StatsRecordAutoSort(const SortProfile *profile);
+const SortProfile *StatsLastAutoSort(void); // NULL before the first AutoSort
+long StatsAutoSortCount(void);
+void StatsPrintAutoSort(const SortProfile *profile);
+
+#endif // STATS_H
@@ -0,0 +1,480 @@
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file trace.c
+ * @brief Journal d'opérations des tris instrumentés et relecture par points de reprise.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Chaque appel du callback de visualisation, ou chaque étape d'un événement livré par lot (TraceEventSink),
+ * devient une opération du journal (la paire mise en évidence et les valeurs écrites). Toutes les `interval` opérations, un point de reprise est ajouté : soit un
+ * instantané complet du tableau, soit uniquement les cases modifiées depuis le point précédent.
+ * Un instantané complet n'est repris que lorsque les deltas cumulés dépassent la taille du tableau,
+ * ce qui borne à la fois la mémoire (proportionnelle au nombre d'opérations) et le coût d'une
+ * restauration (au plus une copie complète et n écritures). Le journal et les points de reprise tiennent
+ * dans maxBytes octets : au-delà, l'enregistrement s'arrête et la trace est marquée tronquée.
+ */
+
+/**
+ * @brief Trace en cours d'enregistrement par TraceCaptureCallback sur ce thread.
+ */
+static _Thread_local Trace *capture_trace = NULL;
+
+/**
+ * @brief Indique si la trace peut encore prendre more octets sans dépasser maxBytes.
+ */
+static int fits(const Trace *trace, size_t more) {
+    return trace->bytes <= trace->maxBytes && more <= trace->maxBytes - trace->bytes;
+}
+
+/**
+ * @brief Ajoute un point de reprise décrivant l'état courant (shadow) de la trace.
+ *
+ * @param trace La trace en cours d'enregistrement.
+ * @return 0 en cas de succès, TRACE_STOP_MEMORY en cas d'échec d'allocation, TRACE_STOP_BUDGET si le point
+ * de reprise dépasserait maxBytes.
+ */
+static int push_keyframe(Trace *trace) {
+    if (trace->nbKeyframes == trace->capKeyframes) {
+        long cap = trace->capKeyframes ? trace->capKeyframes * 2 : 64;
+        size_t grow = (size_t)(cap - trace->capKeyframes) * sizeof(TraceKeyframe);
+        if (!fits(trace, grow)) return TRACE_STOP_BUDGET;
+        TraceKeyframe *tmp = realloc(trace->keyframes, cap * sizeof(TraceKeyframe));
+        if (tmp == NULL) {
+            fprintf(stderr, "Memory allocation failed\n");
+            return TRACE_STOP_MEMORY;
+        }
+        trace->keyframes = tmp;
+        trace->capKeyframes = cap;
+        trace->bytes += grow;
+    }
+
+    TraceKeyframe *kf = &trace->keyframes[trace->nbKeyframes];
+    int n = trace->n;
+
+    // Collect the cells that really changed since the previous keyframe.
+    int changed = 0;
+    for (int d = 0; d < trace->nbDirty; d++) {
+        int idx = trace->dirtyList[d];
+        trace->dirty[idx] = 0;
+        if (trace->shadow[idx] != trace->lastKeyframe[idx]) {
+            trace->dirtyList[changed++] = idx;
+        }
+    }
+    trace->nbDirty = 0;
+
+    if (trace->nbKeyframes == 0 || trace->deltaSinceFull + changed > n) {
+        kf->count = -1;
+        kf->indices = NULL;
+        if (!fits(trace, n * sizeof(int))) return TRACE_STOP_BUDGET;
+        kf->values = (int*)malloc(n * sizeof(int));
+        if (kf->values == NULL) {
+            fprintf(stderr, "Memory allocation failed\n");
+            return TRACE_STOP_MEMORY;
+        }
+        memcpy(kf->values, trace->shadow, n * sizeof(int));
+        trace->bytes += n * sizeof(int);
+        trace->deltaSinceFull = 0;
+    } else {
+        kf->count = changed;
+        kf->indices = NULL;
+        kf->values = NULL;
+        if (changed > 0) {
+            if (!fits(trace, 2 * changed * sizeof(int))) return TRACE_STOP_BUDGET;
+            kf->indices = (int*)malloc(changed * sizeof(int));
+            kf->values = (int*)malloc(changed * sizeof(int));
+            if (kf->indices == NULL || kf->values == NULL) {
+                free(kf->indices);
+                free(kf->values);
+                fprintf(stderr, "Memory allocation failed\n");
+                return TRACE_STOP_MEMORY;
+            }
+            trace->bytes += 2 * changed * sizeof(int);
+            for (int d = 0; d < changed; d++) {
+                kf->indices[d] = trace->dirtyList[d];
+                kf->values[d] = trace->shadow[trace->dirtyList[d]];
+            }
+        }
+        trace->deltaSinceFull += changed;
+    }
+
+    for (int d = 0; d < changed; d++) {
+        int idx = trace->dirtyList[d];
+        trace->lastKeyframe[idx] = trace->shadow[idx];
+    }
+
+    trace->nbKeyframes++;
+    return 0;
+}
+
+/**
+ * @brief Marque une case comme modifiée depuis le dernier point de reprise.
+ *
+ * @param trace La trace en cours d'enregistrement.
+ * @param idx Indice de la case modifiée.
+ */
+static void mark_dirty(Trace *trace, int idx) {
+    if (!trace->dirty[idx]) {
+        trace->dirty[idx] = 1;
+        trace->dirtyList[trace->nbDirty++] = idx;
+    }
+}
+
+/**
+ * @brief Crée une trace vide à partir de l'état initial du tableau.
+ *
+ * @param tab Tableau avant le tri.
+ * @param n Nombre d'éléments dans le tableau.
+ * @param interval Nombre d'opérations entre deux points de reprise (<= 0 pour la valeur par défaut).
+ * @return La trace allouée, ou NULL en cas d'échec.
+ */
+Trace *TraceCreate(const int tab[], int n, int interval) {
+    if (n <= 0) return NULL;
+
+    Trace *trace = (Trace*)calloc(1, sizeof(Trace));
+    if (trace == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
+    }
+
+    trace->n = n;
+    trace->interval = interval > 0 ? interval : TRACE_DEFAULT_INTERVAL;
+    trace->maxBytes = TRACE_MAX_BYTES;
+    trace->shadow = (int*)malloc(n * sizeof(int));
+    trace->lastKeyframe = (int*)malloc(n * sizeof(int));
+    trace->dirtyList = (int*)malloc(n * sizeof(int));
+    trace->dirty = (unsigned char*)calloc(n, 1);
+    if (!trace->shadow || !trace->lastKeyframe || !trace->dirtyList || !trace->dirty) {
+        fprintf(stderr, "Memory allocation failed\n");
+        TraceFree(trace);
+        return NULL;
+    }
+
+    memcpy(trace->shadow, tab, n * sizeof(int));
+    memcpy(trace->lastKeyframe, tab, n * sizeof(int));
+
+    if (push_keyframe(trace) != 0) {
+        TraceFree(trace);
+        return NULL;
+    }
+    return trace;
+}
+
+/**
+ * @brief Libère une trace et tous ses points de reprise.
+ *
+ * @param trace La trace à libérer (peut être NULL).
+ */
+void TraceFree(Trace *trace) {
+    if (trace == NULL) return;
+
+    for (long k = 0; k < trace->nbKeyframes; k++) {
+        free(trace->keyframes[k].indices);
+        free(trace->keyframes[k].values);
+    }
+    free(trace->keyframes);
+    free(trace->ops);
+    free(trace->shadow);
+    free(trace->lastKeyframe);
+    free(trace->dirtyList);
+    free(trace->dirty);
+    free(trace);
+}
+
+/**
+ * @brief Enregistre une opération : la paire (a, b) et celles des valeurs value_a / value_b qui diffèrent de
+ * l'état enregistré. Le journal double tant qu'il tient dans maxBytes. Après un échec d'allocation ou une
+ * fois maxBytes atteint, la trace est marquée tronquée et n'enregistre plus rien : les points de reprise
+ * suivants seraient décalés et la relecture rejouerait de mauvais états.
+ */
+static void record_op(Trace *trace, int a, int b, int value_a, int value_b, unsigned char kind) {
+    if (trace->truncated) return;
+    if (trace->nbOps == trace->capOps) {
+        long cap = trace->capOps ? trace->capOps * 2 : 4096;
+        long room = fits(trace, 0) ? (long)((trace->maxBytes - trace->bytes) / sizeof(TraceOp)) : 0;
+        if (cap - trace->capOps > room) cap = trace->capOps + room;
+        if (cap == trace->capOps) {
+            trace->truncated = TRACE_STOP_BUDGET;
+            return;
+        }
+        TraceOp *tmp = realloc(trace->ops, cap * sizeof(TraceOp));
+        if (tmp == NULL) {
+            fprintf(stderr, "Memory allocation failed\n");
+            trace->truncated = TRACE_STOP_MEMORY;
+            return;
+        }
+        trace->bytes += (size_t)(cap - trace->capOps) * sizeof(TraceOp);
+        trace->ops = tmp;
+        trace->capOps = cap;
+    }
+
+    TraceOp *op = &trace->ops[trace->nbOps];
+    op->a = a;
+    op->b = b;
+    op->value_a = 0;
+    op->value_b = 0;
+    op->writes = 0;
+    op->kind = kind;
+
+    if (a >= 0 && a < trace->n && value_a != trace->shadow[a]) {
+        op->writes |= TRACE_WRITE_A;
+        op->value_a = value_a;
+        trace->shadow[a] = value_a;
+        mark_dirty(trace, a);
+    }
+    if (b >= 0 && b < trace->n && value_b != trace->shadow[b]) {
+        op->writes |= TRACE_WRITE_B;
+        op->value_b = value_b;
+        trace->shadow[b] = value_b;
+        mark_dirty(trace, b);
+    }
+
+    trace->nbOps++;
+    if (trace->nbOps % trace->interval == 0) trace->truncated = push_keyframe(trace);
+}
+
+/**
+ * @brief Enregistre une opération de nature connue, dont les valeurs sont lues dans le tableau.
+ */
+static void record_step(Trace *trace, const int tab[], int a, int b, unsigned char kind) {
+    record_op(trace, a, b, a >= 0 && a < trace->n ? tab[a] : 0, b >= 0 && b < trace->n ? tab[b] : 0, kind);
+}
+
+/**
+ * @brief Enregistre une opération : la paire (a, b) et les valeurs qui y ont été écrites depuis l'opération précédente.
+ * Le callback ne dit pas ce que le tri a fait : une opération sans valeur modifiée est notée comme une
+ * comparaison, une seule case modifiée comme une écriture, deux comme un échange.
+ *
+ * @param trace La trace en cours d'enregistrement.
+ * @param tab Le tableau en cours de tri.
+ * @param a Indice du premier élément mis en évidence.
+ * @param b Indice du second élément mis en évidence.
+ */
+void TraceRecord(Trace *trace, const int tab[], int a, int b) {
+    if (trace == NULL || trace->shadow == NULL) return;
+    long recorded = trace->nbOps;
+    record_step(trace, tab, a, b, TRACE_OP_COMPARE);
+    if (trace->nbOps == recorded) return;
+    TraceOp *op = &trace->ops[recorded];
+    if (op->writes == (TRACE_WRITE_A | TRACE_WRITE_B)) op->kind = TRACE_OP_SWAP;
+    else if (op->writes != 0) op->kind = TRACE_OP_WRITE;
+}
+
+/**
+ * @brief Nature des opérations d'un événement.
+ */
+static unsigned char event_kind(int type) {
+    switch (type) {
+        case SORT_EVENT_COMPARE:
+            return TRACE_OP_COMPARE;
+        case SORT_EVENT_WRITE:
+        case SORT_EVENT_WRITE_RANGE:
+            return TRACE_OP_WRITE;
+        default:
+            return TRACE_OP_SWAP;
+    }
+}
+
+/**
+ * @brief Consommateur d'événements (SortRunEvents) qui enregistre dans la trace passée en user. Une opération
+ * sur une zone donne autant d'opérations que d'appels du callback de visualisation, avec les valeurs
+ * recopiées à son émission (SortEventStepValues).
+ *
+ * @param arr Le tableau en cours de tri.
+ * @param n Le nombre d'éléments dans le tableau.
+ * @param events Les événements du lot.
+ * @param count Le nombre d'événements.
+ * @param user La trace.
+ */
+void TraceEventSink(const int arr[], int n, const SortEvent events[], int count, void *user) {
+    Trace *trace = (Trace*)user;
+    if (trace == NULL || trace->shadow == NULL) return;
+
+    for (int i = 0; i < count; i++) {
+        const SortEvent *event = &events[i];
+        unsigned char kind = event_kind(event->type);
+        if (event->type < SORT_EVENT_WRITE_RANGE) {
+            record_op(trace, event->a, event->b, event->value_a, event->value_b, kind);
+            continue;
+        }
+        long steps = SortEventSteps(event);
+        for (long s = 0; s < steps; s++) {
+            int a, b, value_a, value_b;
+            SortEventStep(event, s, &a, &b);
+            SortEventStepValues(event, s, arr, n, &value_a, &value_b);
+            record_op(trace, a, b, value_a, value_b, kind);
+        }
+    }
+}
+
+/**
+ * @brief Termine l'enregistrement : rattrape les écritures non signalées puis libère l'état d'enregistrement.
+ *
+ * @param trace La trace en cours d'enregistrement.
+ * @param tab Le tableau après le tri.
+ */
+void TraceFinish(Trace *trace, const int tab[]) {
+    if (trace == NULL || trace->shadow == NULL) return;
+
+    for (int i = 0; i < trace->n && !trace->truncated; i++) {
+        if (tab[i] != trace->shadow[i]) {
+            record_step(trace, tab, i, i, TRACE_OP_WRITE);
+        }
+    }
+
+    free(trace->shadow);
+    free(trace->lastKeyframe);
+    free(trace->dirtyList);
+    free(trace->dirty);
+    trace->shadow = NULL;
+    trace->lastKeyframe = NULL;
+    trace->dirtyList = NULL;
+    trace->dirty = NULL;
+}
+
+/**
+ * @brief Getteur du nombre d'opérations enregistrées.
+ */
+long TraceLength(const Trace *trace) {
+    return trace ? trace->nbOps : 0;
+}
+
+/**
+ * @brief Démarre la capture : TraceCaptureCallback enregistrera dans cette trace.
+ *
+ * @param trace La trace à remplir.
+ */
+void TraceBeginCapture(Trace *trace) {
+    capture_trace = trace;
+}
+
+/**
+ * @brief Termine la capture en cours.
+ *
+ * @param tab Le tableau après le tri.
+ */
+void TraceEndCapture(const int tab[]) {
+    TraceFinish(capture_trace, tab);
+    capture_trace = NULL;
+}
+
+/**
+ * @brief Callback de visualisation qui enregistre chaque étape dans la trace en cours de capture.
+ *
+ * @param arr Le tableau en cours de tri.
+ * @param n Le nombre d'éléments dans le tableau.
+ * @param a Indice du premier élément mis en évidence.
+ * @param b Indice du second élément mis en évidence.
+ */
+void TraceCaptureCallback(int arr[], int n, int a, int b) {
+    (void)n;
+    TraceRecord(capture_trace, arr, a, b);
+}
+
+/**
+ * @brief Applique une opération du journal à l'état du lecteur.
+ *
+ * @param state L'état à modifier.
+ * @param op L'opération à rejouer.
+ */
+static void apply_op(int state[], const TraceOp *op) {
+    if (op->writes & TRACE_WRITE_A) state[op->a] = op->value_a;
+    if (op->writes & TRACE_WRITE_B) state[op->b] = op->value_b;
+}
+
+/**
+ * @brief Restaure un point de reprise : dernier instantané complet puis deltas successifs.
+ *
+ * @param trace La trace.
+ * @param k Indice du point de reprise.
+ * @param state L'état à remplir.
+ */
+static void restore_keyframe(const Trace *trace, long k, int state[]) {
+    long full = k;
+    while (full > 0 && trace->keyframes[full].count != -1) {
+        full--;
+    }
+
+    memcpy(state, trace->keyframes[full].values, trace->n * sizeof(int));
+    for (long j = full + 1; j <= k; j++) {
+        const TraceKeyframe *kf = &trace->keyframes[j];
+        for (int d = 0; d < kf->count; d++) {
+            state[kf->indices[d]] = kf->values[d];
+        }
+    }
+}
+
+/**
+ * @brief Initialise un lecteur positionné au début de la trace.
+ *
+ * @param player Le lecteur à initialiser.
+ * @param trace La trace à relire.
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+int TracePlayerInit(TracePlayer *player, const Trace *trace) {
+    player->trace = trace;
+    player->step = 0;
+    player->state = (int*)malloc(trace->n * sizeof(int));
+    if (player->state == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return -1;
+    }
+    restore_keyframe(trace, 0, player->state);
+    return 0;
+}
+
+/**
+ * @brief Libère l'état d'un lecteur.
+ *
+ * @param player Le lecteur.
+ */
+void TracePlayerFree(TracePlayer *player) {
+    free(player->state);
+    player->state = NULL;
+}
+
+/**
+ * @brief Positionne le lecteur après `step` opérations. Le coût est au plus une restauration
+ * de point de reprise suivie de `interval` opérations rejouées.
+ *
+ * @param player Le lecteur.
+ * @param step Étape cible (bornée à [0, TraceLength]).
+ */
+void TraceSeek(TracePlayer *player, long step) {
+    const Trace *trace = player->trace;
+    if (step < 0) step = 0;
+    if (step > trace->nbOps) step = trace->nbOps;
+
+    long from = player->step;
+    if (step < from || step - from > trace->interval) {
+        long k = step / trace->interval;
+        if (k >= trace->nbKeyframes) k = trace->nbKeyframes - 1;
+        restore_keyframe(trace, k, player->state);
+        from = k * trace->interval;
+    }
+
+    for (long s = from; s < step; s++) {
+        apply_op(player->state, &trace->ops[s]);
+    }
+    player->step = step;
+}
+
+/**
+ * @brief Indices mis en évidence par la dernière opération rejouée (-1 au début de la trace).
+ *
+ * @param player Le lecteur.
+ * @param a Premier indice.
+ * @param b Second indice.
+ */
+void TraceHighlight(const TracePlayer *player, int *a, int *b) {
+    if (player->step > 0) {
+        *a = player->trace->ops[player->step - 1].a;
+        *b = player->trace->ops[player->step - 1].b;
+    } else {
+        *a = -1;
+        *b = -1;
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * @file trace/trace.h
+ * @brief Enregistrement des tris instrumentés dans un journal d'opérations avec points de reprise (keyframes), pour une relecture navigable.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef TRACE_H
+
+#define TRACE_H
+
+#include <stddef.h>
+#include "../sorting/sorting.h"
+#include "../sorting/events.h"
+
+// Default number of operations between two keyframes.
+#define TRACE_DEFAULT_INTERVAL 1024
+
+// Bytes a trace may hold in operations and keyframes (Trace.maxBytes): recording stops there.
+#define TRACE_MAX_BYTES ((size_t)256 << 20)
+
+// Trace.truncated: why recording stopped before the end of the sort.
+#define TRACE_STOP_MEMORY 1 // an allocation failed
+#define TRACE_STOP_BUDGET 2 // maxBytes reached
+
+// Flags of TraceOp.writes: which of the two indices received a new value.
+#define TRACE_WRITE_A 1
+#define TRACE_WRITE_B 2
+
+// TraceOp.kind: the operation the sort performed, even when it left the values unchanged.
+#define TRACE_OP_COMPARE 0
+#define TRACE_OP_WRITE 1   // a written
+#define TRACE_OP_SWAP 2    // a and b exchanged
+
+// One recorded step: the highlighted pair and the values written at a / b (if any).
+typedef struct TraceOp {
+    int a;
+    int b;
+    int value_a;
+    int value_b;
+    unsigned char writes;
+    unsigned char kind;
+} TraceOp;
+
+// Array state after (index * interval) operations. A keyframe is either a full
+// snapshot (count == -1) or the list of (index, value) pairs that changed since
+// the previous keyframe.
+typedef struct TraceKeyframe {
+    int count;
+    int *indices;
+    int *values;
+} TraceKeyframe;
+
+typedef struct Trace {
+    int n;
+    int interval;
+
+    TraceOp *ops;
+    long nbOps;
+    long capOps;
+
+    TraceKeyframe *keyframes;
+    long nbKeyframes;
+    long capKeyframes;
+
+    // Recording state.
+    int *shadow;          // array state after the last recorded op
+    int *lastKeyframe;    // array state at the last keyframe
+    int *dirtyList;       // indices written since the last keyframe
+    int nbDirty;
+    unsigned char *dirty;
+    long deltaSinceFull;  // delta entries stored since the last full snapshot
+    size_t bytes;         // held by ops and keyframes
+    size_t maxBytes;      // TRACE_MAX_BYTES unless lowered after TraceCreate
+    int truncated;        // 0, or the TRACE_STOP_* reason: ops cover a prefix of the sort
+} Trace;
+
+// Cursor over a recorded trace: state holds the array after `step` operations.
+typedef struct TracePlayer {
+    const Trace *trace;
+    int *state;
+    long step;
+} TracePlayer;
+
+// Recording
+Trace *TraceCreate(const int tab[], int n, int interval);
+void TraceFree(Trace *trace);
+void TraceRecord(Trace *trace, const int tab[], int a, int b); // kind inferred from the values written
+void TraceFinish(Trace *trace, const int tab[]);
+long TraceLength(const Trace *trace);
+
+// VizCallback recording into the trace given to TraceBeginCapture.
+void TraceBeginCapture(Trace *trace);
+void TraceEndCapture(const int tab[]);
+void TraceCaptureCallback(int arr[], int n, int a, int b);
+
+// SortEventSink recording into the Trace given as user (see SortRunEvents), then TraceFinish.
+void TraceEventSink(const int arr[], int n, const SortEvent events[], int count, void *user);
+
+// Playback
+int TracePlayerInit(TracePlayer *player, const Trace *trace);
+void TracePlayerFree(TracePlayer *player);
+void TraceSeek(TracePlayer *player, long step);
+void TraceHighlight(const TracePlayer *player, int *a, int *b);
+
+#endif // TRACE_H
@@ -0,0 +1,340 @@
+#include "alloc.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file alloc.c
+ * @brief Couche d'allocation des tris et de l'échantillon.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Chaque bloc est précédé d'un en-tête qui garde sa taille et le dorsal (backend) qui l'a servi : un bloc
+ * peut donc être libéré après un changement de dorsal. Les compteurs appartiennent à une exécution (AllocRun)
+ * et sont atomiques, les tris parallèles allouant depuis plusieurs threads ; le dorsal et l'exécution courants
+ * sont propres à chaque thread, la réserve de threads transmettant l'exécution à ses tâches.
+ */
+
+/**
+ * @brief En-tête placé devant chaque bloc, de taille multiple de l'alignement maximal.
+ */
+typedef struct BlockHeader {
+    size_t size;
+    void (*release)(void *state, void *block, size_t size);
+    void *state;
+} BlockHeader;
+
+#define HEADER_SIZE ((sizeof(BlockHeader) + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t))
+
+static void *heap_alloc(void *state, size_t size) {
+    (void)state;
+    return malloc(size);
+}
+
+static void heap_release(void *state, void *block, size_t size) {
+    (void)state;
+    (void)size;
+    free(block);
+}
+
+/**
+ * @brief Dorsal courant du thread (le tas par défaut).
+ */
+static _Thread_local Allocator backend = { heap_alloc, heap_release, NULL };
+
+/**
+ * @brief Exécution à laquelle le thread impute ses allocations (aucune par défaut).
+ */
+static _Thread_local AllocRun *current_run = NULL;
+
+/**
+ * @brief Classe de taille d'une demande : partie entière de log2(size).
+ */
+static int size_class(size_t size) {
+    int bucket = 0;
+    while (size > 1 && bucket < ALLOC_HISTOGRAM_BUCKETS - 1) {
+        size >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+/**
+ * @brief Compte une demande ; les blocs du tas entrent aussi dans la mémoire vive et son pic.
+ */
+static void count_alloc(size_t size, int fromHeap) {
+    AllocRun *run = current_run;
+    if (run == NULL) return;
+
+    atomic_fetch_add_explicit(&run->bytesAllocated, size, memory_order_relaxed);
+    atomic_fetch_add_explicit(&run->allocations, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&run->histogram[size_class(size)], 1, memory_order_relaxed);
+    if (!fromHeap) {
+        atomic_fetch_add_explicit(&run->arenaAllocations, 1, memory_order_relaxed);
+        return;
+    }
+
+    long long live = atomic_fetch_add_explicit(&run->liveBytes, (long long)size, memory_order_relaxed) + (long long)size;
+    long long peak = atomic_load_explicit(&run->peakBytes, memory_order_relaxed);
+    while (live > peak && !atomic_compare_exchange_weak_explicit(&run->peakBytes, &peak, live,
+                                                                 memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Compte une libération ; un bloc du tas quitte aussi la mémoire vive.
+ */
+static void count_free(size_t size, int fromHeap) {
+    AllocRun *run = current_run;
+    if (run == NULL) return;
+
+    atomic_fetch_add_explicit(&run->frees, 1, memory_order_relaxed);
+    if (fromHeap) atomic_fetch_sub_explicit(&run->liveBytes, (long long)size, memory_order_relaxed);
+}
+
+/**
+ * @brief Sert un bloc depuis le dorsal courant, ou depuis le tas s'il ne peut pas.
+ */
+static void *block_alloc(size_t size) {
+    if (size > SIZE_MAX - HEADER_SIZE) return NULL;
+
+    Allocator from = backend;
+    unsigned char *raw = (unsigned char*)from.alloc(from.state, HEADER_SIZE + size);
+    if (raw == NULL && from.release != heap_release) {
+        from = AllocHeap();
+        raw = (unsigned char*)malloc(HEADER_SIZE + size);
+    }
+    if (raw == NULL) return NULL;
+
+    BlockHeader *header = (BlockHeader*)raw;
+    header->size = size;
+    header->release = from.release;
+    header->state = from.state;
+    count_alloc(size, from.release == heap_release);
+    return raw + HEADER_SIZE;
+}
+
+/**
+ * @brief Alloue size octets via le dorsal courant et compte la demande.
+ *
+ * @return Le bloc, ou NULL en cas d'échec.
+ */
+void *SortMalloc(size_t size) {
+    return block_alloc(size);
+}
+
+/**
+ * @brief Alloue count * size octets mis à zéro.
+ *
+ * @return Le bloc, ou NULL en cas d'échec.
+ */
+void *SortCalloc(size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) return NULL;
+    void *block = block_alloc(count * size);
+    if (block != NULL) memset(block, 0, count * size);
+    return block;
+}
+
+/**
+ * @brief Libère un bloc de SortMalloc, SortCalloc ou SortRealloc auprès du dorsal qui l'a servi.
+ */
+void SortFree(void *block) {
+    if (block == NULL) return;
+    BlockHeader *header = (BlockHeader*)((unsigned char*)block - HEADER_SIZE);
+    size_t size = header->size;
+
+    count_free(size, header->release == heap_release);
+    header->release(header->state, header, HEADER_SIZE + size);
+}
+
+/**
+ * @brief Redimensionne un bloc. Un bloc du tas reste sur le tas (realloc) ; un bloc d'arène est recopié
+ * dans un bloc du dorsal courant.
+ *
+ * @return Le bloc redimensionné, ou NULL en cas d'échec (l'ancien bloc reste valide).
+ */
+void *SortRealloc(void *block, size_t size) {
+    if (block == NULL) return block_alloc(size);
+    if (size > SIZE_MAX - HEADER_SIZE) return NULL;
+
+    BlockHeader *header = (BlockHeader*)((unsigned char*)block - HEADER_SIZE);
+    size_t oldSize = header->size;
+
+    if (header->release == heap_release) {
+        BlockHeader *moved = (BlockHeader*)realloc(header, HEADER_SIZE + size);
+        if (moved == NULL) return NULL;
+        moved->size = size;
+        // Counted as freeing the old block and allocating the new one.
+        count_free(oldSize, 1);
+        count_alloc(size, 1);
+        return (unsigned char*)moved + HEADER_SIZE;
+    }
+
+    void *copy = block_alloc(size);
+    if (copy == NULL) return NULL;
+    memcpy(copy, block, oldSize < size ? oldSize : size);
+    SortFree(block);
+    return copy;
+}
+
+/**
+ * @brief Change le dorsal du thread appelant.
+ *
+ * @param next Le nouveau dorsal.
+ * @return Le dorsal précédent, à rétablir avec AllocSetBackend.
+ */
+Allocator AllocSetBackend(const Allocator *next) {
+    Allocator previous = backend;
+    backend = *next;
+    return previous;
+}
+
+/**
+ * @brief Dorsal d'usage général (malloc / free).
+ */
+Allocator AllocHeap(void) {
+    Allocator heap = { heap_alloc, heap_release, NULL };
+    return heap;
+}
+
+static void *arena_alloc(void *state, size_t size) {
+    Arena *arena = (Arena*)state;
+    size_t align = _Alignof(max_align_t);
+    size_t rounded = (size + align - 1) / align * align;
+    if (rounded < size || rounded > arena->capacity - arena->used) return NULL;
+
+    void *block = arena->base + arena->used;
+    arena->used += rounded;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    return block;
+}
+
+/**
+ * @brief Libération dans l'arène : seul le dernier bloc servi rend sa place (ordre LIFO), les autres
+ * attendent ArenaReset.
+ */
+static void arena_release(void *state, void *block, size_t size) {
+    Arena *arena = (Arena*)state;
+    size_t align = _Alignof(max_align_t);
+    size_t rounded = (size + align - 1) / align * align;
+    if ((unsigned char*)block + rounded == arena->base + arena->used) arena->used -= rounded;
+}
+
+/**
+ * @brief Réserve le tampon d'une arène (depuis le tas, compté dans les statistiques).
+ *
+ * @param arena L'arène.
+ * @param capacity Sa taille en octets.
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+int ArenaInit(Arena *arena, size_t capacity) {
+    Allocator heap = AllocHeap();
+    Allocator previous = AllocSetBackend(&heap);
+    arena->base = (unsigned char*)SortMalloc(capacity);
+    AllocSetBackend(&previous);
+
+    arena->capacity = arena->base ? capacity : 0;
+    arena->used = 0;
+    arena->peak = 0;
+    return arena->base ? 0 : -1;
+}
+
+/**
+ * @brief Rend toute la place de l'arène ; les blocs servis jusque-là ne doivent plus être utilisés.
+ */
+void ArenaReset(Arena *arena) {
+    arena->used = 0;
+}
+
+/**
+ * @brief Libère le tampon de l'arène.
+ */
+void ArenaRelease(Arena *arena) {
+    SortFree(arena->base);
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+}
+
+/**
+ * @brief Dorsal servant les blocs depuis une arène (qui doit survivre aux blocs servis).
+ */
+Allocator ArenaAllocator(Arena *arena) {
+    Allocator allocator = { arena_alloc, arena_release, arena };
+    return allocator;
+}
+
+/**
+ * @brief Taille d'arène nécessaire pour que des blocs de ces tailles y coexistent, en-têtes compris.
+ */
+size_t ArenaFootprint(const size_t sizes[], int count) {
+    size_t align = _Alignof(max_align_t);
+    size_t total = 0;
+    for (int i = 0; i < count; i++) total += (HEADER_SIZE + sizes[i] + align - 1) / align * align;
+    return total;
+}
+
+/**
+ * @brief Remet les compteurs d'une exécution à zéro.
+ */
+void AllocRunInit(AllocRun *run) {
+    atomic_init(&run->bytesAllocated, 0);
+    atomic_init(&run->liveBytes, 0);
+    atomic_init(&run->peakBytes, 0);
+    atomic_init(&run->allocations, 0);
+    atomic_init(&run->frees, 0);
+    atomic_init(&run->arenaAllocations, 0);
+    for (int b = 0; b < ALLOC_HISTOGRAM_BUCKETS; b++) atomic_init(&run->histogram[b], 0);
+}
+
+/**
+ * @brief Change l'exécution à laquelle le thread appelant impute ses allocations et libérations.
+ *
+ * La mémoire vive d'une exécution part de zéro : un bloc alloué avant elle et libéré pendant la fait
+ * descendre sous zéro sans fausser le pic, qui reste mesuré depuis son début.
+ *
+ * @param run L'exécution (NULL : plus de comptage), qui doit survivre à son utilisation.
+ * @return L'exécution précédente, à rétablir avec AllocRunSet.
+ */
+AllocRun *AllocRunSet(AllocRun *run) {
+    AllocRun *previous = current_run;
+    current_run = run;
+    return previous;
+}
+
+/**
+ * @brief Getteur de l'exécution courante du thread.
+ */
+AllocRun *AllocRunCurrent(void) {
+    return current_run;
+}
+
+/**
+ * @brief Copie les compteurs d'une exécution ; une mémoire vive négative est ramenée à zéro.
+ */
+void AllocRunGet(AllocRun *run, AllocStats *stats) {
+    long long live = atomic_load(&run->liveBytes);
+    stats->bytesAllocated = atomic_load(&run->bytesAllocated);
+    stats->liveBytes = live > 0 ? (size_t)live : 0;
+    stats->peakBytes = (size_t)atomic_load(&run->peakBytes);
+    stats->allocations = atomic_load(&run->allocations);
+    stats->frees = atomic_load(&run->frees);
+    stats->arenaAllocations = atomic_load(&run->arenaAllocations);
+    for (int b = 0; b < ALLOC_HISTOGRAM_BUCKETS; b++) stats->histogram[b] = atomic_load(&run->histogram[b]);
+}
+
+/**
+ * @brief Affiche les compteurs et les classes de taille non vides.
+ */
+void AllocStatsPrint(const AllocStats *stats) {
+    printf("Allocations: %ld (%ld from an arena), %ld frees, %zu bytes requested, peak %zu bytes, %zu bytes live\n",
+           stats->allocations, stats->arenaAllocations, stats->frees, stats->bytesAllocated,
+           stats->peakBytes, stats->liveBytes);
+    for (int b = 0; b < ALLOC_HISTOGRAM_BUCKETS; b++) {
+        if (stats->histogram[b] == 0) continue;
+        printf("  %12zu - %12zu bytes: %ld\n", b == 0 ? (size_t)0 : (size_t)1 << b, ((size_t)1 << (b + 1)) - 1,
+               stats->histogram[b]);
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * @file utils/alloc.h
+ * @brief Couche d'allocation des tris : comptage des octets, pic de mémoire vive, histogramme des tailles,
+ * et allocateur par arène pour la mémoire temporaire.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+// Size classes of the histogram: bucket i counts requests of [2^i, 2^(i+1)) bytes (bucket 0 also counts 0).
+#define ALLOC_HISTOGRAM_BUCKETS 40
+
+// Backend that serves the blocks of SortMalloc and friends.
+typedef struct Allocator {
+    void *(*alloc)(void *state, size_t size);              // NULL when the backend cannot serve the block
+    void (*release)(void *state, void *block, size_t size);
+    void *state;
+} Allocator;
+
+// Bump allocator over one block: allocation is a pointer increment, freeing only pops the last block.
+typedef struct Arena {
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+    size_t peak;
+} Arena;
+
+// Counters of one run, fed by the threads where it is current (AllocRunSet) and by the thread pool tasks
+// they submit: concurrent runs keep separate counters.
+typedef struct AllocRun {
+    atomic_size_t bytesAllocated;
+    atomic_llong liveBytes;  // signed: a block allocated before the run may be freed during it
+    atomic_llong peakBytes;
+    atomic_long allocations;
+    atomic_long frees;
+    atomic_long arenaAllocations;
+    atomic_long histogram[ALLOC_HISTOGRAM_BUCKETS];
+} AllocRun;
+
+// Snapshot of a run (AllocRunGet).
+typedef struct AllocStats {
+    size_t bytesAllocated;  // bytes requested, every backend
+    size_t liveBytes;       // heap bytes the run left allocated (arena blocks live inside their arena's buffer)
+    size_t peakBytes;       // maximum of liveBytes during the run, on top of what was live when it started
+    long allocations;       // requests, every backend
+    long frees;
+    long arenaAllocations;  // requests served by an arena
+    long histogram[ALLOC_HISTOGRAM_BUCKETS];
+} AllocStats;
+
+void *SortMalloc(size_t size);
+void *SortCalloc(size_t count, size_t size);
+void *SortRealloc(void *block, size_t size);
+void SortFree(void *block);
+
+// Backend of the calling thread (the heap unless changed); returns the previous one so it can be restored.
+Allocator AllocSetBackend(const Allocator *backend);
+// General-purpose backend (malloc / free).
+Allocator AllocHeap(void);
+
+// The arena's own buffer comes from the heap and is counted in the statistics. Returns 0 or -1.
+int ArenaInit(Arena *arena, size_t capacity);
+void ArenaReset(Arena *arena);
+void ArenaRelease(Arena *arena);
+// Backend serving blocks from arena; requests that do not fit fall back to the heap.
+Allocator ArenaAllocator(Arena *arena);
+// Bytes an arena needs to hold blocks of the given sizes at the same time.
+size_t ArenaFootprint(const size_t sizes[], int count);
+
+void AllocRunInit(AllocRun *run);
+// Run charged by the calling thread's allocations (NULL: none); returns the previous one so it can be restored.
+AllocRun *AllocRunSet(AllocRun *run);
+AllocRun *AllocRunCurrent(void);
+void AllocRunGet(AllocRun *run, AllocStats *stats);
+void AllocStatsPrint(const AllocStats *stats);
+
+#endif // ALLOC_H
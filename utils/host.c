@@ -0,0 +1,55 @@
+#define _GNU_SOURCE
+#include "host.h"
+#include "threadpool.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/utsname.h>
+
+/**
+ * @file host.c
+ * @brief Description et empreinte de la machine.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+/**
+ * @brief Décrit la machine courante : modèle de processeur, système, nombre de processeurs et empreinte
+ * (hachage FNV-1a de ces trois champs).
+ *
+ * @param host La description à remplir.
+ */
+void GetHostInfo(HostInfo *host) {
+    memset(host, 0, sizeof(*host));
+    snprintf(host->cpu, sizeof(host->cpu), "unknown");
+    snprintf(host->system, sizeof(host->system), "unknown");
+    host->cpus = GetCpuCount();
+
+    FILE *cpuinfo = fopen("/proc/cpuinfo", "r");
+    if (cpuinfo) {
+        char line[256];
+        while (fgets(line, sizeof(line), cpuinfo)) {
+            char *colon = strchr(line, ':');
+            if (strncmp(line, "model name", 10) != 0 || colon == NULL) continue;
+            char *value = colon + 1;
+            while (*value == ' ') value++;
+            value[strcspn(value, "\n")] = '\0';
+            snprintf(host->cpu, sizeof(host->cpu), "%s", value);
+            break;
+        }
+        fclose(cpuinfo);
+    }
+
+    struct utsname name;
+    if (uname(&name) == 0) {
+        snprintf(host->system, sizeof(host->system), "%s %s %s", name.sysname, name.release, name.machine);
+    }
+
+    char key[400];
+    snprintf(key, sizeof(key), "%s|%s|%d", host->cpu, host->system, host->cpus);
+    unsigned long long hash = 1469598103934665603ULL;
+    for (const char *c = key; *c; c++) {
+        hash ^= (unsigned char)*c;
+        hash *= 1099511628211ULL;
+    }
+    snprintf(host->fingerprint, sizeof(host->fingerprint), "%016llx", hash);
+}
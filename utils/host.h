@@ -0,0 +1,20 @@
+/**
+ * @file utils/host.h
+ * @brief Description et empreinte de la machine (processeur, système, nombre de processeurs).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef HOST_H
+#define HOST_H
+
+typedef struct HostInfo {
+    char fingerprint[17]; // FNV-1a of cpu, system and cpus, in hex
+    char cpu[128];
+    char system[200];
+    int cpus;
+} HostInfo;
+
+void GetHostInfo(HostInfo *host);
+
+#endif // HOST_H
@@ -0,0 +1,414 @@
+#include "json.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file json.c
+ * @brief Lecteur JSON minimal par descente récursive.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+/**
+ * @brief Profondeur maximale d'imbrication acceptée.
+ */
+#define JSON_MAX_DEPTH 64
+
+/**
+ * @brief Position de lecture dans le texte.
+ */
+typedef struct JsonReader {
+    const char *start;
+    const char *pos;
+    int failed;
+} JsonReader;
+
+static JsonValue *parse_value(JsonReader *reader, int depth);
+
+/**
+ * @brief Signale une erreur de syntaxe (une seule fois) avec sa position.
+ */
+static void fail(JsonReader *reader, const char *message) {
+    if (!reader->failed) {
+        fprintf(stderr, "JSON error at offset %ld: %s\n", (long)(reader->pos - reader->start), message);
+    }
+    reader->failed = 1;
+}
+
+/**
+ * @brief Saute les blancs.
+ */
+static void skip_spaces(JsonReader *reader) {
+    while (isspace((unsigned char)*reader->pos)) reader->pos++;
+}
+
+/**
+ * @brief Alloue une valeur du type donné.
+ */
+static JsonValue *new_value(JsonReader *reader, JsonType type) {
+    JsonValue *value = (JsonValue*)calloc(1, sizeof(JsonValue));
+    if (value == NULL) {
+        fail(reader, "out of memory");
+        return NULL;
+    }
+    value->type = type;
+    return value;
+}
+
+/**
+ * @brief Ajoute un élément (et sa clé pour un objet) à un tableau ou un objet.
+ */
+static int append_item(JsonReader *reader, JsonValue *container, char *key, JsonValue *item) {
+    JsonValue **items = realloc(container->items, (container->count + 1) * sizeof(JsonValue*));
+    if (items == NULL) {
+        fail(reader, "out of memory");
+        return -1;
+    }
+    container->items = items;
+    if (container->type == JSON_OBJECT) {
+        char **keys = realloc(container->keys, (container->count + 1) * sizeof(char*));
+        if (keys == NULL) {
+            fail(reader, "out of memory");
+            return -1;
+        }
+        container->keys = keys;
+        container->keys[container->count] = key;
+    }
+    container->items[container->count++] = item;
+    return 0;
+}
+
+/**
+ * @brief Écrit un point de code en UTF-8.
+ */
+static char *put_utf8(char *out, unsigned int code) {
+    if (code < 0x80) {
+        *out++ = (char)code;
+    } else if (code < 0x800) {
+        *out++ = (char)(0xC0 | (code >> 6));
+        *out++ = (char)(0x80 | (code & 0x3F));
+    } else {
+        *out++ = (char)(0xE0 | (code >> 12));
+        *out++ = (char)(0x80 | ((code >> 6) & 0x3F));
+        *out++ = (char)(0x80 | (code & 0x3F));
+    }
+    return out;
+}
+
+/**
+ * @brief Lit une chaîne entre guillemets et décode ses échappements.
+ */
+static char *parse_string(JsonReader *reader) {
+    if (*reader->pos != '"') {
+        fail(reader, "expected string");
+        return NULL;
+    }
+    reader->pos++;
+
+    const char *end = reader->pos;
+    while (*end && *end != '"') {
+        if (*end == '\\' && end[1]) end++;
+        end++;
+    }
+    if (*end != '"') {
+        fail(reader, "unterminated string");
+        return NULL;
+    }
+
+    // Decoded text is never longer than the escaped one.
+    char *result = (char*)malloc(end - reader->pos + 1);
+    if (result == NULL) {
+        fail(reader, "out of memory");
+        return NULL;
+    }
+
+    char *out = result;
+    while (reader->pos < end) {
+        char c = *reader->pos++;
+        if (c != '\\') {
+            *out++ = c;
+            continue;
+        }
+        c = *reader->pos++;
+        switch (c) {
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'n': *out++ = '\n'; break;
+            case 'r': *out++ = '\r'; break;
+            case 't': *out++ = '\t'; break;
+            case 'u': {
+                unsigned int code = 0;
+                for (int i = 0; i < 4 && reader->pos < end; i++) {
+                    char h = *reader->pos++;
+                    code = code * 16 + (unsigned int)(isdigit((unsigned char)h) ? h - '0' : (tolower((unsigned char)h) - 'a' + 10));
+                }
+                out = put_utf8(out, code);
+                break;
+            }
+            default: *out++ = c; break;
+        }
+    }
+    *out = '\0';
+    reader->pos = end + 1;
+    return result;
+}
+
+/**
+ * @brief Lit un objet { "clé": valeur, ... }.
+ */
+static JsonValue *parse_object(JsonReader *reader, int depth) {
+    JsonValue *object = new_value(reader, JSON_OBJECT);
+    if (object == NULL) return NULL;
+    reader->pos++;
+
+    skip_spaces(reader);
+    if (*reader->pos == '}') {
+        reader->pos++;
+        return object;
+    }
+
+    while (!reader->failed) {
+        skip_spaces(reader);
+        char *key = parse_string(reader);
+        if (key == NULL) break;
+
+        skip_spaces(reader);
+        if (*reader->pos != ':') {
+            fail(reader, "expected ':'");
+            free(key);
+            break;
+        }
+        reader->pos++;
+
+        JsonValue *item = parse_value(reader, depth + 1);
+        if (item == NULL || append_item(reader, object, key, item) != 0) {
+            free(key);
+            JsonFree(item);
+            break;
+        }
+
+        skip_spaces(reader);
+        if (*reader->pos == ',') {
+            reader->pos++;
+        } else if (*reader->pos == '}') {
+            reader->pos++;
+            return object;
+        } else {
+            fail(reader, "expected ',' or '}'");
+        }
+    }
+
+    JsonFree(object);
+    return NULL;
+}
+
+/**
+ * @brief Lit un tableau [valeur, ...].
+ */
+static JsonValue *parse_array(JsonReader *reader, int depth) {
+    JsonValue *array = new_value(reader, JSON_ARRAY);
+    if (array == NULL) return NULL;
+    reader->pos++;
+
+    skip_spaces(reader);
+    if (*reader->pos == ']') {
+        reader->pos++;
+        return array;
+    }
+
+    while (!reader->failed) {
+        JsonValue *item = parse_value(reader, depth + 1);
+        if (item == NULL || append_item(reader, array, NULL, item) != 0) {
+            JsonFree(item);
+            break;
+        }
+
+        skip_spaces(reader);
+        if (*reader->pos == ',') {
+            reader->pos++;
+        } else if (*reader->pos == ']') {
+            reader->pos++;
+            return array;
+        } else {
+            fail(reader, "expected ',' or ']'");
+        }
+    }
+
+    JsonFree(array);
+    return NULL;
+}
+
+/**
+ * @brief Lit une valeur quelconque.
+ */
+static JsonValue *parse_value(JsonReader *reader, int depth) {
+    if (depth > JSON_MAX_DEPTH) {
+        fail(reader, "nesting too deep");
+        return NULL;
+    }
+
+    skip_spaces(reader);
+    char c = *reader->pos;
+
+    if (c == '{') return parse_object(reader, depth);
+    if (c == '[') return parse_array(reader, depth);
+
+    if (c == '"') {
+        char *s = parse_string(reader);
+        if (s == NULL) return NULL;
+        JsonValue *value = new_value(reader, JSON_STRING);
+        if (value == NULL) {
+            free(s);
+            return NULL;
+        }
+        value->string = s;
+        return value;
+    }
+
+    if (strncmp(reader->pos, "true", 4) == 0 || strncmp(reader->pos, "false", 5) == 0) {
+        JsonValue *value = new_value(reader, JSON_BOOL);
+        if (value == NULL) return NULL;
+        value->boolean = c == 't';
+        reader->pos += value->boolean ? 4 : 5;
+        return value;
+    }
+
+    if (strncmp(reader->pos, "null", 4) == 0) {
+        reader->pos += 4;
+        return new_value(reader, JSON_NULL);
+    }
+
+    char *end;
+    double number = strtod(reader->pos, &end);
+    if (end == reader->pos) {
+        fail(reader, "unexpected character");
+        return NULL;
+    }
+    reader->pos = end;
+    JsonValue *value = new_value(reader, JSON_NUMBER);
+    if (value) value->number = number;
+    return value;
+}
+
+/**
+ * @brief Analyse un document JSON.
+ *
+ * @param text Le texte du document.
+ * @return L'arbre de valeurs (à libérer avec JsonFree), ou NULL en cas d'erreur.
+ */
+JsonValue *JsonParse(const char *text) {
+    JsonReader reader = { text, text, 0 };
+    JsonValue *root = parse_value(&reader, 0);
+    if (root == NULL) return NULL;
+
+    skip_spaces(&reader);
+    if (*reader.pos != '\0') {
+        fail(&reader, "trailing characters");
+        JsonFree(root);
+        return NULL;
+    }
+    return root;
+}
+
+/**
+ * @brief Lit et analyse un fichier JSON.
+ *
+ * @param path Chemin du fichier.
+ * @return L'arbre de valeurs, ou NULL si le fichier est absent ou invalide.
+ */
+JsonValue *JsonParseFile(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    char *text = (char*)malloc(size + 1);
+    if (text == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        fclose(file);
+        return NULL;
+    }
+    size_t read = fread(text, 1, size, file);
+    text[read] = '\0';
+    fclose(file);
+
+    JsonValue *root = JsonParse(text);
+    free(text);
+    return root;
+}
+
+/**
+ * @brief Libère un arbre de valeurs.
+ *
+ * @param value La racine (peut être NULL).
+ */
+void JsonFree(JsonValue *value) {
+    if (value == NULL) return;
+    for (int i = 0; i < value->count; i++) {
+        JsonFree(value->items[i]);
+        if (value->keys) free(value->keys[i]);
+    }
+    free(value->items);
+    free(value->keys);
+    free(value->string);
+    free(value);
+}
+
+/**
+ * @brief Cherche un membre d'un objet.
+ *
+ * @return Le membre, ou NULL s'il est absent.
+ */
+const JsonValue *JsonGet(const JsonValue *object, const char *key) {
+    if (object == NULL || object->type != JSON_OBJECT) return NULL;
+    for (int i = 0; i < object->count; i++) {
+        if (strcmp(object->keys[i], key) == 0) return object->items[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Getteur d'un membre numérique, avec valeur par défaut.
+ */
+double JsonGetNumber(const JsonValue *object, const char *key, double fallback) {
+    const JsonValue *value = JsonGet(object, key);
+    return (value && value->type == JSON_NUMBER) ? value->number : fallback;
+}
+
+/**
+ * @brief Getteur d'un membre chaîne, avec valeur par défaut.
+ */
+const char *JsonGetString(const JsonValue *object, const char *key, const char *fallback) {
+    const JsonValue *value = JsonGet(object, key);
+    return (value && value->type == JSON_STRING) ? value->string : fallback;
+}
+
+/**
+ * @brief Écrit une chaîne JSON entre guillemets, avec échappements.
+ */
+void JsonWriteString(FILE *file, const char *s) {
+    fputc('"', file);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', file);
+            fputc(c, file);
+        } else if (c == '\n') {
+            fputs("\\n", file);
+        } else if (c == '\t') {
+            fputs("\\t", file);
+        } else if (c < 0x20) {
+            fprintf(file, "\\u%04x", c);
+        } else {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
@@ -0,0 +1,45 @@
+/**
+ * @file utils/json.h
+ * @brief Lecteur JSON minimal (arbre de valeurs) et écriture de chaînes échappées.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef JSON_H
+#define JSON_H
+
+#include <stdio.h>
+
+typedef enum JsonType {
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+} JsonType;
+
+typedef struct JsonValue {
+    JsonType type;
+    int boolean;
+    double number;
+    char *string;
+    // Arrays and objects: count items; objects also have one key per item.
+    int count;
+    struct JsonValue **items;
+    char **keys;
+} JsonValue;
+
+// Parse a document; returns NULL (and prints the position) on syntax error.
+JsonValue *JsonParse(const char *text);
+JsonValue *JsonParseFile(const char *path);
+void JsonFree(JsonValue *value);
+
+const JsonValue *JsonGet(const JsonValue *object, const char *key);
+double JsonGetNumber(const JsonValue *object, const char *key, double fallback);
+const char *JsonGetString(const JsonValue *object, const char *key, const char *fallback);
+
+// Write s as a quoted, escaped JSON string.
+void JsonWriteString(FILE *file, const char *s);
+
+#endif // JSON_H
@@ -0,0 +1,171 @@
+#include "session.h"
+#include "utils.h"
+#include "alloc.h"
+#include "../visual/visual.h"
+#include "../export/export.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @file session.c
+ * @brief Contexte d'une session de tri.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Une session regroupe tout ce qu'une exécution modifie : l'échantillon, les réglages, l'état du générateur
+ * et la fenêtre. Les fonctions ne touchent qu'à la session reçue, sans verrou : deux threads peuvent mener
+ * chacun sa session. L'état que les tris instrumentés ne peuvent pas recevoir en paramètre (compteurs,
+ * trace ou export en cours) est propre à chaque thread. Le réglage des tris (tuning) reste commun : c'est
+ * un profil de la machine, chargé avant de lancer les sessions.
+ */
+
+/**
+ * @brief Graine du générateur d'une nouvelle session.
+ */
+#define SESSION_DEFAULT_SEED 0x853C49E6748FEA9BULL
+
+#define SESSION_DEFAULTS {                                              \
+    .tab = NULL, .sampleSize = 100, .capacity = 0, .shuffleType = 1,    \
+    .settings = { 800, 600, 1, EXPORT_NONE, "sort.y4m", 30 },           \
+    .rng = SESSION_DEFAULT_SEED, .counters = { 0, 0 },                  \
+    .view = NULL, .keepWindow = 0                                       \
+}
+
+/**
+ * @brief Session du programme interactif (menus et fonctions globales de utils.h).
+ */
+static SortSession default_session = SESSION_DEFAULTS;
+
+/**
+ * @brief Initialise une session avec les réglages par défaut ; l'échantillon n'est pas encore alloué.
+ *
+ * @param session La session à initialiser.
+ */
+void SessionInit(SortSession *session) {
+    SortSession defaults = SESSION_DEFAULTS;
+    *session = defaults;
+}
+
+/**
+ * @brief Libère l'échantillon et la fenêtre de la session. Les réglages sont conservés.
+ *
+ * @param session La session.
+ */
+void SessionFree(SortSession *session) {
+    VisualRelease(session);
+    SortFree(session->tab);
+    session->tab = NULL;
+    session->capacity = 0;
+}
+
+/**
+ * @brief Session du programme interactif.
+ */
+SortSession *DefaultSession(void) {
+    return &default_session;
+}
+
+/**
+ * @brief Réinitialise le générateur de la session : une même graine redonne les mêmes mélanges.
+ *
+ * @param session La session.
+ * @param seed La graine.
+ */
+void SessionSeed(SortSession *session, unsigned long long seed) {
+    // Spread the seed so that close seeds give unrelated sequences; xorshift needs a non-zero state.
+    unsigned long long x = seed + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    session->rng = x != 0 ? x : SESSION_DEFAULT_SEED;
+}
+
+/**
+ * @brief Garantit que l'échantillon peut contenir capacity éléments ; la zone n'est réallouée que si elle
+ * doit grandir.
+ *
+ * @param session La session.
+ * @param capacity Le nombre d'éléments nécessaires.
+ * @return La zone de l'échantillon, ou NULL en cas d'échec.
+ */
+int *SessionReserve(SortSession *session, int capacity) {
+    if (capacity <= session->capacity) return session->tab;
+
+    int *tmp = (int*)SortRealloc(session->tab, capacity * sizeof(int));
+    if (tmp == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
+    }
+    session->tab = tmp;
+    session->capacity = capacity;
+    return tmp;
+}
+
+/**
+ * @brief Remplit l'échantillon avec 1..sampleSize puis le mélange selon le type de la session.
+ *
+ * @param session La session.
+ * @return 0 en cas de succès, -1 en cas d'échec d'allocation.
+ */
+int SessionLoadSample(SortSession *session) {
+    if (SessionReserve(session, session->sampleSize) == NULL) return -1;
+    FillSampleWith(session->tab, session->sampleSize, session->shuffleType, &session->rng);
+    return 0;
+}
+
+/**
+ * @brief Mélange l'échantillon courant selon le type spécifié, avec le générateur de la session.
+ *
+ * @param session La session.
+ * @param type Type de mélange (1: aléatoire, 2: presque trié, 3: trié en ordre décroissant, 4: trié en ordre croissant).
+ */
+void SessionShuffle(SortSession *session, int type) {
+    if (session->tab == NULL) return;
+    ShuffleWith(session->tab, session->sampleSize, type, &session->rng);
+}
+
+/**
+ * @brief Setteur de la taille de fenêtre (ou d'image exportée) de la session.
+ *
+ * @param session La session.
+ * @param width Largeur en pixels (ignorée si elle n'est pas positive).
+ * @param height Hauteur en pixels (ignorée si elle n'est pas positive).
+ */
+void SessionSetVisualSize(SortSession *session, int width, int height) {
+    if (width > 0) session->settings.width = width;
+    if (height > 0) session->settings.height = height;
+}
+
+/**
+ * @brief Setteur du délai entre deux étapes de la relecture.
+ *
+ * @param session La session.
+ * @param delayMs Délai en millisecondes (ignoré s'il est négatif).
+ */
+void SessionSetDelay(SortSession *session, int delayMs) {
+    if (delayMs >= 0) session->settings.delayMs = delayMs;
+}
+
+/**
+ * @brief Setteur du mode de sortie de la session.
+ *
+ * @param session La session.
+ * @param mode Mode de sortie (EXPORT_NONE pour la fenêtre, EXPORT_Y4M ou EXPORT_PNG pour un export).
+ * @param path Chemin du fichier d'export (NULL pour garder le chemin courant).
+ */
+void SessionSetOutput(SortSession *session, int mode, const char *path) {
+    if (mode >= EXPORT_NONE && mode <= EXPORT_PNG) session->settings.output = mode;
+    if (path != NULL && path[0] != '\0') {
+        snprintf(session->settings.exportPath, sizeof(session->settings.exportPath), "%s", path);
+    }
+}
+
+/**
+ * @brief Setteur de la cadence de l'export.
+ *
+ * @param session La session.
+ * @param fps Images par seconde (ignorée si elle n'est pas positive).
+ */
+void SessionSetExportFps(SortSession *session, int fps) {
+    if (fps > 0) session->settings.exportFps = fps;
+}
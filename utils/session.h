@@ -0,0 +1,55 @@
+/**
+ * @file utils/session.h
+ * @brief Contexte d'une session de tri : échantillon, réglages de visualisation, générateur aléatoire,
+ * compteurs et fenêtre. Chaque session est indépendante, plusieurs peuvent tourner en parallèle.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "../stats/stats.h"
+
+// Window, renderer and frame buffers of a session (visual.c); NULL until the first window.
+typedef struct VisualState VisualState;
+
+typedef struct SessionSettings {
+    int width;             // window or export size, in pixels
+    int height;
+    int delayMs;           // delay between two playback steps
+    int output;            // ExportFormat: EXPORT_NONE for the window
+    char exportPath[256];  // Y4M stream or PNG prefix
+    int exportFps;
+} SessionSettings;
+
+typedef struct SortSession {
+    int *tab;                  // sample, capacity elements allocated (never shrinks)
+    int sampleSize;
+    int capacity;
+    int shuffleType;           // 1: random, 2: nearly sorted, 3: reversed, 4: sorted
+    SessionSettings settings;
+    unsigned long long rng;    // generator state of the shuffles (never 0)
+    SortCounters counters;     // operations of the last sort visualized or exported
+    VisualState *view;
+    int keepWindow;            // keep the window open between two visualizations
+} SortSession;
+
+// 100 random elements (not allocated yet), 800 x 600 window, 1 ms delay, Y4M export to sort.y4m at 30 fps.
+void SessionInit(SortSession *session);
+// Release the sample and the window; the settings are kept and the session can be used again.
+void SessionFree(SortSession *session);
+// Session of the interactive program, behind the global functions of utils.h; not shared between threads.
+SortSession *DefaultSession(void);
+
+void SessionSeed(SortSession *session, unsigned long long seed);
+int *SessionReserve(SortSession *session, int capacity);
+int SessionLoadSample(SortSession *session); // 1..sampleSize, then shuffleType; 0 or -1
+void SessionShuffle(SortSession *session, int type);
+
+void SessionSetVisualSize(SortSession *session, int width, int height);
+void SessionSetDelay(SortSession *session, int delayMs);
+void SessionSetOutput(SortSession *session, int mode, const char *path); // path NULL keeps the current one
+void SessionSetExportFps(SortSession *session, int fps);
+
+#endif // SESSION_H
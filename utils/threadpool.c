@@ -0,0 +1,209 @@
+#include "threadpool.h"
+#include "alloc.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @file threadpool.c
+ * @brief Implémentation de la réserve de threads.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+/**
+ * @brief Tâche en attente dans la file, avec l'exécution (AllocRun) du thread qui l'a soumise.
+ */
+typedef struct PendingTask {
+    ThreadTask task;
+    void *arg;
+    AllocRun *run;
+} PendingTask;
+
+/**
+ * @brief Réserve de threads : file circulaire de tâches protégée par un mutex.
+ */
+struct ThreadPool {
+    pthread_t *threads;
+    int nbThreads;
+
+    PendingTask *queue;
+    int capacity;
+    int head;
+    int count;
+    int active;
+    int stop;
+
+    pthread_mutex_t lock;
+    pthread_cond_t hasWork;
+    pthread_cond_t idle;
+};
+
+/**
+ * @brief Getteur du nombre de processeurs disponibles.
+ */
+int GetCpuCount(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+/**
+ * @brief Boucle d'un thread de la réserve : dépile et exécute les tâches jusqu'à l'arrêt.
+ *
+ * @param data La réserve.
+ */
+static void *worker_main(void *data) {
+    ThreadPool *pool = (ThreadPool*)data;
+
+    pthread_mutex_lock(&pool->lock);
+    while (1) {
+        while (pool->count == 0 && !pool->stop) {
+            pthread_cond_wait(&pool->hasWork, &pool->lock);
+        }
+        if (pool->count == 0 && pool->stop) break;
+
+        PendingTask job = pool->queue[pool->head];
+        pool->head = (pool->head + 1) % pool->capacity;
+        pool->count--;
+        pool->active++;
+        pthread_mutex_unlock(&pool->lock);
+
+        AllocRun *previous = AllocRunSet(job.run);
+        job.task(job.arg);
+        AllocRunSet(previous);
+
+        pthread_mutex_lock(&pool->lock);
+        pool->active--;
+        if (pool->count == 0 && pool->active == 0) {
+            pthread_cond_broadcast(&pool->idle);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * @brief Crée une réserve de threads.
+ *
+ * @param nbThreads Nombre de threads (<= 0 : un par processeur).
+ * @return La réserve, ou NULL en cas d'échec.
+ */
+ThreadPool *ThreadPoolCreate(int nbThreads) {
+    if (nbThreads <= 0) nbThreads = GetCpuCount();
+
+    ThreadPool *pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (pool == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
+    }
+
+    pool->capacity = 64;
+    pool->queue = (PendingTask*)malloc(pool->capacity * sizeof(PendingTask));
+    pool->threads = (pthread_t*)malloc(nbThreads * sizeof(pthread_t));
+    if (pool->queue == NULL || pool->threads == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(pool->queue);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->hasWork, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+
+    for (int i = 0; i < nbThreads; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0) {
+            fprintf(stderr, "pthread_create failed\n");
+            break;
+        }
+        pool->nbThreads++;
+    }
+
+    if (pool->nbThreads == 0) {
+        ThreadPoolDestroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+/**
+ * @brief Attend la fin des tâches en cours, arrête les threads et libère la réserve.
+ *
+ * @param pool La réserve (peut être NULL).
+ */
+void ThreadPoolDestroy(ThreadPool *pool) {
+    if (pool == NULL) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->hasWork);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->nbThreads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->hasWork);
+    pthread_cond_destroy(&pool->idle);
+    free(pool->queue);
+    free(pool->threads);
+    free(pool);
+}
+
+/**
+ * @brief Getteur du nombre de threads de la réserve.
+ */
+int ThreadPoolSize(const ThreadPool *pool) {
+    return pool ? pool->nbThreads : 1;
+}
+
+/**
+ * @brief Ajoute une tâche à la file. La file s'agrandit si nécessaire.
+ *
+ * @param pool La réserve.
+ * @param task La fonction à exécuter.
+ * @param arg Argument transmis à la fonction.
+ * @return 0 en cas de succès, -1 en cas d'échec d'allocation.
+ */
+int ThreadPoolSubmit(ThreadPool *pool, ThreadTask task, void *arg) {
+    pthread_mutex_lock(&pool->lock);
+
+    if (pool->count == pool->capacity) {
+        int cap = pool->capacity * 2;
+        PendingTask *tmp = (PendingTask*)malloc(cap * sizeof(PendingTask));
+        if (tmp == NULL) {
+            pthread_mutex_unlock(&pool->lock);
+            fprintf(stderr, "Memory allocation failed\n");
+            return -1;
+        }
+        for (int i = 0; i < pool->count; i++) {
+            tmp[i] = pool->queue[(pool->head + i) % pool->capacity];
+        }
+        free(pool->queue);
+        pool->queue = tmp;
+        pool->capacity = cap;
+        pool->head = 0;
+    }
+
+    pool->queue[(pool->head + pool->count) % pool->capacity] = (PendingTask){ task, arg, AllocRunCurrent() };
+    pool->count++;
+    pthread_cond_signal(&pool->hasWork);
+    pthread_mutex_unlock(&pool->lock);
+    return 0;
+}
+
+/**
+ * @brief Bloque jusqu'à ce que toutes les tâches soumises soient terminées.
+ *
+ * @param pool La réserve.
+ */
+void ThreadPoolWait(ThreadPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->count > 0 || pool->active > 0) {
+        pthread_cond_wait(&pool->idle, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
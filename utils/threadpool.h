@@ -0,0 +1,29 @@
+/**
+ * @file utils/threadpool.h
+ * @brief Réserve de threads (pthreads) exécutant des tâches soumises dans une file.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+typedef void (*ThreadTask)(void *arg);
+
+typedef struct ThreadPool ThreadPool;
+
+// Number of online CPUs (at least 1).
+int GetCpuCount(void);
+
+// nbThreads <= 0 uses one thread per CPU.
+ThreadPool *ThreadPoolCreate(int nbThreads);
+void ThreadPoolDestroy(ThreadPool *pool);
+int ThreadPoolSize(const ThreadPool *pool);
+
+// Queue a task; returns 0 on success, -1 if the task could not be queued. The task's allocations are
+// charged to the submitting thread's AllocRun.
+int ThreadPoolSubmit(ThreadPool *pool, ThreadTask task, void *arg);
+// Block until every submitted task has finished.
+void ThreadPoolWait(ThreadPool *pool);
+
+#endif // THREADPOOL_H
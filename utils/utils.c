@@ -1,408 +1,690 @@
-#include "utils.h"
-#include "../sorting/sorting.h"
-#include "../visual/visual.h"
-#include <string.h>
-#include <stdio.h>
-#include <stdlib.h>
-
-/**
- * @file utils.c
- * @brief Implémentation des fonctions utilitaires pour le projet de visualisation des algorithmes de tri.
- * @author MUZARD Thomas
- * @date 27/10/2025
- */
-
- /**
-  * @brief Taille de l'échantillon de test.
-  */
-static int sampleSize = 100;
-
-/**
- * @brief Type de mélange avant le tri.
- */
-static int typeShuffleBeforeSort = 1;
-
-/**
- * @brief Tableau d'échantillon de test.
- */
-static int* tab = NULL;
-
-/**
- * @brief Largeur de la fenêtre de visualisation.
- */
-static int viz_width = 800;
-
-/**
- * @brief Hauteur de la fenêtre de visualisation.
- */
-static int viz_height = 600;
-
-/**
- * @brief Délai de visualisation (en millisecondes).
- */
-static int viz_delay_ms = 1; // delay for comparisons/swaps
-
-/**
- * @brief Libère la mémoire allouée pour l'échantillon de test.
- */
-void FreeTabSample() {
-    if (tab != NULL) {
-        free(tab);
-        tab = NULL;
-    }
-}
-
-/**
- * @brief Charge ou initialise l'échantillon de test.
- */
-void LoadSample() {
-    if (tab == NULL) {
-        tab = (int*)malloc(sampleSize * sizeof(int));
-        if (tab == NULL) {
-            fprintf(stderr, "Memory allocation failed\n");
-            return;
-        }
-    }
-
-    int *tmp = realloc(tab, sampleSize * sizeof(int));
-    if (tmp == NULL) {
-        fprintf(stderr, "Memory allocation failed\n");
-        return;
-    }
-    tab = tmp;
-
-    /* Initialiser avec 1..sampleSize avant de mélanger */
-    for (int i = 0; i < sampleSize; ++i) {
-        tab[i] = i + 1;
-    }
-
-    ShuffleSample(typeShuffleBeforeSort);
-}
-
-/**
- * @brief Setteur de la taille de fenêtre pour la visualisation.
- * 
- * @param width Largeur en pixels.
- * @param height Hauteur en pixels.
- */
-void SetVisualSize(int width, int height) {
-    if (width > 0) viz_width = width;
-    if (height > 0) viz_height = height;
-}
-
-/**
- * @brief Setteur du délai de visualisation.
- * 
- * @param delay_ms Délai en millisecondes.
- */
-void SetVisualDelay(int delay_ms) {
-    if (delay_ms >= 0) viz_delay_ms = delay_ms;
-}
-
-/**
- * @brief Getteur de la largeur de la fenêtre de visualisation.
- */
-int GetVisualWidth(void) {
-    return viz_width;
-}
-
-/**
- * @brief Getteur de la hauteur de la fenêtre de visualisation.
- */
-int GetVisualHeight(void) {
-    return viz_height;
-}
-
-/**
- * @brief Getteur du délai de visualisation.
- */
-int GetVisualDelay(void) {
-    return viz_delay_ms;
-}
-
-/**
- * @brief Mélange aléatoire du tableau.
- * 
- * @param tab Le tableau à mélanger.
- * @param n La taille du tableau.
- */
-void RandomShuffle(int tab[], int n) {
-    for (int i = n - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        int temp = tab[i];
-        tab[i] = tab[j];
-        tab[j] = temp;
-    }
-}
-
-/**
- * @brief Rend le tableau presque trié en mélangeant une petite partie des éléments.
- * 
- * @param tab Le tableau à modifier.
- * @param n La taille du tableau.
- */
-void NearlySorted(int tab[], int n) {
-    RandomShuffle(tab, n / 10); // Shuffle 10% of the elements
-}
-
-/**
- * @brief Rend le tableau trié en ordre décroissant.
- * 
- * @param tab Le tableau à modifier.
- * @param n La taille du tableau.
- */
-void ReverseSorted(int tab[], int n) {
-    for (int i = 0; i < n / 2; i++) {
-        int temp = tab[i];
-        tab[i] = tab[n - i - 1];
-        tab[n - i - 1] = temp;
-    }
-}
-
-/**
- * @brief Remplit le tableau avec des valeurs triées en ordre croissant.
- * 
- * @param tab Le tableau à modifier.
- * @param n La taille du tableau.
- */
-void Sorted(int tab[], int n) {
-    for (int i = 0; i < n; i++) {
-        tab[i] = i + 1;
-    }
-}
-
-/**
- * @brief Mélange le tableau selon le type spécifié.
- * 
- * @param type Type de mélange (1: aléatoire, 2: presque trié, 3: trié en ordre décroissant, 4: trié en ordre croissant).
- */
-void ShuffleSample(int type) {
-    switch (type)
-    {
-        case 1:
-            // Simple random shuffle
-            RandomShuffle(tab, sampleSize);
-            break;
-
-        case 2:
-            // Nearly sorted
-            NearlySorted(tab, sampleSize);
-            break;
-
-        case 3:
-            // Reverse sorted
-            ReverseSorted(tab, sampleSize);
-            break;
-
-        case 4:
-            // Sorted
-            Sorted(tab, sampleSize);
-            break;
-        
-        default:
-            break;
-    }
-}
-
-/**
- * @brief Choisit et exécute l'algorithme de tri spécifié.
- * 
- * @param idxAlgo Indice de l'algorithme de tri à exécuter choisie par l'utilisateur.
- */
-void ChooseAlgorithm(int idxAlgo) {
-    switch (idxAlgo) {
-        case 1:
-            //SelectSort(tab, sampleSize);
-            ShuffleSample(typeShuffleBeforeSort);
-            VisualizeSort(tab, sampleSize, SelectSort_viz);
-            break;
-
-        case 2: 
-            //BubbleSort(tab, sampleSize);
-            ShuffleSample(typeShuffleBeforeSort);
-            VisualizeSort(tab, sampleSize, BubbleSort_viz);
-            break;
-
-        case 3:
-            //InsertionSort(tab, sampleSize);
-            ShuffleSample(typeShuffleBeforeSort);
-            VisualizeSort(tab, sampleSize, InsertionSort_viz);
-            break;
-
-        case 4:
-            //QuickSort(tab, 0, sampleSize - 1);
-            ShuffleSample(typeShuffleBeforeSort);
-            VisualizeSort(tab, sampleSize, QuickSort_viz_wrapper);
-            break;
-
-        case 5:
-            //MergeSort(tab, 0, sampleSize - 1);
-            ShuffleSample(typeShuffleBeforeSort);
-            VisualizeSort(tab, sampleSize, MergeSort_viz_wrapper);
-            break;
-
-        case 6:
-            // Changer les paramètres de visualisation
-            ShowSettingsMenu();
-            break;
-
-        case 9:
-            printf("Exiting the sorting program.\n");
-            break;
-        
-        default:
-            printf("Unknown sorting algorithm: %d\n", idxAlgo);
-    }
-}
-
-/**
- * @brief Imprime le contenu du tableau.
- * 
- * @param tab Le tableau à imprimer.
- * @param n La taille du tableau.
- */
-void PrintTab(int tab[], int n) {
-    for (int i = 0; i < n; i++) {
-        printf("%d ", tab[i]);
-    }
-    printf("\n");
-}
-
-/**
- * @brief Affiche le menu des paramètres de visualisation et permet à l'utilisateur de les modifier.
- */
-void SetDelay() {
-    int d;
-    printf("Enter delay in ms (0 for very fast): "); 
-    if (scanf("%d", &d) != 1) { 
-        int c; 
-        while ((c = getchar()) != '\n' && c != EOF) {} 
-        printf("Bad input\n"); 
-    }
-    SetVisualDelay(d);
-}
-
-/**
- * @brief Permet à l'utilisateur de définir une taille de fenêtre personnalisée.
- */
-void SetViewSize() {
-    int w, h;
-    printf("Enter width: "); 
-    if (scanf("%d", &w) != 1) { 
-        int c; 
-        while ((c = getchar()) != '\n' && c != EOF) {} 
-        printf("Bad input\n"); 
-    }
-
-    printf("Enter height: "); 
-    if (scanf("%d", &h) != 1) { 
-        int c; 
-        while ((c = getchar()) != '\n' && c != EOF) {} 
-        printf("Bad input\n"); 
-    }
-
-    SetVisualSize(w, h);
-}
-
-/**
- * @brief Permet à l'utilisateur de définir la taille de l'échantillon de test.
- */
-void SetTabSample() {
-    printf("Enter sample size: "); 
-    scanf("%d", &sampleSize);
-    while (sampleSize <= 0) {
-        printf("Sample size must be positive. Please enter again: ");
-        scanf("%d", &sampleSize);
-    }
-
-    LoadSample();
-}
-
-/**
- * @brief Permet à l'utilisateur de définir le type de mélange avant le tri.
- */
-void SetShuffleType() {
-    printf("Choose type of shuffle before sort:\n");
-    printf(" 1 - Simple random shuffle\n");
-    printf(" 2 - Nearly sorted\n");
-    printf(" 3 - Reverse sorted\n");
-    printf(" 4 - Sorted\n");
-    printf("Your choice: ");
-    scanf("%d", &typeShuffleBeforeSort);
-
-    while (typeShuffleBeforeSort < 1 || typeShuffleBeforeSort > 4) {
-        printf("Invalid choice. Please enter again: ");
-        scanf("%d", &typeShuffleBeforeSort);
-    }
-}
-
-/**
- * @brief Affiche le menu des paramètres de visualisation et permet à l'utilisateur de les modifier.
- */
-void ShowSettingsMenu(void) {
-    int done = 0;
-    while (!done) {
-        printf("\n=== Visualizer Settings ===\n");
-        printf("Current size: %dx%d\n", viz_width, viz_height);
-        printf("Current delay: %d ms\n", viz_delay_ms);
-        printf("Choose an option:\n");
-        printf(" 1 - 640 x 480\n");
-        printf(" 2 - 800 x 600\n");
-        printf(" 3 - 1024 x 768\n");
-        printf(" 4 - 1280 x 720\n");
-        printf(" 5 - Custom size\n");
-        printf(" 6 - Change delay (ms)\n");
-        printf(" 7 - Change sample size\n");
-        printf(" 8 - Change type of shuffle\n");
-        printf(" 9 - Back\n");
-        printf("Your choice: ");
-
-        int choice = 0;
-        if (scanf("%d", &choice) != 1) {
-            int c; while ((c = getchar()) != '\n' && c != EOF) {}
-            printf("Invalid input\n");
-            continue;
-        }
-
-        switch (choice) {
-            case 1: 
-                SetVisualSize(640, 480); 
-                break;
-
-            case 2: 
-                SetVisualSize(800, 600); 
-                break;
-
-            case 3: 
-                SetVisualSize(1024, 768); 
-                break;
-
-            case 4: 
-                SetVisualSize(1280, 720); 
-                break;
-
-            case 5: 
-                SetViewSize();
-                break;
-            
-            case 6:
-                SetDelay();
-                break;
-
-            case 7: 
-                SetTabSample();
-                break;
-
-            case 8 : 
-                SetShuffleType();
-                break;
-
-            case 9: 
-                done = 1; 
-                break;
-
-            default: 
-                printf("Unknown option\n"); break;
-        }
-    }
+#include "utils.h"
+#include "session.h"
+#include "../sorting/sorting.h"
+#include "../sorting/registry.h"
+#include "../sorting/tuning.h"
+#include "../visual/visual.h"
+#include "../export/export.h"
+#include "../bench/bench.h"
+#include "../bench/runner.h"
+#include "../bench/scaling.h"
+#include "../bench/selection.h"
+#include "../bench/tuner.h"
+#include "../bench/cache.h"
+#include "../bench/online.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @file utils.c
+ * @brief Implémentation des fonctions utilitaires pour le projet de visualisation des algorithmes de tri.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+/**
+ * @brief Libère la mémoire allouée pour l'échantillon de test (et la fenêtre de la session par défaut).
+ */
+void FreeTabSample() {
+    SessionFree(DefaultSession());
+}
+
+/**
+ * @brief Garantit que l'échantillon de la session par défaut peut contenir capacity éléments.
+ * 
+ * @param capacity Le nombre d'éléments nécessaires.
+ * @return La zone de l'échantillon, ou NULL en cas d'échec.
+ */
+int *ReserveSample(int capacity) {
+    return SessionReserve(DefaultSession(), capacity);
+}
+
+/**
+ * @brief Charge ou initialise l'échantillon de test.
+ */
+void LoadSample() {
+    SessionLoadSample(DefaultSession());
+}
+
+/**
+ * @brief Setteur de la taille de fenêtre pour la visualisation.
+ * 
+ * @param width Largeur en pixels.
+ * @param height Hauteur en pixels.
+ */
+void SetVisualSize(int width, int height) {
+    SessionSetVisualSize(DefaultSession(), width, height);
+}
+
+/**
+ * @brief Setteur du délai de visualisation.
+ * 
+ * @param delay_ms Délai en millisecondes.
+ */
+void SetVisualDelay(int delay_ms) {
+    SessionSetDelay(DefaultSession(), delay_ms);
+}
+
+/**
+ * @brief Getteur de la largeur de la fenêtre de visualisation.
+ */
+int GetVisualWidth(void) {
+    return DefaultSession()->settings.width;
+}
+
+/**
+ * @brief Getteur de la hauteur de la fenêtre de visualisation.
+ */
+int GetVisualHeight(void) {
+    return DefaultSession()->settings.height;
+}
+
+/**
+ * @brief Getteur du délai de visualisation.
+ */
+int GetVisualDelay(void) {
+    return DefaultSession()->settings.delayMs;
+}
+
+/**
+ * @brief Setteur du mode de sortie de la visualisation.
+ * 
+ * @param mode Mode de sortie (EXPORT_NONE pour la fenêtre, EXPORT_Y4M ou EXPORT_PNG pour un export).
+ * @param path Chemin du fichier d'export (NULL pour garder le chemin courant).
+ */
+void SetVisualOutput(int mode, const char *path) {
+    SessionSetOutput(DefaultSession(), mode, path);
+}
+
+/**
+ * @brief Setteur de la cadence de l'export.
+ * 
+ * @param fps Images par seconde.
+ */
+void SetExportFps(int fps) {
+    SessionSetExportFps(DefaultSession(), fps);
+}
+
+/**
+ * @brief Getteur du mode de sortie de la visualisation.
+ */
+int GetVisualOutput(void) {
+    return DefaultSession()->settings.output;
+}
+
+/**
+ * @brief Getteur du chemin du fichier d'export.
+ */
+const char *GetExportPath(void) {
+    return DefaultSession()->settings.exportPath;
+}
+
+/**
+ * @brief Getteur de la cadence de l'export.
+ */
+int GetExportFps(void) {
+    return DefaultSession()->settings.exportFps;
+}
+
+/**
+ * @brief Tirage pseudo-aléatoire (xorshift64*) à partir d'un état propre à l'appelant, ou rand() si state
+ * est NULL.
+ * 
+ * @param state L'état du générateur (non nul), ou NULL.
+ * @return Un entier aléatoire sur 31 bits.
+ */
+unsigned int RandomNext(unsigned long long *state) {
+    if (state == NULL) return (unsigned int)rand();
+    unsigned long long x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return (unsigned int)((x * 0x2545F4914F6CDD1DULL) >> 33);
+}
+
+/**
+ * @brief Mélange aléatoire du tableau.
+ * 
+ * @param tab Le tableau à mélanger.
+ * @param n La taille du tableau.
+ */
+void RandomShuffle(int tab[], int n) {
+    RandomShuffleWith(tab, n, NULL);
+}
+
+/**
+ * @brief Mélange aléatoire du tableau avec le générateur de l'appelant.
+ * 
+ * @param tab Le tableau à mélanger.
+ * @param n La taille du tableau.
+ * @param state L'état du générateur (voir RandomNext), ou NULL pour rand().
+ */
+void RandomShuffleWith(int tab[], int n, unsigned long long *state) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = RandomNext(state) % (i + 1);
+        int temp = tab[i];
+        tab[i] = tab[j];
+        tab[j] = temp;
+    }
+}
+
+/**
+ * @brief Rend le tableau presque trié en mélangeant une petite partie des éléments.
+ * 
+ * @param tab Le tableau à modifier.
+ * @param n La taille du tableau.
+ */
+void NearlySorted(int tab[], int n) {
+    RandomShuffle(tab, n / 10); // Shuffle 10% of the elements
+}
+
+/**
+ * @brief Rend le tableau trié en ordre décroissant.
+ * 
+ * @param tab Le tableau à modifier.
+ * @param n La taille du tableau.
+ */
+void ReverseSorted(int tab[], int n) {
+    for (int i = 0; i < n / 2; i++) {
+        int temp = tab[i];
+        tab[i] = tab[n - i - 1];
+        tab[n - i - 1] = temp;
+    }
+}
+
+/**
+ * @brief Remplit le tableau avec des valeurs triées en ordre croissant.
+ * 
+ * @param tab Le tableau à modifier.
+ * @param n La taille du tableau.
+ */
+void Sorted(int tab[], int n) {
+    for (int i = 0; i < n; i++) {
+        tab[i] = i + 1;
+    }
+}
+
+/**
+ * @brief Remplit un tableau avec 1..n puis le mélange selon le type spécifié (mêmes types que ShuffleSample).
+ * 
+ * @param tab Le tableau à remplir.
+ * @param n La taille du tableau.
+ * @param type Type de mélange (1: aléatoire, 2: presque trié, 3: trié en ordre décroissant, 4: trié en ordre croissant).
+ */
+void FillSample(int tab[], int n, int type) {
+    FillSampleWith(tab, n, type, NULL);
+}
+
+/**
+ * @brief Remplit un tableau avec 1..n puis le mélange selon le type spécifié, avec le générateur de l'appelant.
+ * 
+ * @param tab Le tableau à remplir.
+ * @param n La taille du tableau.
+ * @param type Type de mélange (mêmes types que ShuffleSample).
+ * @param state L'état du générateur (voir RandomNext), ou NULL pour rand().
+ */
+void FillSampleWith(int tab[], int n, int type, unsigned long long *state) {
+    for (int i = 0; i < n; ++i) {
+        tab[i] = i + 1;
+    }
+    ShuffleWith(tab, n, type, state);
+}
+
+/**
+ * @brief Mélange un tableau selon le type spécifié, avec le générateur de l'appelant.
+ * 
+ * @param tab Le tableau à mélanger.
+ * @param n La taille du tableau.
+ * @param type Type de mélange (1: aléatoire, 2: presque trié, 3: trié en ordre décroissant, 4: trié en ordre croissant).
+ * @param state L'état du générateur (voir RandomNext), ou NULL pour rand().
+ */
+void ShuffleWith(int tab[], int n, int type, unsigned long long *state) {
+    switch (type)
+    {
+        case 1:
+            // Simple random shuffle
+            RandomShuffleWith(tab, n, state);
+            break;
+
+        case 2:
+            // Nearly sorted: shuffle 10% of the elements
+            RandomShuffleWith(tab, n / 10, state);
+            break;
+
+        case 3:
+            // Reverse sorted
+            ReverseSorted(tab, n);
+            break;
+
+        case 4:
+            // Sorted
+            Sorted(tab, n);
+            break;
+        
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Mélange l'échantillon de la session par défaut selon le type spécifié.
+ * 
+ * @param type Type de mélange (1: aléatoire, 2: presque trié, 3: trié en ordre décroissant, 4: trié en ordre croissant).
+ */
+void ShuffleSample(int type) {
+    SessionShuffle(DefaultSession(), type);
+}
+
+/**
+ * @brief Entrées du menu principal qui suivent les algorithmes du registre.
+ */
+typedef enum MenuAction {
+    MENU_SETTINGS,
+    MENU_BENCHMARK,
+    MENU_SCALING,
+    MENU_SELECTION,
+    MENU_EXIT,
+    MENU_NB_ACTIONS
+} MenuAction;
+
+/**
+ * @brief Libellés des entrées qui suivent les algorithmes, dans l'ordre de MenuAction.
+ */
+static const char *menu_actions[MENU_NB_ACTIONS] = {
+    "Settings", "Benchmark", "Scaling report", "Selection (nth / partial / top-k)", "Exit"
+};
+
+/**
+ * @brief Numéro de l'entrée "Exit" du menu principal, qui est aussi la dernière.
+ */
+int MainMenuExit(void) {
+    return SortAlgorithmCount() + MENU_EXIT + 1;
+}
+
+/**
+ * @brief Affiche le menu principal : un algorithme du registre par ligne (complexité moyenne, stabilité,
+ * tri en place), puis les autres actions.
+ */
+void ShowMainMenu(void) {
+    printf("Choose sorting algorithm:\n");
+    for (int a = 0; a < SortAlgorithmCount(); a++) {
+        const SortAlgorithm *algo = SortGetAlgorithm(a);
+        printf("\t%2d - %-14s %-13s%s%s\n", a + 1, algo->name, algo->average,
+               algo->stable ? " stable" : "", algo->inPlace ? " in-place" : "");
+    }
+    for (int i = 0; i < MENU_NB_ACTIONS; i++) {
+        printf("\t%2d - %s\n", SortAlgorithmCount() + i + 1, menu_actions[i]);
+    }
+}
+
+/**
+ * @brief Choisit et exécute l'entrée spécifiée du menu principal : un algorithme du registre est visualisé
+ * sur l'échantillon mélangé, sauf s'il est quadratique et l'échantillon trop grand.
+ * 
+ * @param idxAlgo Numéro de l'entrée choisie par l'utilisateur (1 pour le premier algorithme).
+ */
+void ChooseAlgorithm(int idxAlgo) {
+    SortSession *session = DefaultSession();
+    const SortAlgorithm *algo = SortGetAlgorithm(idxAlgo - 1);
+    if (algo != NULL) {
+        if (!SortAlgorithmFits(algo, session->sampleSize)) {
+            printf("%s skipped: quadratic, and the sample has more than %d elements\n", algo->name,
+                   SORT_QUADRATIC_MAX);
+            return;
+        }
+        long autoSorts = StatsAutoSortCount();
+        SessionShuffle(session, session->shuffleType);
+        SessionVisualize(session, session->tab, session->sampleSize, algo->sortViz);
+        // The run went through AutoSort: show its analysis and decision.
+        if (StatsAutoSortCount() != autoSorts) StatsPrintAutoSort(StatsLastAutoSort());
+        return;
+    }
+
+    switch (idxAlgo - SortAlgorithmCount() - 1) {
+        case MENU_SETTINGS:
+            // Changer les paramètres de visualisation
+            ShowSettingsMenu();
+            break;
+
+        case MENU_BENCHMARK:
+            // Mesurer les versions silencieuses sur l'échantillon courant
+            ShowBenchmarkMenu();
+            break;
+
+        case MENU_SCALING: {
+            // Balayage des tailles et complexité empirique
+            ScalingOptions options;
+            ScalingDefaults(&options);
+            options.distribution = session->shuffleType;
+            RunScalingReport(&options);
+            break;
+        }
+
+        case MENU_SELECTION:
+            // Sélection : seule une partie du tableau est ordonnée
+            ShowSelectionMenu();
+            break;
+
+        case MENU_EXIT:
+            printf("Exiting the sorting program.\n");
+            break;
+        
+        default:
+            printf("Unknown sorting algorithm: %d\n", idxAlgo);
+    }
+}
+
+/**
+ * @brief Demande le mode de mesure (caches chauds ou froids) puis lance le benchmark sur l'échantillon courant.
+ */
+void ShowBenchmarkMenu(void) {
+    SortSession *session = DefaultSession();
+    int choice = 0;
+    printf("Benchmark caches:\n");
+    printf(" 1 - Warm (input already in cache)\n");
+    printf(" 2 - Cold (caches evicted before every run)\n");
+    printf(" 3 - Selection primitives against full sorts (k/n sweep, warm)\n");
+    printf(" 4 - Tune sort parameters for this machine (saved to %s)\n", TUNING_DEFAULT_PATH);
+    printf(" 5 - Cache simulation of the array accesses (heatmaps in the current directory)\n");
+    printf(" 6 - Online inserts: sorted-run container against re-sorting after every batch\n");
+    printf("Your choice: ");
+    if (ReadInt(&choice) != 1 || choice < 1 || choice > 6) {
+        printf("Bad input\n");
+        return;
+    }
+
+    if (choice == 4) {
+        RunAutoTune(TUNING_DEFAULT_PATH);
+        return;
+    }
+    if (choice == 5) {
+        CacheAnalysisOptions cache;
+        CacheAnalysisDefaults(&cache);
+        cache.heatmapDir = ".";
+        RunCacheAnalysis(session->tab, session->sampleSize, &cache);
+        return;
+    }
+    if (choice == 6) {
+        RunOnlineBenchmark(session->tab, session->sampleSize, ONLINE_BENCH_BATCH);
+        return;
+    }
+
+    RunnerOptions options;
+    RunnerDefaults(&options);
+    if (choice == 3) {
+        RunSelectionBenchmark(session->tab, session->sampleSize, &options);
+        return;
+    }
+    options.flushCaches = choice == 2;
+    options.useCounters = 1;
+    RunBenchmark(session->tab, session->sampleSize, &options);
+}
+
+/**
+ * @brief Demande la primitive de sélection puis la visualise sur l'échantillon courant.
+ */
+void ShowSelectionMenu(void) {
+    int choice = 0;
+    printf("Selection:\n");
+    printf(" 1 - NthElement (median)\n");
+    printf(" 2 - PartialSort (smallest 10%%)\n");
+    printf(" 3 - TopK with a bounded heap (smallest 10%%)\n");
+    printf("Your choice: ");
+    if (ReadInt(&choice) != 1 || choice < 1 || choice > 3) {
+        printf("Bad input\n");
+        return;
+    }
+
+    SortSession *session = DefaultSession();
+    SessionShuffle(session, session->shuffleType);
+    switch (choice) {
+        case 1: SessionVisualize(session, session->tab, session->sampleSize, NthElement_viz_wrapper); break;
+        case 2: SessionVisualize(session, session->tab, session->sampleSize, PartialSort_viz_wrapper); break;
+        case 3: SessionVisualize(session, session->tab, session->sampleSize, TopK_viz_wrapper); break;
+        default: break;
+    }
+}
+
+/**
+ * @brief Lit la prochaine ligne non vide de l'entrée standard. Le reste d'une ligne trop longue est consommé.
+ *
+ * @param line Le tampon de lecture.
+ * @param size Sa taille.
+ * @return Le début de la ligne sans les blancs qui l'entourent, ou NULL en fin d'entrée.
+ */
+static char *read_line(char line[], int size) {
+    char *start;
+    do {
+        if (fgets(line, size, stdin) == NULL) return NULL;
+        if (strchr(line, '\n') == NULL) {
+            int c;
+            while ((c = getchar()) != '\n' && c != EOF) {}
+        }
+        start = line + strspn(line, " \t\r\n");
+    } while (*start == '\0');
+
+    size_t length = strlen(start);
+    while (length > 0 && strchr(" \t\r\n", start[length - 1]) != NULL) start[--length] = '\0';
+    return start;
+}
+
+/**
+ * @brief Lit un entier seul sur une ligne de l'entrée standard. Les lignes vides sont ignorées et une
+ * ligne invalide est consommée entièrement, ce qui évite de boucler sur le même jeton.
+ * 
+ * @param value L'entier lu (inchangé si la ligne est invalide).
+ * @return 1 si un entier a été lu, 0 si la ligne est invalide, -1 en fin d'entrée.
+ */
+int ReadInt(int *value) {
+    char line[64];
+    char *start = read_line(line, sizeof(line));
+    if (start == NULL) return -1;
+
+    char *end;
+    long v = strtol(start, &end, 10);
+    if (end == start || end[strspn(end, " \t\r\n")] != '\0') return 0;
+    *value = (int)v;
+    return 1;
+}
+
+/**
+ * @brief Imprime le contenu du tableau.
+ * 
+ * @param tab Le tableau à imprimer.
+ * @param n La taille du tableau.
+ */
+void PrintTab(int tab[], int n) {
+    for (int i = 0; i < n; i++) {
+        printf("%d ", tab[i]);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Affiche le menu des paramètres de visualisation et permet à l'utilisateur de les modifier.
+ */
+void SetDelay() {
+    int d;
+    printf("Enter delay in ms (0 for very fast): ");
+    if (ReadInt(&d) != 1) {
+        printf("Bad input\n");
+        return;
+    }
+    SetVisualDelay(d);
+}
+
+/**
+ * @brief Permet à l'utilisateur de définir une taille de fenêtre personnalisée.
+ */
+void SetViewSize() {
+    int w, h;
+    printf("Enter width: ");
+    if (ReadInt(&w) != 1) {
+        printf("Bad input\n");
+        return;
+    }
+
+    printf("Enter height: ");
+    if (ReadInt(&h) != 1) {
+        printf("Bad input\n");
+        return;
+    }
+
+    SetVisualSize(w, h);
+}
+
+/**
+ * @brief Permet à l'utilisateur de définir la taille de l'échantillon de test.
+ */
+void SetTabSample() {
+    int size = 0;
+    printf("Enter sample size: "); 
+    while (ReadInt(&size) >= 0 && size <= 0) {
+        printf("Sample size must be positive. Please enter again: ");
+    }
+    if (size <= 0) {
+        return;
+    }
+    DefaultSession()->sampleSize = size;
+
+    LoadSample();
+}
+
+/**
+ * @brief Permet à l'utilisateur de définir le type de mélange avant le tri.
+ */
+void SetShuffleType() {
+    printf("Choose type of shuffle before sort:\n");
+    printf(" 1 - Simple random shuffle\n");
+    printf(" 2 - Nearly sorted\n");
+    printf(" 3 - Reverse sorted\n");
+    printf(" 4 - Sorted\n");
+    printf("Your choice: ");
+
+    int type = 0;
+    while (ReadInt(&type) >= 0 && (type < 1 || type > 4)) {
+        printf("Invalid choice. Please enter again: ");
+    }
+    if (type >= 1 && type <= 4) {
+        DefaultSession()->shuffleType = type;
+    }
+}
+
+/**
+ * @brief Permet à l'utilisateur de choisir entre l'affichage dans une fenêtre et l'export sans affichage.
+ */
+void SetOutputMode() {
+    int mode = 0;
+    printf("Choose output:\n");
+    printf(" 0 - Window\n");
+    printf(" 1 - Y4M video export\n");
+    printf(" 2 - PNG sequence export\n");
+    printf("Your choice: ");
+    if (ReadInt(&mode) != 1 || mode < EXPORT_NONE || mode > EXPORT_PNG) {
+        printf("Bad input\n");
+        return;
+    }
+
+    char path[256] = "";
+    if (mode != EXPORT_NONE) {
+        char line[256];
+        printf("Enter output path: ");
+        char *entered = read_line(line, sizeof(line));
+        if (entered != NULL) snprintf(path, sizeof(path), "%s", entered);
+
+        int fps;
+        printf("Enter frame rate (fps): ");
+        if (ReadInt(&fps) == 1) {
+            SetExportFps(fps);
+        }
+    }
+
+    SetVisualOutput(mode, path);
+}
+
+/**
+ * @brief Affiche le menu des paramètres de visualisation et permet à l'utilisateur de les modifier.
+ */
+void ShowSettingsMenu(void) {
+    const SessionSettings *settings = &DefaultSession()->settings;
+    int done = 0;
+    while (!done) {
+        printf("\n=== Visualizer Settings ===\n");
+        printf("Current size: %dx%d\n", settings->width, settings->height);
+        printf("Current delay: %d ms\n", settings->delayMs);
+        if (settings->output == EXPORT_NONE) {
+            printf("Current output: window\n");
+        } else {
+            printf("Current output: %s export to %s at %d fps\n", settings->output == EXPORT_Y4M ? "Y4M" : "PNG", settings->exportPath, settings->exportFps);
+        }
+        printf("Choose an option:\n");
+        printf(" 1 - 640 x 480\n");
+        printf(" 2 - 800 x 600\n");
+        printf(" 3 - 1024 x 768\n");
+        printf(" 4 - 1280 x 720\n");
+        printf(" 5 - Custom size\n");
+        printf(" 6 - Change delay (ms)\n");
+        printf(" 7 - Change sample size\n");
+        printf(" 8 - Change type of shuffle\n");
+        printf(" 9 - Back\n");
+        printf(" 10 - Output (window / export)\n");
+        printf("Your choice: ");
+
+        int choice = 0;
+        int status = ReadInt(&choice);
+        if (status < 0) {
+            break;
+        }
+        if (status == 0) {
+            printf("Invalid input\n");
+            continue;
+        }
+
+        switch (choice) {
+            case 1: 
+                SetVisualSize(640, 480); 
+                break;
+
+            case 2: 
+                SetVisualSize(800, 600); 
+                break;
+
+            case 3: 
+                SetVisualSize(1024, 768); 
+                break;
+
+            case 4: 
+                SetVisualSize(1280, 720); 
+                break;
+
+            case 5: 
+                SetViewSize();
+                break;
+            
+            case 6:
+                SetDelay();
+                break;
+
+            case 7: 
+                SetTabSample();
+                break;
+
+            case 8 : 
+                SetShuffleType();
+                break;
+
+            case 9: 
+                done = 1; 
+                break;
+
+            case 10:
+                SetOutputMode();
+                break;
+
+            default: 
+                printf("Unknown option\n"); break;
+        }
+    }
 }
\ No newline at end of file
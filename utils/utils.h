@@ -1,30 +1,56 @@
-/**
- * @file utils.h
- * @brief Déclarations des fonctions utilitaires pour le projet de visualisation des algorithmes de tri.
- * @author MUZARD Thomas
- * @date 27/10/2025
- */
-
-#ifndef UTILS_H
-#define UTILS_H
-
-// Fonction pour l'échantillon de test
-void FreeTabSample();
-void LoadSample();
-
-// Fonction pour les paramètres de la visualisation
-void SetVisualSize(int width, int height);
-void SetVisualDelay(int delay_ms);
-
-int GetVisualWidth();
-int GetVisualHeight();
-int GetVisualDelay();
-
-// Fonction utilitaires
-void ChooseAlgorithm(int idxAlgo);
-void ShowSettingsMenu();
-void ShowShuffleMenu();
-void PrintTab(int tab[], int n);
-void ShuffleSample(int type);
-
-#endif // UTILS_H
+/**
+ * @file utils.h
+ * @brief Déclarations des fonctions utilitaires pour le projet de visualisation des algorithmes de tri.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef UTILS_H
+#define UTILS_H
+
+// Fonction pour l'échantillon de test (session par défaut, voir session.h)
+void FreeTabSample();
+void LoadSample();
+int *ReserveSample(int capacity);
+
+// Fonction pour les paramètres de la visualisation
+void SetVisualSize(int width, int height);
+void SetVisualDelay(int delay_ms);
+
+int GetVisualWidth();
+int GetVisualHeight();
+int GetVisualDelay();
+
+// Fonction pour l'export sans affichage
+void SetVisualOutput(int mode, const char *path);
+void SetExportFps(int fps);
+int GetVisualOutput(void);
+const char *GetExportPath(void);
+int GetExportFps(void);
+
+// Fonction utilitaires
+void ShowMainMenu(void);    // registered algorithms, then Settings ... Exit
+int MainMenuExit(void);     // number of the Exit entry, the last one
+void ChooseAlgorithm(int idxAlgo);
+void ShowSettingsMenu();
+void ShowShuffleMenu();
+void ShowBenchmarkMenu(void);
+void ShowSelectionMenu(void);
+void PrintTab(int tab[], int n);
+int ReadInt(int *value);
+void ShuffleSample(int type);
+
+// Génération d'entrées
+void RandomShuffle(int tab[], int n);
+void NearlySorted(int tab[], int n);
+void ReverseSorted(int tab[], int n);
+void Sorted(int tab[], int n);
+void FillSample(int tab[], int n, int type);
+
+// Same inputs from a caller-owned generator state (xorshift64*, non-zero), NULL falls back to rand().
+unsigned int RandomNext(unsigned long long *state);
+void RandomShuffleWith(int tab[], int n, unsigned long long *state);
+void ShuffleWith(int tab[], int n, int type, unsigned long long *state);
+void FillSampleWith(int tab[], int n, int type, unsigned long long *state);
+
+#endif // UTILS_H
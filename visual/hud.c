@@ -0,0 +1,234 @@
+#include "hud.h"
+#include "../sorting/sorting.h"
+#include "../stats/stats.h"
+#include <stdio.h>
+
+/**
+ * @file hud.c
+ * @brief Incrustation des mesures de la relecture : nom et taille, opérations rejouées, débits, temps de
+ * rendu et son 99e centile, part des étapes regroupées, temps écoulé.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Le texte est dessiné avec une police 5 x 7 intégrée (pas de SDL_ttf) dans un petit tampon de pixels,
+ * qui n'est redessiné que toutes les HUD_REFRESH secondes : à chaque image, la relecture ne fait que
+ * mesurer son temps de rendu et recopier la texture de l'incrustation.
+ */
+
+/**
+ * @brief Police 5 x 7 des caractères ' ' à 'Z' : une ligne par octet, de haut en bas, bit 4 à gauche.
+ */
+static const uint8_t font[][7] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 }, // !
+    { 0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00 }, // "
+    { 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A }, // #
+    { 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04 }, // $
+    { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // %
+    { 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D }, // &
+    { 0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00 }, // '
+    { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // (
+    { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // )
+    { 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00 }, // *
+    { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 }, // +
+    { 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 }, // ,
+    { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 }, // -
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C }, // .
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // /
+    { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E }, // 0
+    { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 1
+    { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F }, // 2
+    { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E }, // 3
+    { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 }, // 4
+    { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E }, // 5
+    { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E }, // 6
+    { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // 7
+    { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E }, // 8
+    { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C }, // 9
+    { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, // :
+    { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08 }, // ;
+    { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 }, // <
+    { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 }, // =
+    { 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 }, // >
+    { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 }, // ?
+    { 0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E }, // @
+    { 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 }, // A
+    { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E }, // B
+    { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E }, // C
+    { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C }, // D
+    { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F }, // E
+    { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 }, // F
+    { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F }, // G
+    { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // H
+    { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // I
+    { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C }, // J
+    { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // K
+    { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F }, // L
+    { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 }, // M
+    { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // N
+    { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // O
+    { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 }, // P
+    { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D }, // Q
+    { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 }, // R
+    { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E }, // S
+    { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // T
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // U
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // V
+    { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A }, // W
+    { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 }, // X
+    { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 }, // Y
+    { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F }, // Z
+};
+
+/**
+ * @brief Dessine un texte avec la police intégrée, en découpant ce qui dépasse du tampon.
+ *
+ * @param pixels Le tampon (pitch en pixels).
+ * @param x Abscisse du coin supérieur gauche du premier caractère.
+ * @param y Ordonnée du coin supérieur gauche du premier caractère.
+ * @param text Le texte (minuscules affichées en majuscules, caractères inconnus affichés '?').
+ * @param color La couleur du texte.
+ * @param scale Taille d'un pixel de la police, en pixels.
+ */
+void HudDrawText(uint32_t *pixels, int width, int height, int pitch, int x, int y,
+                 const char *text, uint32_t color, int scale) {
+    for (; *text != '\0'; text++, x += HUD_GLYPH_WIDTH * scale) {
+        int c = (unsigned char)*text;
+        if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+        if (c < ' ' || c > 'Z') c = '?';
+        const uint8_t *glyph = font[c - ' '];
+
+        for (int row = 0; row < 7 * scale; row++) {
+            int py = y + row;
+            if (py < 0 || py >= height) continue;
+            uint8_t bits = glyph[row / scale];
+            if (bits == 0) continue;
+            for (int col = 0; col < 5 * scale; col++) {
+                int px = x + col;
+                if (px >= 0 && px < width && (bits & (0x10 >> (col / scale)))) {
+                    pixels[(size_t)py * pitch + px] = color;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Initialise les statistiques d'une relecture.
+ *
+ * @param name Le nom de l'algorithme.
+ * @param n La taille du tableau.
+ * @param operations Comparaisons et écritures comptées pendant l'enregistrement.
+ * @param sortSeconds Durée de l'enregistrement.
+ */
+void HudInit(HudStats *hud, const char *name, int n, long long operations, double sortSeconds) {
+    *hud = (HudStats){ 0 };
+    hud->name = name;
+    hud->n = n;
+    hud->start = StatsNow();
+    hud->lastRefresh = hud->start - HUD_REFRESH;
+    hud->sortOpsPerSecond = sortSeconds > 0 ? (double)operations / sortSeconds : 0;
+}
+
+/**
+ * @brief Compte les comparaisons et les écritures de la trace jusqu'à une étape, d'après la nature des
+ * opérations : un échange compte deux écritures, même entre valeurs égales. En lecture, seules les étapes
+ * parcourues depuis l'appel précédent sont comptées.
+ *
+ * @param trace La trace relue.
+ * @param step L'étape affichée.
+ */
+void HudCount(HudStats *hud, const Trace *trace, long step) {
+    if (step < hud->counted) {
+        hud->counted = 0;
+        hud->comparisons = 0;
+        hud->writes = 0;
+    }
+    for (long s = hud->counted; s < step; s++) {
+        unsigned char kind = trace->ops[s].kind;
+        hud->comparisons += kind == TRACE_OP_COMPARE;
+        hud->writes += kind == TRACE_OP_SWAP ? 2 : kind == TRACE_OP_WRITE;
+    }
+    hud->counted = step;
+}
+
+/**
+ * @brief Enregistre une image : son temps de rendu et le nombre d'étapes dont elle a avancé.
+ */
+void HudFrame(HudStats *hud, double seconds, long advanced) {
+    hud->frameMicros[hud->nextSample] = (int)(seconds * 1e6);
+    hud->nextSample = (hud->nextSample + 1) % HUD_FRAME_SAMPLES;
+    if (hud->nbSamples < HUD_FRAME_SAMPLES) hud->nbSamples++;
+    if (advanced > 0) {
+        hud->advanced += advanced;
+        hud->frames++;
+    }
+}
+
+/**
+ * @brief Indique si le texte de l'incrustation doit être redessiné.
+ */
+int HudDue(const HudStats *hud, double now) {
+    return now - hud->lastRefresh >= HUD_REFRESH;
+}
+
+/**
+ * @brief Écrit un nombre avec un suffixe K, M ou G.
+ */
+static void format_count(char *buffer, size_t size, double value) {
+    if (value >= 1e9) snprintf(buffer, size, "%.1fG", value / 1e9);
+    else if (value >= 1e6) snprintf(buffer, size, "%.1fM", value / 1e6);
+    else if (value >= 1e4) snprintf(buffer, size, "%.1fK", value / 1e3);
+    else snprintf(buffer, size, "%.0f", value);
+}
+
+/**
+ * @brief Met en forme les statistiques et les dessine dans le tampon de l'incrustation.
+ *
+ * @param pixels Le tampon, HUD_WIDTH x HUD_HEIGHT.
+ * @param now L'instant courant (StatsNow()).
+ */
+void HudDraw(HudStats *hud, uint32_t *pixels, double now) {
+    double period = now - hud->lastRefresh;
+    if (period > 0 && period < 2 * HUD_REFRESH) {
+        hud->playRate = (double)(hud->advanced - hud->advancedAtRefresh) / period;
+    }
+    hud->advancedAtRefresh = hud->advanced;
+    hud->lastRefresh = now;
+
+    // Mean and 99th percentile of the last frames.
+    int samples[HUD_FRAME_SAMPLES];
+    long long total = 0;
+    for (int i = 0; i < hud->nbSamples; i++) {
+        samples[i] = hud->frameMicros[i];
+        total += samples[i];
+    }
+    double mean = 0, p99 = 0;
+    if (hud->nbSamples > 0) {
+        int nth = hud->nbSamples * 99 / 100;
+        NthElement(samples, hud->nbSamples, nth);
+        mean = (double)total / hud->nbSamples / 1e3;
+        p99 = samples[nth] / 1e3;
+    }
+    double coalesced = hud->advanced > 0 ? 100.0 * (double)(hud->advanced - hud->frames) / (double)hud->advanced : 0;
+
+    char comparisons[16], writes[16], sortRate[16], playRate[16];
+    format_count(comparisons, sizeof(comparisons), (double)hud->comparisons);
+    format_count(writes, sizeof(writes), (double)hud->writes);
+    format_count(sortRate, sizeof(sortRate), hud->sortOpsPerSecond);
+    format_count(playRate, sizeof(playRate), hud->playRate);
+
+    char lines[HUD_LINES][HUD_LINE_LENGTH + 1];
+    snprintf(lines[0], sizeof(lines[0]), "%.16s N=%d", hud->name, hud->n);
+    snprintf(lines[1], sizeof(lines[1]), "CMP %.8s WR %.8s", comparisons, writes);
+    snprintf(lines[2], sizeof(lines[2]), "OPS/S %.7s SORT %.7s PLAY", sortRate, playRate);
+    snprintf(lines[3], sizeof(lines[3]), "FRAME %.2fMS P99 %.2fMS", mean, p99);
+    snprintf(lines[4], sizeof(lines[4]), "COALESCED %.1f%% T %.1fS", coalesced, now - hud->start);
+
+    for (int i = 0; i < HUD_WIDTH * HUD_HEIGHT; i++) pixels[i] = HUD_BACKGROUND;
+    int cellWidth = HUD_GLYPH_WIDTH * HUD_SCALE, cellHeight = HUD_GLYPH_HEIGHT * HUD_SCALE;
+    for (int line = 0; line < HUD_LINES; line++) {
+        HudDrawText(pixels, HUD_WIDTH, HUD_HEIGHT, HUD_WIDTH, cellWidth, cellHeight / 2 + line * cellHeight,
+                    lines[line], HUD_TEXT, HUD_SCALE);
+    }
+}
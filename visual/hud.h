@@ -0,0 +1,71 @@
+/**
+ * @file visual/hud.h
+ * @brief Incrustation des mesures de la relecture (HUD) : police bitmap intégrée et rendu dans un tampon de pixels (sans SDL).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef HUD_H
+#define HUD_H
+
+#include <stdint.h>
+#include "../trace/trace.h"
+
+// Built-in font: 5 x 7 glyphs in a 6 x 8 cell, drawn HUD_SCALE times larger.
+#define HUD_GLYPH_WIDTH  6
+#define HUD_GLYPH_HEIGHT 8
+#define HUD_SCALE 2
+
+#define HUD_LINES 5
+#define HUD_LINE_LENGTH 32
+// Size of the overlay in pixels: the text and a one-cell margin around it.
+#define HUD_WIDTH  ((HUD_LINE_LENGTH + 2) * HUD_GLYPH_WIDTH * HUD_SCALE)
+#define HUD_HEIGHT ((HUD_LINES + 1) * HUD_GLYPH_HEIGHT * HUD_SCALE)
+
+// Colours (0xAARRGGBB): the background is translucent, the overlay is blended over the bars.
+#define HUD_BACKGROUND 0xB0000000u
+#define HUD_TEXT       0xFF50E050u
+
+// Frame times kept for the percentile.
+#define HUD_FRAME_SAMPLES 128
+// Seconds between two refreshes of the text: the overlay texture is only redrawn at that pace.
+#define HUD_REFRESH 0.25
+
+typedef struct HudStats {
+    const char *name;
+    int n;
+    double start;            // StatsNow() when the playback started
+    double sortOpsPerSecond; // operations counted while recording, per second of recording
+
+    // Operations replayed up to step `counted` (incremental while the playback moves forward).
+    long counted;
+    long long comparisons;
+    long long writes;
+
+    // Playback: steps advanced and frames drawn while playing. Steps beyond one per frame are coalesced.
+    long long advanced;
+    long long frames;
+    long long advancedAtRefresh;
+    double lastRefresh;
+    double playRate;         // steps per second over the last refresh period
+
+    int frameMicros[HUD_FRAME_SAMPLES];  // render time of the last frames
+    int nbSamples;
+    int nextSample;
+} HudStats;
+
+void HudInit(HudStats *hud, const char *name, int n, long long operations, double sortSeconds);
+// Count the comparisons and writes of the trace up to step (forward from the last call, else from 0).
+void HudCount(HudStats *hud, const Trace *trace, long step);
+// Record one frame: its render time and the steps it advanced (0 when paused).
+void HudFrame(HudStats *hud, double seconds, long advanced);
+// 1 when the text is due for a refresh at time now.
+int HudDue(const HudStats *hud, double now);
+// Format the statistics and draw them into pixels (HUD_WIDTH x HUD_HEIGHT, pitch HUD_WIDTH).
+void HudDraw(HudStats *hud, uint32_t *pixels, double now);
+
+// Draw text with the built-in font (lower case shown as upper case, unknown characters as '?').
+void HudDrawText(uint32_t *pixels, int width, int height, int pitch, int x, int y,
+                 const char *text, uint32_t color, int scale);
+
+#endif // HUD_H
@@ -0,0 +1,256 @@
+#include "raster.h"
+#include "../utils/threadpool.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @file raster.c
+ * @brief Rendu logiciel du tableau dans un tampon de pixels, utilisé pour l'export sans affichage et pour
+ * les tableaux plus grands que la fenêtre.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * Le rendu se fait en deux temps : le tableau est réduit en une valeur et une couleur par colonne de
+ * pixels, puis l'image est remplie depuis les colonnes. Les deux étapes peuvent être réparties sur une
+ * réserve de threads : par plages de colonnes contiguës pour la réduction, par bandes de lignes pour
+ * le remplissage.
+ */
+
+/**
+ * @brief Cherche la valeur maximale du tableau (au moins 1).
+ *
+ * @param tab Le tableau.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ * @return La valeur maximale.
+ */
+int RasterMaxValue(const int tab[], int nbValue) {
+    int maxvalue = 1;
+    for (int i = 0; i < nbValue; ++i) {
+        if (tab[i] > maxvalue) {
+            maxvalue = tab[i];
+        }
+    }
+    return maxvalue;
+}
+
+/**
+ * @brief Alloue les agrégats de width colonnes.
+ *
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+int RasterColumnsInit(RasterColumns *columns, int width) {
+    columns->width = width > 0 ? width : 0;
+    columns->maxvalue = 1;
+    columns->top = (int*)malloc((columns->width + 1) * sizeof(int));
+    columns->color = (uint32_t*)malloc((columns->width + 1) * sizeof(uint32_t));
+    if (columns->top == NULL || columns->color == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        RasterColumnsFree(columns);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Libère les agrégats de colonnes.
+ */
+void RasterColumnsFree(RasterColumns *columns) {
+    free(columns->top);
+    free(columns->color);
+    columns->top = NULL;
+    columns->color = NULL;
+    columns->width = 0;
+}
+
+/**
+ * @brief Plage de travail d'une tâche : colonnes [first, last) pour la réduction, lignes [first, last)
+ * pour le remplissage.
+ */
+typedef struct RasterPart {
+    RasterColumns *columns;
+    const int *tab;
+    int nbValue;
+    int highlight_a, highlight_b;
+    uint32_t *pixels;
+    const int *colHeight;  // bar heights in pixels, shared by the fill tasks
+    int height, pitch;
+    int first, last;
+    int partMax;  // tallest value met by the reduction of this range
+} RasterPart;
+
+/**
+ * @brief Réduit les colonnes [first, last) : chaque colonne garde la plus haute des valeurs qu'elle
+ * couvre, en rouge si l'une d'elles est mise en évidence.
+ */
+static void reduce_part(void *arg) {
+    RasterPart *part = (RasterPart*)arg;
+    RasterColumns *columns = part->columns;
+    const int *tab = part->tab;
+    int width = columns->width, nbValue = part->nbValue;
+    int partMax = 1;
+
+    if (nbValue <= width) {
+        // Same layout as the SDL renderer: one bar of bar_width pixels (minus a gap) per value.
+        int bar_width = width / (nbValue > 0 ? nbValue : 1);
+        int bar_fill = bar_width > 1 ? bar_width - 1 : 1;
+        for (int x = part->first; x < part->last; x++) {
+            int i = x / bar_width;
+            columns->top[x] = 0;
+            columns->color[x] = RASTER_BAR;
+            if (i < nbValue && x - i * bar_width < bar_fill) {
+                columns->top[x] = tab[i];
+                if (tab[i] > partMax) partMax = tab[i];
+                if (i == part->highlight_a || i == part->highlight_b) columns->color[x] = RASTER_HIGHLIGHT;
+            }
+        }
+    } else {
+        // Several values per column: keep the tallest one.
+        for (int x = part->first; x < part->last; x++) {
+            long first = (long)x * nbValue / width;
+            long last = (long)(x + 1) * nbValue / width;
+            int top = 0;
+            for (long i = first; i < last; i++) {
+                if (tab[i] > top) top = tab[i];
+            }
+            columns->top[x] = top;
+            columns->color[x] = RASTER_BAR;
+            if ((part->highlight_a >= first && part->highlight_a < last) ||
+                (part->highlight_b >= first && part->highlight_b < last)) {
+                columns->color[x] = RASTER_HIGHLIGHT;
+            }
+            if (top > partMax) partMax = top;
+        }
+    }
+    part->partMax = partMax;
+}
+
+/**
+ * @brief Remplit les lignes [first, last) de l'image depuis les hauteurs de barres.
+ */
+static void fill_part(void *arg) {
+    RasterPart *part = (RasterPart*)arg;
+    const uint32_t *color = part->columns->color;
+    int width = part->columns->width;
+
+    for (int y = part->first; y < part->last; y++) {
+        uint32_t *row = part->pixels + (long)y * part->pitch;
+        int fromBottom = part->height - y;
+        for (int x = 0; x < width; x++) {
+            row[x] = fromBottom <= part->colHeight[x] ? color[x] : RASTER_BACKGROUND;
+        }
+    }
+}
+
+/**
+ * @brief Découpe [0, count) en plages contiguës et les exécute sur la réserve (ou sur le thread appelant).
+ *
+ * @param parts Les plages, dont les champs communs sont déjà remplis dans parts[0].
+ * @param count Le nombre de colonnes ou de lignes.
+ * @param nbParts Le nombre de plages souhaité.
+ */
+static int run_parts(RasterPart parts[], int count, int nbParts, ThreadTask task, ThreadPool *pool) {
+    if (nbParts > RASTER_MAX_PARTS) nbParts = RASTER_MAX_PARTS;
+    if (nbParts > count) nbParts = count;
+    if (nbParts < 1) nbParts = 1;
+
+    for (int p = 0; p < nbParts; p++) {
+        parts[p] = parts[0];
+        parts[p].first = (int)((long)count * p / nbParts);
+        parts[p].last = (int)((long)count * (p + 1) / nbParts);
+        parts[p].partMax = 1;
+    }
+    for (int p = 0; p < nbParts; p++) {
+        if (pool == NULL || nbParts == 1 || ThreadPoolSubmit(pool, task, &parts[p]) != 0) task(&parts[p]);
+    }
+    if (pool != NULL && nbParts > 1) ThreadPoolWait(pool);
+    return nbParts;
+}
+
+/**
+ * @brief Réduit le tableau en une valeur et une couleur par colonne de pixels, et calcule la valeur
+ * maximale du tableau dans le même parcours.
+ *
+ * Avec une réserve, chaque thread réduit une plage contiguë de colonnes, donc d'indices du tableau ;
+ * les maxima des plages sont ensuite fusionnés.
+ *
+ * @param columns Les colonnes à remplir (width colonnes).
+ * @param tab Le tableau à afficher.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ * @param highlight_a Indice du premier élément à mettre en évidence.
+ * @param highlight_b Indice du second élément à mettre en évidence.
+ * @param pool La réserve de threads (NULL : thread appelant).
+ */
+void RasterReduceColumns(RasterColumns *columns, const int tab[], int nbValue,
+                         int highlight_a, int highlight_b, ThreadPool *pool) {
+    RasterPart parts[RASTER_MAX_PARTS];
+    parts[0] = (RasterPart){ .columns = columns, .tab = tab, .nbValue = nbValue,
+                             .highlight_a = highlight_a, .highlight_b = highlight_b };
+
+    int nbParts = 1;
+    if (pool != NULL && nbValue >= RASTER_PARALLEL_MIN) nbParts = 4 * ThreadPoolSize(pool);
+    nbParts = run_parts(parts, columns->width, nbParts, reduce_part, pool);
+
+    int maxvalue = 1;
+    for (int p = 0; p < nbParts; p++) {
+        if (parts[p].partMax > maxvalue) maxvalue = parts[p].partMax;
+    }
+    columns->maxvalue = maxvalue;
+}
+
+/**
+ * @brief Dessine les colonnes réduites dans un tampon ARGB, barres mises à l'échelle de maxvalue.
+ *
+ * @param pixels Le tampon de pixels (0xAARRGGBB), d'au moins columns->width pixels de large.
+ * @param height Hauteur de l'image.
+ * @param pitch Nombre de pixels entre deux lignes du tampon.
+ * @param columns Les colonnes réduites.
+ * @param maxvalue Valeur correspondant à une barre pleine hauteur.
+ * @param pool La réserve de threads (NULL : thread appelant).
+ */
+void RasterFillColumns(uint32_t *pixels, int height, int pitch, const RasterColumns *columns,
+                       int maxvalue, ThreadPool *pool) {
+    int width = columns->width;
+    if (width <= 0 || height <= 0) return;
+
+    int *colHeight = (int*)malloc(width * sizeof(int));
+    if (colHeight == NULL) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return;
+    }
+    int usable = height - RASTER_TOP_MARGIN;
+    if (maxvalue <= 0) maxvalue = 1;
+    for (int x = 0; x < width; x++) {
+        colHeight[x] = (int)((float)columns->top[x] / (float)maxvalue * usable);
+    }
+
+    RasterPart parts[RASTER_MAX_PARTS];
+    parts[0] = (RasterPart){ .columns = (RasterColumns*)columns, .pixels = pixels, .colHeight = colHeight,
+                             .height = height, .pitch = pitch };
+    run_parts(parts, height, pool != NULL ? ThreadPoolSize(pool) : 1, fill_part, pool);
+    free(colHeight);
+}
+
+/**
+ * @brief Rendu du tableau sous forme de barres verticales dans un tampon ARGB, sur le thread appelant.
+ *
+ * @param pixels Le tampon de pixels (0xAARRGGBB).
+ * @param width Largeur de l'image.
+ * @param height Hauteur de l'image.
+ * @param pitch Nombre de pixels entre deux lignes du tampon.
+ * @param tab Le tableau à afficher.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ * @param maxvalue Valeur correspondant à une barre pleine hauteur.
+ * @param highlight_a Indice du premier élément à mettre en évidence.
+ * @param highlight_b Indice du second élément à mettre en évidence.
+ */
+void RasterizeArray(uint32_t *pixels, int width, int height, int pitch,
+                    const int tab[], int nbValue, int maxvalue,
+                    int highlight_a, int highlight_b) {
+    if (width <= 0 || height <= 0) return;
+
+    RasterColumns columns;
+    if (RasterColumnsInit(&columns, width) != 0) return;
+    RasterReduceColumns(&columns, tab, nbValue, highlight_a, highlight_b, NULL);
+    RasterFillColumns(pixels, height, pitch, &columns, maxvalue, NULL);
+    RasterColumnsFree(&columns);
+}
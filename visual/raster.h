@@ -0,0 +1,55 @@
+/**
+ * @file visual/raster.h
+ * @brief Rendu logiciel du tableau en barres verticales dans un tampon de pixels (sans SDL).
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ */
+
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <stdint.h>
+
+// Colours (0xAARRGGBB), identical to the ones used by the SDL renderer.
+#define RASTER_BACKGROUND 0xFF000000u
+#define RASTER_BAR        0xFFC8C8C8u
+#define RASTER_HIGHLIGHT  0xFFDC2828u
+
+// Margin kept above the tallest bar, in pixels.
+#define RASTER_TOP_MARGIN 20
+
+// Below this many values, columns are reduced on the calling thread even when a pool is given.
+#define RASTER_PARALLEL_MIN (1 << 16)
+// Upper bound on the ranges a reduction or a fill is split into.
+#define RASTER_MAX_PARTS 64
+
+struct ThreadPool;
+
+// Per-pixel-column aggregates of one frame.
+typedef struct RasterColumns {
+    int width;
+    int *top;         // tallest value covered by the column (0: gap between bars)
+    uint32_t *color;  // bar colour of the column
+    int maxvalue;     // tallest value of the whole array (at least 1)
+} RasterColumns;
+
+int RasterMaxValue(const int tab[], int nbValue);
+
+int RasterColumnsInit(RasterColumns *columns, int width);
+void RasterColumnsFree(RasterColumns *columns);
+
+// Reduce the array into columns->width columns in a single sweep. With a pool, every worker reduces
+// a contiguous range of columns (hence of indices) and the per-range maxima are merged afterwards.
+void RasterReduceColumns(RasterColumns *columns, const int tab[], int nbValue,
+                         int highlight_a, int highlight_b, struct ThreadPool *pool);
+// Draw reduced columns into pixels, bars scaled to maxvalue; with a pool, rows are split between workers.
+void RasterFillColumns(uint32_t *pixels, int height, int pitch, const RasterColumns *columns,
+                       int maxvalue, struct ThreadPool *pool);
+
+// Draw the array into pixels (pitch given in pixels). When there are more
+// values than columns, each column shows the tallest bar it covers.
+void RasterizeArray(uint32_t *pixels, int width, int height, int pitch,
+                    const int tab[], int nbValue, int maxvalue,
+                    int highlight_a, int highlight_b);
+
+#endif // RASTER_H
@@ -1,246 +1,572 @@
-#include "visual.h"
-#include <SDL2/SDL.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include "../utils/utils.h"
-#include "../sorting/sorting.h"
-
-/**
- * @file visual.c
- * @brief Implémentation des fonctions de visualisation des algorithmes de tri.
- * @author MUZARD Thomas
- * @date 27/10/2025
- */
-
- /**
-  * @brief Rendu du tableau sous forme de barres verticales.
-  * 
-  * @param renderer Le renderer SDL.
-  * @param tab Le tableau à afficher.
-  * @param nbValue Le nombre d'éléments dans le tableau.
-  * @param highlight_a Indice du premier élément à mettre en évidence.
-  * @param highlight_b Indice du second élément à mettre en évidence.
-  */
-static void render_array(SDL_Renderer *renderer, int tab[], int nbValue, int highlight_a, int highlight_b) {
-    int width, height;
-    SDL_GetRendererOutputSize(renderer, &width, &height);
-
-    // find max value
-    int maxvalue = 1;
-    for (int i = 0; i < nbValue; ++i) {
-        if (tab[i] > maxvalue) {
-            maxvalue = tab[i];
-        }
-    }
-
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
-
-    int bar_width = width / (nbValue > 0 ? nbValue : 1);
-    for (int i = 0; i < nbValue; ++i) {
-        float normalized = (float)tab[i] / (float)maxvalue;
-        int bar_height = (int)(normalized * (height - 20)); // margin
-
-        SDL_Rect bar;
-        bar.x = i * bar_width;
-        bar.w = bar_width > 1 ? bar_width - 1 : 1; // small gap
-        bar.y = height - bar_height;
-        bar.h = bar_height;
-
-        if (i == highlight_a || i == highlight_b) {
-            SDL_SetRenderDrawColor(renderer, 220, 40, 40, 255);
-        } else {
-            SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
-        }
-
-        SDL_RenderFillRect(renderer, &bar);
-    }
-
-    SDL_RenderPresent(renderer);
-}
-
-/**
- * @brief Renderer SDL global pour la visualisation.
- */
-static SDL_Renderer *graph_renderer = NULL;
-/**
- * @brief Indicateur d'exécution de la boucle principale de visualisation.
- */
-static int graph_running = 0;
-/**
- * @brief Indicateur de pause de la visualisation.
- */
-static int graph_paused = 0;
-
-/**
- * @brief Callback de visualisation appelé par les algorithmes de tri instrumentés.
- * 
- * @param tab Le tableau en cours de tri.
- * @param nbValue Le nombre d'éléments dans le tableau.
- * @param a Indice du premier élément à mettre en évidence.
- * @param b Indice du second élément à mettre en évidence.
- */
-static void viz_callback(int tab[], int nbValue, int a, int b) {
-    if (!graph_renderer) return;
-
-    SDL_Event event;
-    while (SDL_PollEvent(&event)) {
-        if (event.type == SDL_QUIT) { graph_running = 0; return; }
-        if (event.type == SDL_KEYDOWN) {
-            if (event.key.keysym.sym == SDLK_SPACE)
-                graph_paused = !graph_paused;
-            if (event.key.keysym.sym == SDLK_q || event.key.keysym.sym == SDLK_ESCAPE) {
-                graph_running = 0;
-                return;
-            }
-        }
-        if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
-            render_array(graph_renderer, tab, nbValue, a, b);
-        }
-    }
-
-    while (graph_paused && graph_running) {
-        SDL_Event event2;
-        while (SDL_WaitEvent(&event2)) {
-            if (event2.type == SDL_QUIT) {
-                graph_running = 0;
-                return;
-            }
-            if (event2.type == SDL_KEYDOWN) {
-                if (event2.key.keysym.sym == SDLK_SPACE) {
-                    graph_paused = 0;
-                    break;
-                }
-                if (event2.key.keysym.sym == SDLK_q || event2.key.keysym.sym == SDLK_ESCAPE) {
-                    graph_running = 0;
-                    return;
-                }
-            }
-        }
-    }
-
-    render_array(graph_renderer, tab, nbValue, a, b);
-    SDL_Delay(GetVisualDelay());
-}
-
-/**
- * @brief Fonction principale de visualisation d'un algorithme de tri.
- * 
- * @param tab Le tableau à trier.
- * @param nbValue Le nombre d'éléments dans le tableau.
- * @param sortWithCb Pointeur vers la fonction de tri instrumentée à utiliser.
- */
-void VisualizeSort(int tab[], int nbValue, void (*sortWithCb)(int[], int, VizCallback)) {
-    if (nbValue <= 0) return;
-
-    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
-        fprintf(stderr, "SDL_Init Error: %s\n", SDL_GetError());
-        return;
-    }
-
-    int win_w = GetVisualWidth();
-    int win_h = GetVisualHeight();
-
-    SDL_Window *win = SDL_CreateWindow("Sort Visualizer",
-                                       SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-                                       win_w, win_h,
-                                       SDL_WINDOW_RESIZABLE);
-    if (!win) {
-        fprintf(stderr, "SDL_CreateWindow Error: %s\n", SDL_GetError());
-        SDL_Quit();
-        return;
-    }
-
-    g_renderer = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    if (!g_renderer) {
-        fprintf(stderr, "SDL_CreateRenderer Error: %s\n", SDL_GetError());
-        SDL_DestroyWindow(win);
-        SDL_Quit();
-        g_renderer = NULL;
-        return;
-    }
-
-    g_running = 1;
-    g_paused = 0;
-
-    // Initial render
-    render_array(g_renderer, tab, nbValue, -1, -1);
-
-    // Run the provided instrumented sort which will call viz_callback
-    if (sortWithCb) {
-        sortWithCb(tab, nbValue, viz_callback);
-    }
-
-    // final render
-    render_array(g_renderer, tab, nbValue, -1, -1);
-
-    // wait until user closes or presses q/escape
-    while (g_running) {
-        SDL_Event e;
-        while (SDL_WaitEvent(&e)) {
-            if (e.type == SDL_QUIT) { g_running = 0; break; }
-            if (e.type == SDL_KEYDOWN) {
-                if (e.key.keysym.sym == SDLK_q || e.key.keysym.sym == SDLK_ESCAPE) { g_running = 0; break; }
-            }
-            if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
-                render_array(g_renderer, tab, nbValue, -1, -1);
-            }
-        }
-    }
-
-    SDL_DestroyRenderer(g_renderer);
-    SDL_DestroyWindow(win);
-    SDL_Quit();
-    g_renderer = NULL;
-}
-
-/**
- * @brief Fonctions de visualisation spécifiques pour chaque algorithme de tri, plus précisément pour le trie à bulle.
- * 
- * @param tab Le tableau à trier.
- * @param nbValue Le nombre d'éléments dans le tableau.
- */
-void VisualizeBubbleSort(int tab[], int nbValue) {
-    VisualizeSort(tab, nbValue, BubbleSort_viz);
-}
-
-/**
- * @brief Fonctions de visualisation spécifiques pour chaque algorithme de tri, plus précisément pour le trie par sélection.
- * 
- * @param tab Le tableau à trier.
- * @param nbValue Le nombre d'éléments dans le tableau.
- */
-void VisualizeSelectSort(int tab[], int nbValue) {
-    VisualizeSort(tab, nbValue, SelectSort_viz);
-}
-
-/**
- * @brief Fonctions de visualisation spécifiques pour chaque algorithme de tri, plus précisément pour le trie par insertion.
- * 
- * @param tab Le tableau à trier.
- * @param nbValue Le nombre d'éléments dans le tableau.
- */
-void VisualizeInsertionSort(int tab[], int nbValue) {
-    VisualizeSort(tab, nbValue, InsertionSort_viz);
-}
-
-/**
- * @brief Fonctions de visualisation spécifiques pour chaque algorithme de tri, plus précisément pour le trie rapide.
- * 
- * @param tab Le tableau à trier.
- * @param nbValue Le nombre d'éléments dans le tableau.
- */
-void VisualizeQuickSort(int tab[], int nbValue) {
-    VisualizeSort(tab, nbValue, QuickSort_viz_wrapper);
-}
-
-/**
- * @brief Fonctions de visualisation spécifiques pour chaque algorithme de tri, plus précisément pour le trie fusion.
- * 
- * @param tab Le tableau à trier.
- * @param nbValue Le nombre d'éléments dans le tableau.
- */
-void VisualizeMergeSort(int tab[], int nbValue) {
-    VisualizeSort(tab, nbValue, MergeSort_viz_wrapper);
-}
-
+#include "visual.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../utils/utils.h"
+#include "../sorting/sorting.h"
+#include "../trace/trace.h"
+#include "../export/export.h"
+#include "../sorting/tuning.h"
+#include "../utils/threadpool.h"
+#include "../stats/stats.h"
+#include "../sorting/registry.h"
+#include "../sorting/autosort.h"
+#include "raster.h"
+#include "hud.h"
+
+/**
+ * @file visual.c
+ * @brief Implémentation des fonctions de visualisation des algorithmes de tri.
+ * @author MUZARD Thomas
+ * @date 27/10/2025
+ *
+ * La fenêtre, son renderer et les tampons du rendu appartiennent à la session qui visualise. SDL n'a
+ * qu'une file d'événements par processus : une seule session à la fois doit afficher une fenêtre, les
+ * autres exportent (l'export n'utilise pas SDL).
+ */
+
+/**
+ * @brief Fenêtre d'une session et état de sa relecture.
+ */
+struct VisualState {
+    SDL_Window *window;
+    SDL_Renderer *renderer;
+    ThreadPool *pool;        // prepares the frames of arrays wider than the window
+    SDL_Texture *texture;    // texture and pixels of the frames prepared by the software renderer
+    uint32_t *pixels;
+    int frameHeight;
+    RasterColumns columns;   // per pixel column aggregates of the current frame
+    SDL_Texture *hudTexture; // overlay of the playback statistics, redrawn every HUD_REFRESH seconds
+    uint32_t *hudPixels;
+    int showHud;
+    int running;             // playback loop running
+    int paused;
+};
+
+/**
+ * @brief Libère la texture, le tampon de pixels et les colonnes du rendu logiciel.
+ */
+static void release_frame(VisualState *view) {
+    if (view->texture) SDL_DestroyTexture(view->texture);
+    view->texture = NULL;
+    free(view->pixels);
+    view->pixels = NULL;
+    RasterColumnsFree(&view->columns);
+    view->frameHeight = 0;
+}
+
+/**
+ * @brief Rendu d'un tableau plus grand que la fenêtre : le tableau est réduit en colonnes de pixels sur la
+ * réserve de threads (un seul parcours, maximum compris), l'image est remplie puis envoyée dans une texture.
+ *
+ * @return 0 en cas de succès, -1 si la texture ou les tampons n'ont pas pu être créés.
+ */
+static int render_columns(VisualState *view, const int tab[], int nbValue, int highlight_a, int highlight_b,
+                          int width, int height) {
+    if (view->texture == NULL || view->columns.width != width || view->frameHeight != height) {
+        release_frame(view);
+        view->texture = SDL_CreateTexture(view->renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+        if (view->texture == NULL) {
+            fprintf(stderr, "SDL_CreateTexture Error: %s\n", SDL_GetError());
+            return -1;
+        }
+        view->pixels = (uint32_t*)malloc((size_t)width * height * sizeof(uint32_t));
+        if (view->pixels == NULL) {
+            fprintf(stderr, "Memory allocation failed\n");
+            release_frame(view);
+            return -1;
+        }
+        if (RasterColumnsInit(&view->columns, width) != 0) {
+            release_frame(view);
+            return -1;
+        }
+        view->frameHeight = height;
+    }
+
+    // Without a pool (creation failed), the frame is prepared on this thread.
+    if (view->pool == NULL) view->pool = ThreadPoolCreate(TuningThreads());
+
+    RasterReduceColumns(&view->columns, tab, nbValue, highlight_a, highlight_b, view->pool);
+    RasterFillColumns(view->pixels, height, width, &view->columns, view->columns.maxvalue, view->pool);
+    SDL_UpdateTexture(view->texture, NULL, view->pixels, width * (int)sizeof(uint32_t));
+    SDL_RenderCopy(view->renderer, view->texture, NULL, NULL);
+    return 0;
+}
+
+ /**
+  * @brief Rendu du tableau sous forme de barres verticales. Au-delà d'une valeur par colonne de pixels,
+  * l'image est préparée par render_columns au lieu de dessiner une barre par valeur.
+  * 
+  * @param view La fenêtre de la session.
+  * @param tab Le tableau à afficher.
+  * @param nbValue Le nombre d'éléments dans le tableau.
+  * @param highlight_a Indice du premier élément à mettre en évidence.
+  * @param highlight_b Indice du second élément à mettre en évidence.
+  *
+  * L'image n'est pas présentée : l'incrustation est dessinée par-dessus avant SDL_RenderPresent.
+  */
+static void render_array(VisualState *view, int tab[], int nbValue, int highlight_a, int highlight_b) {
+    SDL_Renderer *renderer = view->renderer;
+    int width, height;
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+
+    if (nbValue > width && render_columns(view, tab, nbValue, highlight_a, highlight_b, width, height) == 0) {
+        return;
+    }
+    // find max value
+    int maxvalue = 1;
+    for (int i = 0; i < nbValue; ++i) {
+        if (tab[i] > maxvalue) {
+            maxvalue = tab[i];
+        }
+    }
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+
+    int bar_width = width / (nbValue > 0 ? nbValue : 1);
+    for (int i = 0; i < nbValue; ++i) {
+        float normalized = (float)tab[i] / (float)maxvalue;
+        int bar_height = (int)(normalized * (height - 20)); // margin
+
+        SDL_Rect bar;
+        bar.x = i * bar_width;
+        bar.w = bar_width > 1 ? bar_width - 1 : 1; // small gap
+        bar.y = height - bar_height;
+        bar.h = bar_height;
+
+        if (i == highlight_a || i == highlight_b) {
+            SDL_SetRenderDrawColor(renderer, 220, 40, 40, 255);
+        } else {
+            SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
+        }
+
+        SDL_RenderFillRect(renderer, &bar);
+    }
+}
+
+/**
+ * @brief Libère la texture et le tampon de l'incrustation.
+ */
+static void release_hud(VisualState *view) {
+    if (view->hudTexture) SDL_DestroyTexture(view->hudTexture);
+    view->hudTexture = NULL;
+    free(view->hudPixels);
+    view->hudPixels = NULL;
+}
+
+/**
+ * @brief Dessine l'incrustation des statistiques en haut à gauche de la fenêtre. Le texte n'est remis en
+ * forme et la texture mise à jour que toutes les HUD_REFRESH secondes ; entre deux, la texture est
+ * seulement recopiée.
+ *
+ * @param view La fenêtre de la session.
+ * @param hud Les statistiques de la relecture.
+ * @param trace La trace relue.
+ * @param step L'étape affichée.
+ */
+static void draw_hud(VisualState *view, HudStats *hud, const Trace *trace, long step) {
+    if (view->hudTexture == NULL) {
+        view->hudTexture = SDL_CreateTexture(view->renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                             HUD_WIDTH, HUD_HEIGHT);
+        view->hudPixels = (uint32_t*)malloc((size_t)HUD_WIDTH * HUD_HEIGHT * sizeof(uint32_t));
+        if (view->hudTexture == NULL || view->hudPixels == NULL) {
+            if (view->hudTexture == NULL) fprintf(stderr, "SDL_CreateTexture Error: %s\n", SDL_GetError());
+            else fprintf(stderr, "Memory allocation failed\n");
+            release_hud(view);
+            view->showHud = 0;
+            return;
+        }
+        SDL_SetTextureBlendMode(view->hudTexture, SDL_BLENDMODE_BLEND);
+        hud->lastRefresh = hud->start - HUD_REFRESH;
+    }
+
+    double now = StatsNow();
+    if (HudDue(hud, now)) {
+        HudCount(hud, trace, step);
+        HudDraw(hud, view->hudPixels, now);
+        SDL_UpdateTexture(view->hudTexture, NULL, view->hudPixels, HUD_WIDTH * (int)sizeof(uint32_t));
+    }
+    SDL_Rect target = { 0, 0, HUD_WIDTH, HUD_HEIGHT };
+    SDL_RenderCopy(view->renderer, view->hudTexture, NULL, &target);
+}
+
+/**
+ * @brief Algorithme enregistré dont la version instrumentée est sortWithCb, NULL s'il n'y en a pas.
+ */
+static const SortAlgorithm *find_algorithm(VizSortFunction sortWithCb) {
+    for (int a = 0; a < SortAlgorithmCount(); a++) {
+        if (SortGetAlgorithm(a)->sortViz == sortWithCb) return SortGetAlgorithm(a);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Nom d'un tri instrumenté d'après le registre.
+ */
+static const char *algorithm_name(VizSortFunction sortWithCb) {
+    const SortAlgorithm *algo = find_algorithm(sortWithCb);
+    return algo ? algo->name : "Sort";
+}
+
+
+/**
+ * @brief Traite un événement SDL pendant la relecture d'une trace.
+ *
+ * ESPACE : lecture / pause, GAUCHE / DROITE : une étape en arrière / en avant,
+ * HAUT / BAS (ou PAGE HAUT / PAGE BAS) : saut de +/- 10 %, DÉBUT / FIN : début / fin de la trace,
+ * + / - : vitesse de lecture doublée / divisée par deux, H : incrustation des statistiques affichée / masquée,
+ * Q / ÉCHAP : quitter.
+ *
+ * @param view La fenêtre de la session.
+ * @param event L'événement à traiter.
+ * @param player Le lecteur de trace.
+ * @param speed Nombre d'étapes avancées par image en lecture.
+ */
+static void handle_playback_event(VisualState *view, const SDL_Event *event, TracePlayer *player, long *speed) {
+    long total = TraceLength(player->trace);
+    long jump = total / 10 > 0 ? total / 10 : 1;
+
+    if (event->type == SDL_QUIT) {
+        view->running = 0;
+        return;
+    }
+    if (event->type != SDL_KEYDOWN) return;
+
+    switch (event->key.keysym.sym) {
+        case SDLK_SPACE:
+            if (player->step >= total) TraceSeek(player, 0);
+            view->paused = !view->paused;
+            break;
+
+        case SDLK_RIGHT:
+            view->paused = 1;
+            TraceSeek(player, player->step + 1);
+            break;
+
+        case SDLK_LEFT:
+            view->paused = 1;
+            TraceSeek(player, player->step - 1);
+            break;
+
+        case SDLK_UP:
+        case SDLK_PAGEUP:
+            TraceSeek(player, player->step + jump);
+            break;
+
+        case SDLK_DOWN:
+        case SDLK_PAGEDOWN:
+            TraceSeek(player, player->step - jump);
+            break;
+
+        case SDLK_HOME:
+            TraceSeek(player, 0);
+            break;
+
+        case SDLK_END:
+            TraceSeek(player, total);
+            break;
+
+        case SDLK_PLUS:
+        case SDLK_EQUALS:
+        case SDLK_KP_PLUS:
+            if (*speed < total) *speed *= 2;
+            break;
+
+        case SDLK_MINUS:
+        case SDLK_KP_MINUS:
+            if (*speed > 1) *speed /= 2;
+            break;
+
+        case SDLK_h:
+            view->showHud = !view->showHud;
+            break;
+
+        case SDLK_q:
+        case SDLK_ESCAPE:
+            view->running = 0;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/**
+ * @brief Initialise SDL et crée la fenêtre et son renderer de la session, sauf s'ils existent déjà
+ * (fenêtre conservée).
+ *
+ * @param session La session.
+ * @return 0 en cas de succès, -1 en cas d'échec.
+ */
+static int acquire_window(SortSession *session) {
+    const SessionSettings *settings = &session->settings;
+    VisualState *view = session->view;
+    if (view != NULL && view->window != NULL) {
+        SDL_SetWindowSize(view->window, settings->width, settings->height);
+        SDL_ShowWindow(view->window);
+        return 0;
+    }
+
+    if (view == NULL) {
+        view = (VisualState*)calloc(1, sizeof(VisualState));
+        if (view == NULL) {
+            fprintf(stderr, "Memory allocation failed\n");
+            return -1;
+        }
+        session->view = view;
+        view->showHud = 1;
+    }
+
+    // The video subsystem is reference counted: each session quits only its own initialization.
+    if (SDL_InitSubSystem(SDL_INIT_VIDEO) != 0) {
+        fprintf(stderr, "SDL_Init Error: %s\n", SDL_GetError());
+        return -1;
+    }
+
+    view->window = SDL_CreateWindow("Sort Visualizer",
+                                    SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                                    settings->width, settings->height,
+                                    SDL_WINDOW_RESIZABLE);
+    if (!view->window) {
+        fprintf(stderr, "SDL_CreateWindow Error: %s\n", SDL_GetError());
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        return -1;
+    }
+
+    view->renderer = SDL_CreateRenderer(view->window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!view->renderer) {
+        fprintf(stderr, "SDL_CreateRenderer Error: %s\n", SDL_GetError());
+        SDL_DestroyWindow(view->window);
+        view->window = NULL;
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Détruit la fenêtre de la session, son rendu et sa réserve de threads, puis rend SDL.
+ *
+ * @param session La session (sans effet si elle n'a pas de fenêtre).
+ */
+void VisualRelease(SortSession *session) {
+    VisualState *view = session->view;
+    if (view == NULL) return;
+    release_frame(view);
+    release_hud(view);
+    ThreadPoolDestroy(view->pool);
+    if (view->window != NULL) {
+        SDL_DestroyRenderer(view->renderer);
+        SDL_DestroyWindow(view->window);
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    }
+    free(view);
+    session->view = NULL;
+}
+
+/**
+ * @brief Ouvre une session : la fenêtre créée par la prochaine visualisation est conservée pour les
+ * suivantes, jusqu'à VisualEndSession.
+ */
+void VisualBeginSession(void) {
+    DefaultSession()->keepWindow = 1;
+}
+
+/**
+ * @brief Ferme la session ouverte par VisualBeginSession, puis la fenêtre et SDL.
+ */
+void VisualEndSession(void) {
+    DefaultSession()->keepWindow = 0;
+    VisualRelease(DefaultSession());
+}
+
+/**
+ * @brief Visualise un tri avec la session par défaut.
+ * 
+ * @param tab Le tableau à trier.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ * @param sortWithCb Pointeur vers la fonction de tri instrumentée à utiliser.
+ */
+void VisualizeSort(int tab[], int nbValue, void (*sortWithCb)(int[], int, VizCallback)) {
+    SessionVisualize(DefaultSession(), tab, nbValue, sortWithCb);
+}
+
+/**
+ * @brief Fonction principale de visualisation d'un algorithme de tri.
+ *
+ * Le tri instrumenté est d'abord enregistré dans une trace, puis relu dans la fenêtre de la session :
+ * la relecture peut être mise en pause, avancer ou reculer pas à pas et sauter dans la trace. Une
+ * incrustation affiche l'algorithme, les opérations rejouées, les débits et le temps de rendu des images.
+ * Si un export est configuré, l'animation est écrite dans un fichier sans ouvrir de fenêtre.
+ * Les compteurs d'opérations du tri sont gardés dans la session.
+ * 
+ * @param session La session qui fournit les réglages et la fenêtre.
+ * @param tab Le tableau à trier.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ * @param sortWithCb Pointeur vers la fonction de tri instrumentée à utiliser.
+ */
+void SessionVisualize(SortSession *session, int tab[], int nbValue, void (*sortWithCb)(int[], int, VizCallback)) {
+    if (nbValue <= 0 || !sortWithCb) return;
+    const SessionSettings *settings = &session->settings;
+
+    StatsResetCounters();
+    if (settings->output != EXPORT_NONE) {
+        ExportSettings exportSettings = {
+            .format = (ExportFormat)settings->output,
+            .path = settings->exportPath,
+            .width = settings->width,
+            .height = settings->height,
+            .fps = settings->exportFps,
+        };
+        ExportSort(tab, nbValue, sortWithCb, &exportSettings);
+        session->counters = StatsGetCounters();
+        return;
+    }
+
+    // A quadratic sort records at least one operation per inversion: refuse inputs the trace budget cannot hold.
+    const SortAlgorithm *algo = find_algorithm(sortWithCb);
+    if (algo != NULL && algo->cost == SORT_COST_QUADRATIC) {
+        SortProfile profile;
+        AnalyzeSort(tab, nbValue, &profile);
+        double maxOps = (double)(TRACE_MAX_BYTES / sizeof(TraceOp));
+        if (profile.inversions > maxOps) {
+            printf("%s would record about %.3g operations or more, beyond the %zu MiB trace budget (%.3g operations): "
+                   "use a smaller or more sorted sample\n", algo->name, profile.inversions, TRACE_MAX_BYTES >> 20,
+                   maxOps);
+            return;
+        }
+    }
+
+    // Record the whole run, then play it back.
+    Trace *trace = TraceCreate(tab, nbValue, TRACE_DEFAULT_INTERVAL);
+    if (!trace) return;
+
+    double recordStart = StatsNow();
+    SortRunEvents(sortWithCb, tab, nbValue, TraceEventSink, trace);
+    double recordSeconds = StatsNow() - recordStart;
+    TraceFinish(trace, tab);
+    session->counters = StatsGetCounters();
+    if (trace->truncated == TRACE_STOP_BUDGET) {
+        printf("Trace budget of %zu MiB reached: playback stops after %ld operations, before the end of the sort\n",
+               TRACE_MAX_BYTES >> 20, TraceLength(trace));
+    } else if (trace->truncated) {
+        printf("Out of memory: playback stops after %ld operations, before the end of the sort\n", TraceLength(trace));
+    }
+
+    TracePlayer player;
+    if (TracePlayerInit(&player, trace) != 0) {
+        TraceFree(trace);
+        return;
+    }
+
+    if (acquire_window(session) != 0) {
+        TracePlayerFree(&player);
+        TraceFree(trace);
+        return;
+    }
+
+    printf("Playback: SPACE play/pause, LEFT/RIGHT step, UP/DOWN +/-10%%, HOME/END, +/- speed, H stats, Q quit\n");
+
+    VisualState *view = session->view;
+    view->running = 1;
+    view->paused = 0;
+    long total = TraceLength(trace);
+    long speed = 1;
+    char title[128];
+    HudStats hud;
+    HudInit(&hud, algorithm_name(sortWithCb), nbValue,
+            session->counters.comparisons + session->counters.writes, recordSeconds);
+
+    while (view->running) {
+        SDL_Event event;
+
+        // Nothing to animate: sleep until the user does something.
+        if (view->paused || player.step >= total) {
+            if (!SDL_WaitEvent(&event)) break;
+            handle_playback_event(view, &event, &player, &speed);
+        }
+        while (view->running && SDL_PollEvent(&event)) {
+            handle_playback_event(view, &event, &player, &speed);
+        }
+        if (!view->running) break;
+
+        long shown = player.step;
+        if (!view->paused && player.step < total) {
+            TraceSeek(&player, player.step + speed);
+        }
+
+        // The frame time covers the drawing, not the wait for the vertical sync in SDL_RenderPresent.
+        double frameStart = StatsNow();
+        int a, b;
+        TraceHighlight(&player, &a, &b);
+        render_array(view, player.state, nbValue, a, b);
+        if (view->showHud) draw_hud(view, &hud, trace, player.step);
+        HudFrame(&hud, StatsNow() - frameStart, player.step - shown);
+        SDL_RenderPresent(view->renderer);
+
+        snprintf(title, sizeof(title), "Sort Visualizer - step %ld / %ld (x%ld)%s",
+                 player.step, total, speed, view->paused ? " [paused]" : "");
+        SDL_SetWindowTitle(view->window, title);
+
+        if (!view->paused && player.step < total) {
+            SDL_Delay(settings->delayMs);
+        }
+    }
+
+    if (!session->keepWindow) VisualRelease(session);
+    TracePlayerFree(&player);
+    TraceFree(trace);
+}
+
+/**
+ * @brief Fonctions de visualisation spécifiques pour chaque algorithme de tri, plus précisément pour le trie à bulle.
+ * 
+ * @param tab Le tableau à trier.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ */
+void VisualizeBubbleSort(int tab[], int nbValue) {
+    VisualizeSort(tab, nbValue, BubbleSort_viz);
+}
+
+/**
+ * @brief Fonctions de visualisation spécifiques pour chaque algorithme de tri, plus précisément pour le trie par sélection.
+ * 
+ * @param tab Le tableau à trier.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ */
+void VisualizeSelectSort(int tab[], int nbValue) {
+    VisualizeSort(tab, nbValue, SelectSort_viz);
+}
+
+/**
+ * @brief Fonctions de visualisation spécifiques pour chaque algorithme de tri, plus précisément pour le trie par insertion.
+ * 
+ * @param tab Le tableau à trier.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ */
+void VisualizeInsertionSort(int tab[], int nbValue) {
+    VisualizeSort(tab, nbValue, InsertionSort_viz);
+}
+
+/**
+ * @brief Fonctions de visualisation spécifiques pour chaque algorithme de tri, plus précisément pour le trie rapide.
+ * 
+ * @param tab Le tableau à trier.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ */
+void VisualizeQuickSort(int tab[], int nbValue) {
+    VisualizeSort(tab, nbValue, QuickSort_viz_wrapper);
+}
+
+/**
+ * @brief Fonctions de visualisation spécifiques pour chaque algorithme de tri, plus précisément pour le trie fusion.
+ * 
+ * @param tab Le tableau à trier.
+ * @param nbValue Le nombre d'éléments dans le tableau.
+ */
+void VisualizeMergeSort(int tab[], int nbValue) {
+    VisualizeSort(tab, nbValue, MergeSort_viz_wrapper);
+}
+